@@ -301,6 +301,32 @@ static bool check_for_breakpoints(CPUState *cpu, target_ulong pc,
     return false;
 }
 
+/*
+ * Look for an existing TB matching the current cpu state, for the
+ * lookup_tb_ptr helpers. Also returns the cflags it was looked up with.
+ */
+static TranslationBlock *lookup_tb_for_ptr(CPUArchState *env,
+                                           uint32_t *cflags)
+{
+    CPUState *cpu = env_cpu(env);
+    TranslationBlock *tb;
+    target_ulong cs_base, pc;
+    uint32_t flags;
+
+    cpu_get_tb_cpu_state(env, &pc, &cs_base, &flags);
+
+    *cflags = curr_cflags(cpu);
+    if (check_for_breakpoints(cpu, pc, cflags)) {
+        cpu_loop_exit(cpu);
+    }
+
+    tb = tb_lookup(cpu, pc, cs_base, flags, *cflags);
+    if (tb) {
+        log_cpu_exec(pc, cpu, tb);
+    }
+    return tb;
+}
+
 /**
  * helper_lookup_tb_ptr: quick check for next tb
  * @env: current cpu state
@@ -311,24 +337,94 @@ static bool check_for_breakpoints(CPUState *cpu, target_ulong pc,
  */
 const void *HELPER(lookup_tb_ptr)(CPUArchState *env)
 {
-    CPUState *cpu = env_cpu(env);
     TranslationBlock *tb;
-    target_ulong cs_base, pc;
-    uint32_t flags, cflags;
+    uint32_t cflags;
 
-    cpu_get_tb_cpu_state(env, &pc, &cs_base, &flags);
+    tb = lookup_tb_for_ptr(env, &cflags);
+    if (tb == NULL) {
+        return tcg_code_gen_epilogue;
+    }
 
-    cflags = curr_cflags(cpu);
-    if (check_for_breakpoints(cpu, pc, &cflags)) {
-        cpu_loop_exit(cpu);
+    return tb->tc.ptr;
+}
+
+/**
+ * helper_lookup_tb_ptr_cached: next tb of a cached indirect branch
+ * @env: current cpu state
+ * @site: the TB containing the branch
+ * @set: the set of the indirect branch target cache of the branch
+ *
+ * Like helper_lookup_tb_ptr, called when none of the entries of @set
+ * matched. The TB found replaces one of them.
+ */
+const void *HELPER(lookup_tb_ptr_cached)(CPUArchState *env, void *site,
+                                         uint32_t set)
+{
+    TBIndirectCacheSet *s = &env_cpu(env)->tb_ibtc[set];
+    TranslationBlock *tb;
+    uint32_t cflags;
+
+    tb = lookup_tb_for_ptr(env, &cflags);
+    if (tb == NULL) {
+        return tcg_code_gen_epilogue;
+    }
+
+    /*
+     * Pages with breakpoints must keep being stepped through the helper.
+     * Otherwise fill under jmp_lock: either tb is still valid, or
+     * do_tb_phys_invalidate() will find the entry and drop it.
+     */
+    if (!(cflags & CF_NO_GOTO_TB)) {
+        qemu_spin_lock(&tb->jmp_lock);
+        if (!(tb_cflags(tb) & CF_INVALID)) {
+            TBIndirectCacheEntry *e = &s->entry[s->next];
+
+            qatomic_set(&e->site, NULL);
+            e->pc = tb->pc;
+            qatomic_set(&e->tc_ptr, tb->tc.ptr);
+            qatomic_set(&e->site, site);
+            s->next = (s->next + 1) % TB_IBTC_WAYS;
+        }
+        qemu_spin_unlock(&tb->jmp_lock);
     }
 
-    tb = tb_lookup(cpu, pc, cs_base, flags, cflags);
+    return tb->tc.ptr;
+}
+
+/**
+ * helper_lookup_tb_ptr_ret: next tb of a return predicted by the return stack
+ * @env: current cpu state
+ * @site: the TB of the call that pushed the return address
+ * @cell: the continuation cell of the call
+ *
+ * Like helper_lookup_tb_ptr, called when the return address matched but
+ * the code of the TB there was not cached for the current state. The TB
+ * found is cached in @cell for the next calls made from @site.
+ */
+const void *HELPER(lookup_tb_ptr_ret)(CPUArchState *env, void *site,
+                                      uint32_t cell)
+{
+    TBReturnCont *c = &env_cpu(env)->tb_ras.cont[cell];
+    TranslationBlock *tb;
+    uint32_t cflags;
+
+    tb = lookup_tb_for_ptr(env, &cflags);
     if (tb == NULL) {
         return tcg_code_gen_epilogue;
     }
 
-    log_cpu_exec(pc, cpu, tb);
+    /* As for helper_lookup_tb_ptr_cached */
+    if (!(cflags & CF_NO_GOTO_TB)) {
+        qemu_spin_lock(&tb->jmp_lock);
+        if (!(tb_cflags(tb) & CF_INVALID)) {
+            qatomic_set(&c->site, NULL);
+            c->pc = tb->pc;
+            c->flags = tb->flags;
+            qatomic_set(&c->tc_ptr, tb->tc.ptr);
+            qatomic_set(&c->site, site);
+        }
+        qemu_spin_unlock(&tb->jmp_lock);
+    }
 
     return tb->tc.ptr;
 }
@@ -563,8 +659,28 @@ void tb_set_jmp_target(TranslationBlock *tb, int n, uintptr_t addr)
 static inline void tb_add_jump(TranslationBlock *tb, int n,
                                TranslationBlock *tb_next)
 {
+    uintptr_t addr = (uintptr_t)tb_next->tc.ptr;
     uintptr_t old;
 
+    /*
+     * A jump that does not sync some globals enters past the prologue of
+     * TBs that overwrite them all, and cannot be linked to other TBs.
+     * That happens when the TB it was translated for has been replaced:
+     * drop @tb, so that it is translated again for @tb_next, which either
+     * syncs the globals or links to tb_next's entry. Left alone, the jump
+     * would go through the exit path every time.
+     */
+    if (tb->jmp_nosync[n]) {
+        if (!tb_next->chain_offset ||
+            (tb->jmp_nosync[n] & ~tb_next->dead_in)) {
+            mmap_lock();
+            tb_phys_invalidate(tb, -1);
+            mmap_unlock();
+            return;
+        }
+        addr += tb_next->chain_offset;
+    }
+
     qemu_thread_jit_write();
     assert(n < ARRAY_SIZE(tb->jmp_list_next));
     qemu_spin_lock(&tb_next->jmp_lock);
@@ -581,7 +697,7 @@ static inline void tb_add_jump(TranslationBlock *tb, int n,
     }
 
     /* patch the native jump address */
-    tb_set_jmp_target(tb, n, (uintptr_t)tb_next->tc.ptr);
+    tb_set_jmp_target(tb, n, addr);
 
     /* add in TB jmp list */
     tb->jmp_list_next[n] = tb_next->jmp_list_head;
@@ -840,6 +956,18 @@ static inline void cpu_loop_exec_tb(CPUState *cpu, TranslationBlock *tb,
 
     trace_exec_tb(tb, tb->pc);
     tb = cpu_tb_exec(cpu, tb, tb_exit);
+    if (*tb_exit == TB_EXIT_HOT) {
+        *last_tb = NULL;
+#ifdef CONFIG_USER_ONLY
+        /* keep running the TB until a translator thread replaces it */
+        if (translate_pool_add_hot(cpu, tb)) {
+            return;
+        }
+#endif
+        /* the next lookup finds the superblock */
+        tb_tier_up(cpu, tb);
+        return;
+    }
     if (*tb_exit != TB_EXIT_REQUESTED) {
         *last_tb = tb;
         return;
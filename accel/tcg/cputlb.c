@@ -107,12 +107,43 @@ static void tb_jmp_cache_clear_page(CPUState *cpu, target_ulong page_addr)
     }
 }
 
+static void tb_ibtc_clear_page(CPUState *cpu, target_ulong page_addr)
+{
+    unsigned int i, j;
+
+    for (i = 0; i < TB_IBTC_SIZE; i++) {
+        for (j = 0; j < TB_IBTC_WAYS; j++) {
+            TBIndirectCacheEntry *e = &cpu->tb_ibtc[i].entry[j];
+
+            if ((e->pc & TARGET_PAGE_MASK) == page_addr) {
+                qatomic_set(&e->site, NULL);
+            }
+        }
+    }
+    for (i = 0; i < TB_RAS_SIZE; i++) {
+        TBReturnStackEntry *e = &cpu->tb_ras.entry[i];
+
+        if ((e->pc & TARGET_PAGE_MASK) == page_addr) {
+            qatomic_set(&e->cont_site, NULL);
+        }
+    }
+    for (i = 0; i < TB_RAS_CONT_SIZE; i++) {
+        TBReturnCont *c = &cpu->tb_ras.cont[i];
+
+        if ((c->pc & TARGET_PAGE_MASK) == page_addr) {
+            qatomic_set(&c->site, NULL);
+        }
+    }
+}
+
 static void tb_flush_jmp_cache(CPUState *cpu, target_ulong addr)
 {
     /* Discard jump cache entries for any tb which might potentially
        overlap the flushed page.  */
     tb_jmp_cache_clear_page(cpu, addr - TARGET_PAGE_SIZE);
     tb_jmp_cache_clear_page(cpu, addr);
+    tb_ibtc_clear_page(cpu, addr - TARGET_PAGE_SIZE);
+    tb_ibtc_clear_page(cpu, addr);
 }
 
 /**
@@ -230,14 +261,59 @@ static void tlb_mmu_resize_locked(CPUTLBDesc *desc, CPUTLBDescFast *fast,
     }
 }
 
+/* The number of victim tlb sets to back a tlb of @n_entries */
+static size_t tlb_vtlb_sets(size_t n_entries)
+{
+    size_t size = n_entries / CPU_VTLB_RATIO;
+
+    size = MIN(MAX(size, CPU_VTLB_MIN_SIZE), CPU_VTLB_MAX_SIZE);
+    return size / CPU_VTLB_WAYS;
+}
+
+static inline size_t tlb_vtlb_n_entries(CPUTLBDesc *desc)
+{
+    return desc->vtlb_sets * CPU_VTLB_WAYS;
+}
+
+/*
+ * Return the index of the first way of the victim tlb set for @page.
+ * Pages that conflict in the direct mapped tlb share its index bits, so
+ * hash all of the page number to spread them over the sets.
+ */
+static inline size_t tlb_vtlb_set(CPUTLBDesc *desc, target_ulong page)
+{
+    uint64_t hash = (uint64_t)(page >> TARGET_PAGE_BITS) *
+                    0x9e3779b97f4a7c15ull;
+
+    return ((hash >> 32) & (desc->vtlb_sets - 1)) * CPU_VTLB_WAYS;
+}
+
+/*
+ * Resize the victim tlb along with the tlb it backs.  Called with
+ * tlb_c.lock held, from a flush which empties the victim tlb.
+ */
+static void tlb_vtlb_resize_locked(CPUTLBDesc *desc, CPUTLBDescFast *fast)
+{
+    size_t sets = tlb_vtlb_sets(tlb_n_entries(fast));
+
+    if (sets == desc->vtlb_sets) {
+        return;
+    }
+    qatomic_set(&desc->vtlb_sets, sets);
+    g_free(desc->vtable);
+    g_free(desc->viotlb);
+    desc->vtable = g_new(CPUTLBEntry, tlb_vtlb_n_entries(desc));
+    desc->viotlb = g_new(CPUIOTLBEntry, tlb_vtlb_n_entries(desc));
+}
+
 static void tlb_mmu_flush_locked(CPUTLBDesc *desc, CPUTLBDescFast *fast)
 {
     desc->n_used_entries = 0;
-    desc->large_page_addr = -1;
-    desc->large_page_mask = -1;
+    memset(desc->large_page, -1, sizeof(desc->large_page));
     desc->vindex = 0;
     memset(fast->table, -1, sizeof_tlb(fast));
-    memset(desc->vtable, -1, sizeof(desc->vtable));
+    memset(desc->vtable, -1,
+           tlb_vtlb_n_entries(desc) * sizeof(desc->vtable[0]));
 }
 
 static void tlb_flush_one_mmuidx_locked(CPUArchState *env, int mmu_idx,
@@ -247,6 +323,7 @@ static void tlb_flush_one_mmuidx_locked(CPUArchState *env, int mmu_idx,
     CPUTLBDescFast *fast = &env_tlb(env)->f[mmu_idx];
 
     tlb_mmu_resize_locked(desc, fast, now);
+    tlb_vtlb_resize_locked(desc, fast);
     tlb_mmu_flush_locked(desc, fast);
 }
 
@@ -259,6 +336,7 @@ static void tlb_mmu_init(CPUTLBDesc *desc, CPUTLBDescFast *fast, int64_t now)
     fast->mask = (n_entries - 1) << CPU_TLB_ENTRY_BITS;
     fast->table = g_new(CPUTLBEntry, n_entries);
     desc->iotlb = g_new(CPUIOTLBEntry, n_entries);
+    tlb_vtlb_resize_locked(desc, fast);
     tlb_mmu_flush_locked(desc, fast);
 }
 
@@ -282,6 +360,7 @@ void tlb_init(CPUState *cpu)
 
     /* All tlbs are initialized flushed. */
     env_tlb(env)->c.dirty = 0;
+    memset(env_tlb(env)->c.walk_cache, -1, sizeof(env_tlb(env)->c.walk_cache));
 
     for (i = 0; i < NB_MMU_MODES; i++) {
         tlb_mmu_init(&env_tlb(env)->d[i], &env_tlb(env)->f[i], now);
@@ -300,6 +379,8 @@ void tlb_destroy(CPUState *cpu)
 
         g_free(fast->table);
         g_free(desc->iotlb);
+        g_free(desc->vtable);
+        g_free(desc->viotlb);
     }
 }
 
@@ -322,10 +403,30 @@ static void flush_all_helper(CPUState *src, run_on_cpu_func fn,
     }
 }
 
-void tlb_flush_counts(size_t *pfull, size_t *ppart, size_t *pelide)
+typedef CPUTLBPendingFlush TLBFlushRangeData;
+
+static void tlb_flush_pending_add(CPUState *cpu, TLBFlushRangeData d);
+
+/*
+ * flush_pending_all_helper: leave the flush @d pending on all cpus
+ * but @src, see tlb_flush_pending_add.
+ */
+static void flush_pending_all_helper(CPUState *src, TLBFlushRangeData d)
+{
+    CPUState *cpu;
+
+    CPU_FOREACH(cpu) {
+        if (cpu != src) {
+            tlb_flush_pending_add(cpu, d);
+        }
+    }
+}
+
+void tlb_flush_counts(size_t *pfull, size_t *ppart, size_t *pelide,
+                      size_t *plarge, size_t *pcoalesced)
 {
     CPUState *cpu;
-    size_t full = 0, part = 0, elide = 0;
+    size_t full = 0, part = 0, elide = 0, large = 0, coalesced = 0;
 
     CPU_FOREACH(cpu) {
         CPUArchState *env = cpu->env_ptr;
@@ -333,10 +434,85 @@ void tlb_flush_counts(size_t *pfull, size_t *ppart, size_t *pelide)
         full += qatomic_read(&env_tlb(env)->c.full_flush_count);
         part += qatomic_read(&env_tlb(env)->c.part_flush_count);
         elide += qatomic_read(&env_tlb(env)->c.elide_flush_count);
+        large += qatomic_read(&env_tlb(env)->c.large_flush_count);
+        coalesced += qatomic_read(&env_tlb(env)->c.coalesced_flush_count);
     }
     *pfull = full;
     *ppart = part;
     *pelide = elide;
+    *plarge = large;
+    *pcoalesced = coalesced;
+}
+
+static inline CPUTLBWalkCacheEntry *tlb_walk_cache_entry(CPUArchState *env,
+                                                         hwaddr addr)
+{
+    size_t i = ((addr >> 3) ^ (addr >> 12)) & (CPU_TLB_WALK_CACHE_SIZE - 1);
+
+    return &env_tlb(env)->c.walk_cache[i];
+}
+
+bool tlb_walk_cache_lookup(CPUState *cpu, hwaddr addr, uint64_t *pte)
+{
+    CPUArchState *env = cpu->env_ptr;
+    CPUTLBWalkCacheEntry *e = tlb_walk_cache_entry(env, addr);
+
+    assert_cpu_is_self(cpu);
+    if (e->addr != addr) {
+        return false;
+    }
+    *pte = e->pte;
+    return true;
+}
+
+void tlb_walk_cache_insert(CPUState *cpu, hwaddr addr, uint64_t pte)
+{
+    CPUArchState *env = cpu->env_ptr;
+    CPUTLBWalkCacheEntry *e = tlb_walk_cache_entry(env, addr);
+
+    assert_cpu_is_self(cpu);
+    e->addr = addr;
+    e->pte = pte;
+    env_tlb(env)->c.walk_cache_used = true;
+}
+
+/*
+ * Any flush may be the one the guest issued after changing a non-leaf
+ * page table entry, so empty the whole walk cache.
+ */
+static void tlb_walk_cache_flush(CPUArchState *env)
+{
+    CPUTLBCommon *c = &env_tlb(env)->c;
+
+    if (c->walk_cache_used) {
+        memset(c->walk_cache, -1, sizeof(c->walk_cache));
+        c->walk_cache_used = false;
+    }
+}
+
+void tlb_dump_mmu_stats(GString *buf)
+{
+    int mmu_idx;
+
+    for (mmu_idx = 0; mmu_idx < NB_MMU_MODES; mmu_idx++) {
+        size_t miss = 0, hit = 0, vsize = 0;
+        CPUState *cpu;
+
+        CPU_FOREACH(cpu) {
+            CPUArchState *env = cpu->env_ptr;
+            CPUTLBDesc *desc = &env_tlb(env)->d[mmu_idx];
+
+            miss += qatomic_read(&desc->miss_count);
+            hit += qatomic_read(&desc->vtlb_hit_count);
+            vsize = MAX(vsize, qatomic_read(&desc->vtlb_sets) * CPU_VTLB_WAYS);
+        }
+        if (!miss) {
+            continue;
+        }
+        g_string_append_printf(buf, "TLB mmu_idx %-2d misses %zu, victim "
+                               "hits %zu (%zu%%), victim entries %zu\n",
+                               mmu_idx, miss, hit, hit * 100 / miss, vsize);
+    }
 }
 
 static void tlb_flush_by_mmuidx_async_work(CPUState *cpu, run_on_cpu_data data)
@@ -350,6 +526,7 @@ static void tlb_flush_by_mmuidx_async_work(CPUState *cpu, run_on_cpu_data data)
 
     tlb_debug("mmu_idx:0x%04" PRIx16 "\n", asked);
 
+    tlb_walk_cache_flush(env);
     qemu_spin_lock(&env_tlb(env)->c.lock);
 
     all_dirty = env_tlb(env)->c.dirty;
@@ -477,10 +654,16 @@ static void tlb_flush_vtlb_page_mask_locked(CPUArchState *env, int mmu_idx,
                                             target_ulong mask)
 {
     CPUTLBDesc *d = &env_tlb(env)->d[mmu_idx];
-    int k;
+    size_t k, first = 0, end = tlb_vtlb_n_entries(d);
 
     assert_cpu_is_self(env_cpu(env));
-    for (k = 0; k < CPU_VTLB_SIZE; k++) {
+
+    /* A single page can only be in its own set */
+    if (mask == -1) {
+        first = tlb_vtlb_set(d, page);
+        end = first + CPU_VTLB_WAYS;
+    }
+    for (k = first; k < end; k++) {
         if (tlb_flush_entry_mask_locked(&d->vtable[k], page, mask)) {
             tlb_n_used_entries_dec(env, mmu_idx);
         }
@@ -493,24 +676,64 @@ static inline void tlb_flush_vtlb_page_locked(CPUArchState *env, int mmu_idx,
     tlb_flush_vtlb_page_mask_locked(env, mmu_idx, page, -1);
 }
 
+/*
+ * Flush every entry within large page region @i of @midx and free the
+ * region.  Called with tlb_c.lock held.
+ */
+static void tlb_flush_large_page_locked(CPUArchState *env, int midx, int i)
+{
+    CPUTLBDesc *d = &env_tlb(env)->d[midx];
+    CPUTLBDescFast *f = &env_tlb(env)->f[midx];
+    target_ulong lp_addr = d->large_page[i].addr;
+    target_ulong lp_mask = d->large_page[i].mask;
+    size_t n_entries = tlb_n_entries(f);
+    size_t k;
+
+    tlb_debug("flush large page midx %d (" TARGET_FMT_lx "/" TARGET_FMT_lx
+              ")\n", midx, lp_addr, lp_mask);
+
+    /* Visit each page of the region, or each entry if there are fewer */
+    if ((~lp_mask >> TARGET_PAGE_BITS) < n_entries) {
+        for (k = 0; k <= (~lp_mask >> TARGET_PAGE_BITS); k++) {
+            target_ulong page = lp_addr + (target_ulong)k * TARGET_PAGE_SIZE;
+
+            if (tlb_flush_entry_mask_locked(tlb_entry(env, midx, page),
+                                            lp_addr, lp_mask)) {
+                tlb_n_used_entries_dec(env, midx);
+            }
+        }
+    } else {
+        for (k = 0; k < n_entries; k++) {
+            if (tlb_flush_entry_mask_locked(&f->table[k], lp_addr, lp_mask)) {
+                tlb_n_used_entries_dec(env, midx);
+            }
+        }
+    }
+    tlb_flush_vtlb_page_mask_locked(env, midx, lp_addr, lp_mask);
+
+    d->large_page[i].addr = -1;
+    d->large_page[i].mask = -1;
+    qatomic_set(&env_tlb(env)->c.large_flush_count,
+                env_tlb(env)->c.large_flush_count + 1);
+}
+
 static void tlb_flush_page_locked(CPUArchState *env, int midx,
                                   target_ulong page)
 {
-    target_ulong lp_addr = env_tlb(env)->d[midx].large_page_addr;
-    target_ulong lp_mask = env_tlb(env)->d[midx].large_page_mask;
+    CPUTLBDesc *d = &env_tlb(env)->d[midx];
+    int i;
 
     /* Check if we need to flush due to large pages.  */
-    if ((page & lp_mask) == lp_addr) {
-        tlb_debug("forcing full flush midx %d ("
-                  TARGET_FMT_lx "/" TARGET_FMT_lx ")\n",
-                  midx, lp_addr, lp_mask);
-        tlb_flush_one_mmuidx_locked(env, midx, get_clock_realtime());
-    } else {
-        if (tlb_flush_entry_locked(tlb_entry(env, midx, page), page)) {
-            tlb_n_used_entries_dec(env, midx);
+    for (i = 0; i < CPU_TLB_LARGE_PAGES; i++) {
+        if ((page & d->large_page[i].mask) == d->large_page[i].addr) {
+            tlb_flush_large_page_locked(env, midx, i);
         }
-        tlb_flush_vtlb_page_locked(env, midx, page);
     }
+
+    if (tlb_flush_entry_locked(tlb_entry(env, midx, page), page)) {
+        tlb_n_used_entries_dec(env, midx);
+    }
+    tlb_flush_vtlb_page_locked(env, midx, page);
 }
 
 /**
@@ -533,6 +756,7 @@ static void tlb_flush_page_by_mmuidx_async_0(CPUState *cpu,
 
     tlb_debug("page addr:" TARGET_FMT_lx " mmu_map:0x%x\n", addr, idxmap);
 
+    tlb_walk_cache_flush(env);
     qemu_spin_lock(&env_tlb(env)->c.lock);
     for (mmu_idx = 0; mmu_idx < NB_MMU_MODES; mmu_idx++) {
         if ((idxmap >> mmu_idx) & 1) {
@@ -597,22 +821,15 @@ void tlb_flush_page_by_mmuidx(CPUState *cpu, target_ulong addr, uint16_t idxmap)
 
     if (qemu_cpu_is_self(cpu)) {
         tlb_flush_page_by_mmuidx_async_0(cpu, addr, idxmap);
-    } else if (idxmap < TARGET_PAGE_SIZE) {
-        /*
-         * Most targets have only a few mmu_idx.  In the case where
-         * we can stuff idxmap into the low TARGET_PAGE_BITS, avoid
-         * allocating memory for this operation.
-         */
-        async_run_on_cpu(cpu, tlb_flush_page_by_mmuidx_async_1,
-                         RUN_ON_CPU_TARGET_PTR(addr | idxmap));
     } else {
-        TLBFlushPageByMMUIdxData *d = g_new(TLBFlushPageByMMUIdxData, 1);
+        TLBFlushRangeData d = {
+            .addr = addr,
+            .len = TARGET_PAGE_SIZE,
+            .idxmap = idxmap,
+            .bits = TARGET_LONG_BITS,
+        };
 
-        /* Otherwise allocate a structure, freed by the worker.  */
-        d->addr = addr;
-        d->idxmap = idxmap;
-        async_run_on_cpu(cpu, tlb_flush_page_by_mmuidx_async_2,
-                         RUN_ON_CPU_HOST_PTR(d));
+        tlb_flush_pending_add(cpu, d);
     }
 }
 
@@ -629,29 +846,12 @@ void tlb_flush_page_by_mmuidx_all_cpus(CPUState *src_cpu, target_ulong addr,
     /* This should already be page aligned */
     addr &= TARGET_PAGE_MASK;
 
-    /*
-     * Allocate memory to hold addr+idxmap only when needed.
-     * See tlb_flush_page_by_mmuidx for details.
-     */
-    if (idxmap < TARGET_PAGE_SIZE) {
-        flush_all_helper(src_cpu, tlb_flush_page_by_mmuidx_async_1,
-                         RUN_ON_CPU_TARGET_PTR(addr | idxmap));
-    } else {
-        CPUState *dst_cpu;
-
-        /* Allocate a separate data block for each destination cpu.  */
-        CPU_FOREACH(dst_cpu) {
-            if (dst_cpu != src_cpu) {
-                TLBFlushPageByMMUIdxData *d
-                    = g_new(TLBFlushPageByMMUIdxData, 1);
-
-                d->addr = addr;
-                d->idxmap = idxmap;
-                async_run_on_cpu(dst_cpu, tlb_flush_page_by_mmuidx_async_2,
-                                 RUN_ON_CPU_HOST_PTR(d));
-            }
-        }
-    }
+    flush_pending_all_helper(src_cpu, (TLBFlushRangeData) {
+        .addr = addr,
+        .len = TARGET_PAGE_SIZE,
+        .idxmap = idxmap,
+        .bits = TARGET_LONG_BITS,
+    });
 
     tlb_flush_page_by_mmuidx_async_0(src_cpu, addr, idxmap);
 }
@@ -670,31 +870,25 @@ void tlb_flush_page_by_mmuidx_all_cpus_synced(CPUState *src_cpu,
     /* This should already be page aligned */
     addr &= TARGET_PAGE_MASK;
 
+    flush_pending_all_helper(src_cpu, (TLBFlushRangeData) {
+        .addr = addr,
+        .len = TARGET_PAGE_SIZE,
+        .idxmap = idxmap,
+        .bits = TARGET_LONG_BITS,
+    });
+
     /*
      * Allocate memory to hold addr+idxmap only when needed.
-     * See tlb_flush_page_by_mmuidx for details.
+     * Most targets have only a few mmu_idx.  In the case where
+     * we can stuff idxmap into the low TARGET_PAGE_BITS, avoid
+     * allocating memory for this operation.
      */
     if (idxmap < TARGET_PAGE_SIZE) {
-        flush_all_helper(src_cpu, tlb_flush_page_by_mmuidx_async_1,
-                         RUN_ON_CPU_TARGET_PTR(addr | idxmap));
         async_safe_run_on_cpu(src_cpu, tlb_flush_page_by_mmuidx_async_1,
                               RUN_ON_CPU_TARGET_PTR(addr | idxmap));
     } else {
-        CPUState *dst_cpu;
-        TLBFlushPageByMMUIdxData *d;
-
-        /* Allocate a separate data block for each destination cpu.  */
-        CPU_FOREACH(dst_cpu) {
-            if (dst_cpu != src_cpu) {
-                d = g_new(TLBFlushPageByMMUIdxData, 1);
-                d->addr = addr;
-                d->idxmap = idxmap;
-                async_run_on_cpu(dst_cpu, tlb_flush_page_by_mmuidx_async_2,
-                                 RUN_ON_CPU_HOST_PTR(d));
-            }
-        }
+        TLBFlushPageByMMUIdxData *d = g_new(TLBFlushPageByMMUIdxData, 1);
 
-        d = g_new(TLBFlushPageByMMUIdxData, 1);
         d->addr = addr;
         d->idxmap = idxmap;
         async_safe_run_on_cpu(src_cpu, tlb_flush_page_by_mmuidx_async_2,
@@ -733,17 +927,15 @@ static void tlb_flush_range_locked(CPUArchState *env, int midx,
         return;
     }
 
-    /*
-     * Check if we need to flush due to large pages.
-     * Because large_page_mask contains all 1's from the msb,
-     * we only need to test the end of the range.
-     */
-    if (((addr + len - 1) & d->large_page_mask) == d->large_page_addr) {
-        tlb_debug("forcing full flush midx %d ("
-                  TARGET_FMT_lx "/" TARGET_FMT_lx ")\n",
-                  midx, d->large_page_addr, d->large_page_mask);
-        tlb_flush_one_mmuidx_locked(env, midx, get_clock_realtime());
-        return;
+    /* Check if we need to flush due to large pages.  */
+    for (int i = 0; i < CPU_TLB_LARGE_PAGES; i++) {
+        target_ulong lp_addr = d->large_page[i].addr;
+        target_ulong lp_mask = d->large_page[i].mask;
+
+        if (lp_addr != (target_ulong)-1 &&
+            lp_addr <= addr + len - 1 && addr <= (lp_addr | ~lp_mask)) {
+            tlb_flush_large_page_locked(env, midx, i);
+        }
     }
 
     for (target_ulong i = 0; i < len; i += TARGET_PAGE_SIZE) {
@@ -757,13 +949,6 @@ static void tlb_flush_range_locked(CPUArchState *env, int midx,
     }
 }
 
-typedef struct {
-    target_ulong addr;
-    target_ulong len;
-    uint16_t idxmap;
-    uint16_t bits;
-} TLBFlushRangeData;
-
 static void tlb_flush_range_by_mmuidx_async_0(CPUState *cpu,
                                               TLBFlushRangeData d)
 {
@@ -775,6 +960,7 @@ static void tlb_flush_range_by_mmuidx_async_0(CPUState *cpu,
     tlb_debug("range:" TARGET_FMT_lx "/%u+" TARGET_FMT_lx " mmu_map:0x%x\n",
               d.addr, d.bits, d.len, d.idxmap);
 
+    tlb_walk_cache_flush(env);
     qemu_spin_lock(&env_tlb(env)->c.lock);
     for (mmu_idx = 0; mmu_idx < NB_MMU_MODES; mmu_idx++) {
         if ((d.idxmap >> mmu_idx) & 1) {
@@ -796,6 +982,115 @@ static void tlb_flush_range_by_mmuidx_async_1(CPUState *cpu,
     g_free(d);
 }
 
+/*
+ * Run the flushes other cpus left pending on @cpu, all from the one
+ * work item queued by tlb_flush_pending_add.
+ */
+static void tlb_flush_pending_async_work(CPUState *cpu, run_on_cpu_data data)
+{
+    CPUArchState *env = cpu->env_ptr;
+    CPUTLBCommon *c = &env_tlb(env)->c;
+    TLBFlushRangeData pending[CPU_TLB_PENDING_FLUSHES];
+    uint16_t full;
+    int i, n;
+
+    qemu_spin_lock(&c->lock);
+    full = c->pending_full;
+    n = c->n_pending;
+    memcpy(pending, c->pending, n * sizeof(pending[0]));
+    c->pending_full = 0;
+    c->n_pending = 0;
+    c->pending_queued = false;
+    qemu_spin_unlock(&c->lock);
+
+    if (full) {
+        tlb_flush_by_mmuidx_async_work(cpu, RUN_ON_CPU_HOST_INT(full));
+    }
+    for (i = 0; i < n; i++) {
+        pending[i].idxmap &= ~full;
+        if (pending[i].idxmap) {
+            tlb_flush_range_by_mmuidx_async_0(cpu, pending[i]);
+        }
+    }
+}
+
+/*
+ * Widen the pending flush @p to cover @d as well, if they flush the same
+ * mmu_idx with the same bits and their ranges overlap or touch.
+ */
+static bool tlb_flush_range_merge(TLBFlushRangeData *p, TLBFlushRangeData d)
+{
+    target_ulong p_last = p->addr + p->len - 1;
+    target_ulong d_last = d.addr + d.len - 1;
+    target_ulong addr, last;
+
+    if (p->idxmap != d.idxmap || p->bits != d.bits ||
+        p_last < p->addr || d_last < d.addr) {
+        return false;
+    }
+    if ((d.addr > p_last && d.addr - p_last != 1) ||
+        (p->addr > d_last && p->addr - d_last != 1)) {
+        return false;
+    }
+
+    addr = MIN(p->addr, d.addr);
+    last = MAX(p_last, d_last);
+    if (last - addr == (target_ulong)-1) {
+        return false;
+    }
+    p->addr = addr;
+    p->len = last - addr + 1;
+    return true;
+}
+
+/*
+ * Leave the flush @d pending on @cpu, for a cpu other than the current
+ * one.  Flushes of the same mmu_idx and bits whose ranges overlap or
+ * touch are merged, and once CPU_TLB_PENDING_FLUSHES are pending they
+ * all degrade to full flushes of their mmu_idx.  Only the first flush
+ * of a batch queues work on @cpu, so that unmapping a large region
+ * does not queue one work item per page on every cpu.
+ */
+static void tlb_flush_pending_add(CPUState *cpu, TLBFlushRangeData d)
+{
+    CPUArchState *env = cpu->env_ptr;
+    CPUTLBCommon *c = &env_tlb(env)->c;
+    bool queue;
+    int i;
+
+    qemu_spin_lock(&c->lock);
+
+    d.idxmap &= ~c->pending_full;
+    for (i = 0; d.idxmap && i < c->n_pending; i++) {
+        if (tlb_flush_range_merge(&c->pending[i], d)) {
+            break;
+        }
+    }
+
+    if (!d.idxmap || i < c->n_pending) {
+        qatomic_set(&c->coalesced_flush_count, c->coalesced_flush_count + 1);
+    } else if (c->n_pending < CPU_TLB_PENDING_FLUSHES) {
+        c->pending[c->n_pending++] = d;
+    } else {
+        uint16_t full = d.idxmap;
+
+        for (i = 0; i < c->n_pending; i++) {
+            full |= c->pending[i].idxmap;
+        }
+        c->pending_full |= full;
+        c->n_pending = 0;
+        qatomic_set(&c->coalesced_flush_count, c->coalesced_flush_count + 1);
+    }
+
+    queue = !c->pending_queued;
+    c->pending_queued = true;
+    qemu_spin_unlock(&c->lock);
+
+    if (queue) {
+        async_run_on_cpu(cpu, tlb_flush_pending_async_work, RUN_ON_CPU_NULL);
+    }
+}
+
 void tlb_flush_range_by_mmuidx(CPUState *cpu, target_ulong addr,
                                target_ulong len, uint16_t idxmap,
                                unsigned bits)
@@ -825,10 +1120,7 @@ void tlb_flush_range_by_mmuidx(CPUState *cpu, target_ulong addr,
     if (qemu_cpu_is_self(cpu)) {
         tlb_flush_range_by_mmuidx_async_0(cpu, d);
     } else {
-        /* Otherwise allocate a structure, freed by the worker.  */
-        TLBFlushRangeData *p = g_memdup(&d, sizeof(d));
-        async_run_on_cpu(cpu, tlb_flush_range_by_mmuidx_async_1,
-                         RUN_ON_CPU_HOST_PTR(p));
+        tlb_flush_pending_add(cpu, d);
     }
 }
 
@@ -843,7 +1135,6 @@ void tlb_flush_range_by_mmuidx_all_cpus(CPUState *src_cpu,
                                         uint16_t idxmap, unsigned bits)
 {
     TLBFlushRangeData d;
-    CPUState *dst_cpu;
 
     /*
      * If all bits are significant, and len is small,
@@ -865,16 +1156,7 @@ void tlb_flush_range_by_mmuidx_all_cpus(CPUState *src_cpu,
     d.idxmap = idxmap;
     d.bits = bits;
 
-    /* Allocate a separate data block for each destination cpu.  */
-    CPU_FOREACH(dst_cpu) {
-        if (dst_cpu != src_cpu) {
-            TLBFlushRangeData *p = g_memdup(&d, sizeof(d));
-            async_run_on_cpu(dst_cpu,
-                             tlb_flush_range_by_mmuidx_async_1,
-                             RUN_ON_CPU_HOST_PTR(p));
-        }
-    }
-
+    flush_pending_all_helper(src_cpu, d);
     tlb_flush_range_by_mmuidx_async_0(src_cpu, d);
 }
 
@@ -893,7 +1175,6 @@ void tlb_flush_range_by_mmuidx_all_cpus_synced(CPUState *src_cpu,
                                                unsigned bits)
 {
     TLBFlushRangeData d, *p;
-    CPUState *dst_cpu;
 
     /*
      * If all bits are significant, and len is small,
@@ -915,14 +1196,7 @@ void tlb_flush_range_by_mmuidx_all_cpus_synced(CPUState *src_cpu,
     d.idxmap = idxmap;
     d.bits = bits;
 
-    /* Allocate a separate data block for each destination cpu.  */
-    CPU_FOREACH(dst_cpu) {
-        if (dst_cpu != src_cpu) {
-            p = g_memdup(&d, sizeof(d));
-            async_run_on_cpu(dst_cpu, tlb_flush_range_by_mmuidx_async_1,
-                             RUN_ON_CPU_HOST_PTR(p));
-        }
-    }
+    flush_pending_all_helper(src_cpu, d);
 
     p = g_memdup(&d, sizeof(d));
     async_safe_run_on_cpu(src_cpu, tlb_flush_range_by_mmuidx_async_1,
@@ -999,6 +1273,39 @@ static inline void copy_tlb_helper_locked(CPUTLBEntry *d, const CPUTLBEntry *s)
     *d = *s;
 }
 
+/* Return the page mapped by the tlb entry @te, which must not be empty */
+static inline target_ulong tlb_entry_page(const CPUTLBEntry *te)
+{
+    if (te->addr_read != -1) {
+        return te->addr_read & TARGET_PAGE_MASK;
+    }
+    if (te->addr_write != -1) {
+        return te->addr_write & TARGET_PAGE_MASK;
+    }
+    return te->addr_code & TARGET_PAGE_MASK;
+}
+
+/*
+ * Evict the tlb entry @te with its iotlb entry @io into the victim tlb,
+ * into a free way of its set if there is one.  Called with tlb_c.lock
+ * held.
+ */
+static void tlb_vtlb_insert_locked(CPUTLBDesc *desc, const CPUTLBEntry *te,
+                                   const CPUIOTLBEntry *io)
+{
+    size_t set = tlb_vtlb_set(desc, tlb_entry_page(te));
+    size_t k, vidx = set + desc->vindex++ % CPU_VTLB_WAYS;
+
+    for (k = set; k < set + CPU_VTLB_WAYS; k++) {
+        if (tlb_entry_is_empty(&desc->vtable[k])) {
+            vidx = k;
+            break;
+        }
+    }
+    copy_tlb_helper_locked(&desc->vtable[vidx], te);
+    desc->viotlb[vidx] = *io;
+}
+
 /* This is a cross vCPU call (i.e. another vCPU resetting the flags of
  * the target vCPU).
  * We must take tlb_c.lock to avoid racing with another vCPU update. The only
@@ -1021,7 +1328,8 @@ void tlb_reset_dirty(CPUState *cpu, ram_addr_t start1, ram_addr_t length)
                                          start1, length);
         }
 
-        for (i = 0; i < CPU_VTLB_SIZE; i++) {
+        n = tlb_vtlb_n_entries(&env_tlb(env)->d[mmu_idx]);
+        for (i = 0; i < n; i++) {
             tlb_reset_dirty_range_locked(&env_tlb(env)->d[mmu_idx].vtable[i],
                                          start1, length);
         }
@@ -1054,36 +1362,56 @@ void tlb_set_dirty(CPUState *cpu, target_ulong vaddr)
     }
 
     for (mmu_idx = 0; mmu_idx < NB_MMU_MODES; mmu_idx++) {
-        int k;
-        for (k = 0; k < CPU_VTLB_SIZE; k++) {
-            tlb_set_dirty1_locked(&env_tlb(env)->d[mmu_idx].vtable[k], vaddr);
+        CPUTLBDesc *desc = &env_tlb(env)->d[mmu_idx];
+        size_t k, set = tlb_vtlb_set(desc, vaddr);
+
+        for (k = set; k < set + CPU_VTLB_WAYS; k++) {
+            tlb_set_dirty1_locked(&desc->vtable[k], vaddr);
         }
     }
     qemu_spin_unlock(&env_tlb(env)->c.lock);
 }
 
-/* Our TLB does not support large pages, so remember the area covered by
-   large pages and trigger a full TLB flush if these are invalidated.  */
+/* Our TLB does not support large pages, so remember the areas covered by
+   large pages and flush all of an area if a page in it is invalidated.  */
 static void tlb_add_large_page(CPUArchState *env, int mmu_idx,
                                target_ulong vaddr, target_ulong size)
 {
-    target_ulong lp_addr = env_tlb(env)->d[mmu_idx].large_page_addr;
+    CPUTLBLargePage *lp = env_tlb(env)->d[mmu_idx].large_page;
     target_ulong lp_mask = ~(size - 1);
+    target_ulong best_mask = 0;
+    int i, best = 0;
 
-    if (lp_addr == (target_ulong)-1) {
-        /* No previous large page.  */
-        lp_addr = vaddr;
-    } else {
-        /* Extend the existing region to include the new page.
-           This is a compromise between unnecessary flushes and
-           the cost of maintaining a full variable size TLB.  */
-        lp_mask &= env_tlb(env)->d[mmu_idx].large_page_mask;
-        while (((lp_addr ^ vaddr) & lp_mask) != 0) {
-            lp_mask <<= 1;
+    for (i = 0; i < CPU_TLB_LARGE_PAGES; i++) {
+        if ((vaddr & lp[i].mask) == lp[i].addr && lp[i].mask <= lp_mask) {
+            /* Already covered.  */
+            return;
         }
     }
-    env_tlb(env)->d[mmu_idx].large_page_addr = lp_addr & lp_mask;
-    env_tlb(env)->d[mmu_idx].large_page_mask = lp_mask;
+
+    for (i = 0; i < CPU_TLB_LARGE_PAGES; i++) {
+        target_ulong mask;
+
+        if (lp[i].addr == (target_ulong)-1) {
+            lp[i].addr = vaddr & lp_mask;
+            lp[i].mask = lp_mask;
+            return;
+        }
+        mask = lp_mask & lp[i].mask;
+        while (((lp[i].addr ^ vaddr) & mask) != 0) {
+            mask <<= 1;
+        }
+        if (mask > best_mask) {
+            best_mask = mask;
+            best = i;
+        }
+    }
+
+    /* All slots are used: extend the region that grows the least.
+       This is a compromise between unnecessary flushes and
+       the cost of maintaining a full variable size TLB.  */
+    lp[best].addr &= best_mask;
+    lp[best].mask = best_mask;
 }
 
 /* Add a new TLB entry. At most one entry for a given virtual address
@@ -1205,12 +1533,8 @@ void tlb_set_page_with_attrs(CPUState *cpu, target_ulong vaddr,
      * different page; otherwise just overwrite the stale data.
      */
     if (!tlb_hit_page_anyprot(te, vaddr_page) && !tlb_entry_is_empty(te)) {
-        unsigned vidx = desc->vindex++ % CPU_VTLB_SIZE;
-        CPUTLBEntry *tv = &desc->vtable[vidx];
-
         /* Evict the old entry into the victim tlb.  */
-        copy_tlb_helper_locked(tv, te);
-        desc->viotlb[vidx] = desc->iotlb[index];
+        tlb_vtlb_insert_locked(desc, te, &desc->iotlb[index]);
         tlb_n_used_entries_dec(env, mmu_idx);
     }
 
@@ -1443,15 +1767,17 @@ static inline target_ulong tlb_read_ofs(CPUTLBEntry *entry, size_t ofs)
 }
 
 /* Return true if ADDR is present in the victim tlb, and has been copied
-   back to the main tlb.  */
+   back to the main tlb.  Only the set of ADDR needs to be searched.  */
 static bool victim_tlb_hit(CPUArchState *env, size_t mmu_idx, size_t index,
                            size_t elt_ofs, target_ulong page)
 {
-    size_t vidx;
+    CPUTLBDesc *desc = &env_tlb(env)->d[mmu_idx];
+    size_t vidx, set = tlb_vtlb_set(desc, page);
 
     assert_cpu_is_self(env_cpu(env));
-    for (vidx = 0; vidx < CPU_VTLB_SIZE; ++vidx) {
-        CPUTLBEntry *vtlb = &env_tlb(env)->d[mmu_idx].vtable[vidx];
+    qatomic_set(&desc->miss_count, desc->miss_count + 1);
+    for (vidx = set; vidx < set + CPU_VTLB_WAYS; ++vidx) {
+        CPUTLBEntry *vtlb = &desc->vtable[vidx];
         target_ulong cmp;
 
         /* elt_ofs might correspond to .addr_write, so use qatomic_read */
@@ -1462,18 +1788,25 @@ static bool victim_tlb_hit(CPUArchState *env, size_t mmu_idx, size_t index,
 #endif
 
         if (cmp == page) {
-            /* Found entry in victim tlb, swap tlb and iotlb.  */
+            /*
+             * Found entry in victim tlb, swap tlb and iotlb.  The entry
+             * evicted from the tlb goes to the set of its own page.
+             */
             CPUTLBEntry tmptlb, *tlb = &env_tlb(env)->f[mmu_idx].table[index];
+            CPUIOTLBEntry tmpio, *io = &desc->iotlb[index];
 
             qemu_spin_lock(&env_tlb(env)->c.lock);
             copy_tlb_helper_locked(&tmptlb, tlb);
+            tmpio = *io;
             copy_tlb_helper_locked(tlb, vtlb);
-            copy_tlb_helper_locked(vtlb, &tmptlb);
+            *io = desc->viotlb[vidx];
+            memset(vtlb, -1, sizeof(*vtlb));
+            if (!tlb_entry_is_empty(&tmptlb)) {
+                tlb_vtlb_insert_locked(desc, &tmptlb, &tmpio);
+            }
             qemu_spin_unlock(&env_tlb(env)->c.lock);
 
-            CPUIOTLBEntry tmpio, *io = &env_tlb(env)->d[mmu_idx].iotlb[index];
-            CPUIOTLBEntry *vio = &env_tlb(env)->d[mmu_idx].viotlb[vidx];
-            tmpio = *io; *io = *vio; *vio = tmpio;
+            qatomic_set(&desc->vtlb_hit_count, desc->vtlb_hit_count + 1);
             return true;
         }
     }
@@ -14,6 +14,12 @@
 TranslationBlock *tb_gen_code(CPUState *cpu, target_ulong pc,
                               target_ulong cs_base, uint32_t flags,
                               int cflags);
+void tb_tier_up(CPUState *cpu, TranslationBlock *tb);
+#ifdef CONFIG_USER_ONLY
+bool tb_link_cached(TranslationBlock *tb);
+void translate_pool_add_jumps(CPUState *cpu, TranslationBlock *tb);
+bool translate_pool_add_hot(CPUState *cpu, TranslationBlock *tb);
+#endif
 
 void QEMU_NORETURN cpu_io_recompile(CPUState *cpu, uintptr_t retaddr);
 void page_init(void);
@@ -0,0 +1,499 @@
+/*
+ * Persistent translation cache for user-mode emulation
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "qemu/osdep.h"
+#include <sys/personality.h>
+#include <sys/utsname.h>
+#include "elf.h"
+#include "qemu/cacheflush.h"
+#include "qemu/crc32c.h"
+#include "qemu/cutils.h"
+#include "qemu/error-report.h"
+#include "exec/exec-all.h"
+#include "tcg/tcg.h"
+#include "tb-context.h"
+#include "internal.h"
+#include "trace.h"
+
+/*
+ * A cache file holds the code translated for one guest program, as it
+ * was when the last process running it exited: a header, the executable
+ * file mappings the guest code came from, the TBs that can be reused,
+ * and an image of the code buffer.
+ *
+ * Host code is not relocatable: it embeds the addresses of helpers, of
+ * the code buffer, of the TBs themselves and guest_base. So instead of
+ * relocating it, the image is only reused by the same QEMU binary at the
+ * same address, with the code buffer at the same address and the same
+ * guest_base, where every embedded address is still right.
+ *
+ * The image is host code that gets executed, so the cache directory and
+ * files are only used if they belong to the user running QEMU and nobody
+ * else can write to them.
+ *
+ * TBs are linked lazily, when the guest maps the file range they were
+ * translated from at the same address again, and only if the crc32c of
+ * their guest code still matches. Everything else in the image is dead
+ * code until the next flush.
+ */
+
+#define TB_CACHE_MAGIC "QEMUTBC"
+#define TB_CACHE_VERSION 1
+
+typedef struct TBCacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t n_maps;
+    uint64_t n_tbs;
+    /* the QEMU binary that generated the code, and where it was loaded */
+    uint64_t exe_dev;
+    uint64_t exe_ino;
+    int64_t exe_mtime;
+    int64_t exe_mtime_nsec;
+    uint64_t anchor;
+    uint64_t guest_base;
+    /* start of the code buffer, where the image must be loaded */
+    uint64_t buffer;
+    uint64_t image_size;
+    /* host features, CPU model and TCG options of the code */
+    char config[256];
+} TBCacheHeader;
+
+/* A file mapping, or the part of it that was still mapped at exit */
+typedef struct TBCacheMap {
+    uint64_t dev;
+    uint64_t ino;
+    int64_t mtime;
+    int64_t mtime_nsec;
+    uint64_t offset;
+    uint64_t start;
+    uint64_t len;
+} TBCacheMap;
+
+typedef struct TBCacheEntry {
+    uint64_t tb;        /* offset of the TranslationBlock in the image */
+    uint32_t map;       /* index of the mapping holding its guest code */
+    uint32_t crc;       /* crc32c of its guest code */
+} TBCacheEntry;
+
+static struct {
+    char *path;
+    char *cpu_model;
+    int fd;
+    TBCacheHeader header;
+    TBCacheMap *maps;
+    TBCacheEntry *entries;
+    /* the loaded image, NULL if there is none or it was flushed */
+    uint8_t *image;
+    unsigned int flush_count;
+    /* executable file mappings of this process */
+    GArray *live;
+} tb_cache = { .fd = -1 };
+
+/*
+ * The code depends on the host instructions the TCG backend found at
+ * startup, not just on the host architecture: a cache written where AVX2
+ * or BMI2 were there must not be loaded where they are not.
+ */
+static void tb_cache_config(char *buf, size_t len)
+{
+    char features[128];
+    struct utsname u;
+
+    if (uname(&u) < 0) {
+        memset(&u, 0, sizeof(u));
+    }
+    tcg_host_features(features, sizeof(features));
+    snprintf(buf, len, "%s [%s] cpu=%s return-stack=%d tier-threshold=%u "
+             "chain-liveness=%d", u.machine, features, tb_cache.cpu_model,
+             tcg_return_stack, tcg_tier_threshold, tcg_chain_liveness);
+}
+
+static bool tb_cache_get_exe(TBCacheHeader *h)
+{
+    struct stat st;
+
+    if (stat("/proc/self/exe", &st) < 0) {
+        return false;
+    }
+    h->exe_dev = st.st_dev;
+    h->exe_ino = st.st_ino;
+    h->exe_mtime = st.st_mtim.tv_sec;
+    h->exe_mtime_nsec = st.st_mtim.tv_nsec;
+    h->anchor = (uintptr_t)tb_cache_save;
+    return true;
+}
+
+static bool tb_cache_read(void *buf, size_t len)
+{
+    return read(tb_cache.fd, buf, len) == len;
+}
+
+static void tb_cache_close(void)
+{
+    close(tb_cache.fd);
+    tb_cache.fd = -1;
+}
+
+/* Does @st belong to the current user, with nobody else allowed to write? */
+static bool tb_cache_trusted(const struct stat *st)
+{
+    return st->st_uid == geteuid() && !(st->st_mode & (S_IWGRP | S_IWOTH));
+}
+
+/*
+ * Is QEMU loaded at a random address? The code buffer and the code it
+ * holds point into QEMU, so then the cache can never be reused.
+ */
+static bool tb_cache_exe_randomized(void)
+{
+    g_autofree char *aslr = NULL;
+    uint16_t e_type;
+    int fd;
+    bool pie;
+
+    fd = open("/proc/self/exe", O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    /* e_type has the same offset in 32 and 64-bit ELF headers */
+    pie = pread(fd, &e_type, sizeof(e_type), EI_NIDENT) == sizeof(e_type) &&
+          e_type == ET_DYN;
+    close(fd);
+
+    if (!pie || (personality(0xffffffff) & ADDR_NO_RANDOMIZE)) {
+        return false;
+    }
+    return !g_file_get_contents("/proc/sys/kernel/randomize_va_space",
+                                &aslr, NULL, NULL) || aslr[0] != '0';
+}
+
+void tb_cache_open(const char *dir, int execfd, const char *cpu_model)
+{
+    TBCacheHeader *h = &tb_cache.header;
+    TBCacheHeader exe = { };
+    struct stat st;
+
+    if (tb_cache_exe_randomized()) {
+        warn_report("-tb-cache: QEMU is position independent and loaded at "
+                    "a random address, the cache cannot be used");
+        return;
+    }
+    if (stat(dir, &st) < 0 || !S_ISDIR(st.st_mode) ||
+        !tb_cache_trusted(&st)) {
+        warn_report("-tb-cache: %s must be a directory that only the "
+                    "current user can write to", dir);
+        return;
+    }
+    if (fstat(execfd, &st) < 0) {
+        return;
+    }
+    tb_cache.path = g_strdup_printf("%s/%" PRIx64 "-%" PRIx64 ".tbc", dir,
+                                    (uint64_t)st.st_dev,
+                                    (uint64_t)st.st_ino);
+    tb_cache.cpu_model = g_strdup(cpu_model);
+    tb_cache.live = g_array_new(false, false, sizeof(TBCacheMap));
+
+    tb_cache.fd = open(tb_cache.path, O_RDONLY | O_NOFOLLOW);
+    if (tb_cache.fd < 0) {
+        return;
+    }
+    if (fstat(tb_cache.fd, &st) < 0 || !S_ISREG(st.st_mode) ||
+        !tb_cache_trusted(&st)) {
+        warn_report("-tb-cache: ignoring %s, which the current user does not "
+                    "own or others can write to", tb_cache.path);
+        tb_cache_close();
+        return;
+    }
+    if (!tb_cache_read(h, sizeof(*h)) ||
+        memcmp(h->magic, TB_CACHE_MAGIC, sizeof(h->magic)) ||
+        h->version != TB_CACHE_VERSION ||
+        !tb_cache_get_exe(&exe) ||
+        h->exe_dev != exe.exe_dev || h->exe_ino != exe.exe_ino ||
+        h->exe_mtime != exe.exe_mtime ||
+        h->exe_mtime_nsec != exe.exe_mtime_nsec ||
+        h->anchor != exe.anchor ||
+        h->n_tbs > h->image_size / sizeof(TranslationBlock)) {
+        tb_cache_close();
+        return;
+    }
+
+    tb_cache.maps = g_try_new(TBCacheMap, h->n_maps);
+    tb_cache.entries = g_try_new(TBCacheEntry, h->n_tbs);
+    if (!tb_cache.maps || !tb_cache.entries ||
+        !tb_cache_read(tb_cache.maps, h->n_maps * sizeof(TBCacheMap)) ||
+        !tb_cache_read(tb_cache.entries, h->n_tbs * sizeof(TBCacheEntry))) {
+        tb_cache_close();
+        return;
+    }
+
+    /* ask for the code buffer where the image expects it */
+    tcg_code_gen_hint = (void *)(uintptr_t)h->buffer;
+}
+
+void tb_cache_load(void)
+{
+    TBCacheHeader *h = &tb_cache.header;
+    uint8_t *buf = tcg_ctx->code_gen_buffer;
+    char config[sizeof(h->config)];
+    uint64_t i;
+
+    if (tb_cache.fd < 0) {
+        return;
+    }
+    tb_cache_config(config, sizeof(config));
+    if (tcg_tb_evict || tcg_splitwx_diff ||
+        h->buffer != (uintptr_t)buf || h->guest_base != guest_base ||
+        h->image_size > tcg_ctx->code_gen_buffer_size ||
+        strncmp(h->config, config, sizeof(config)) ||
+        !tb_cache_read(buf, h->image_size)) {
+        tb_cache_close();
+        return;
+    }
+    tb_cache_close();
+
+    /* drop the entries that do not describe a TB within the image */
+    for (i = 0; i < h->n_tbs; i++) {
+        TBCacheEntry *e = &tb_cache.entries[i];
+        TranslationBlock *tb = (TranslationBlock *)(buf + e->tb);
+
+        if (e->tb > h->image_size - sizeof(*tb) || e->map >= h->n_maps ||
+            (uint8_t *)tb->tc.ptr < buf ||
+            (uint8_t *)tb->tc.ptr + tb->tc.size > buf + h->image_size) {
+            e->map = UINT32_MAX;
+        }
+    }
+
+    flush_idcache_range((uintptr_t)buf, (uintptr_t)buf, h->image_size);
+    qatomic_set(&tcg_ctx->code_gen_ptr, buf + h->image_size);
+    tb_cache.image = buf;
+    tb_cache.flush_count = qatomic_read(&tb_ctx.tb_flush_count);
+    trace_tb_cache_load(tb_cache.path, h->n_tbs, h->image_size);
+}
+
+/* Link the TBs of the saved mapping @map, now part of the new mapping @m */
+static void tb_cache_link(const TBCacheMap *m, uint32_t map)
+{
+    const TBCacheMap *c = &tb_cache.maps[map];
+    unsigned int linked = 0, stale = 0;
+    uint64_t i;
+
+    for (i = 0; i < tb_cache.header.n_tbs; i++) {
+        TBCacheEntry *e = &tb_cache.entries[i];
+        TranslationBlock *tb = (TranslationBlock *)(tb_cache.image + e->tb);
+
+        if (e->map != map) {
+            continue;
+        }
+        if (!tb->size || tb->pc < c->start ||
+            tb->pc + tb->size > c->start + c->len ||
+            ((tb->pc ^ (tb->pc + tb->size - 1)) & TARGET_PAGE_MASK) ||
+            (tb->cflags & CF_INVALID) ||
+            crc32c(0, g2h_untagged(tb->pc), tb->size) != e->crc) {
+            stale++;
+            continue;
+        }
+        if (tb_link_cached(tb)) {
+            linked++;
+        }
+    }
+    trace_tb_cache_link(m->start, linked, stale);
+}
+
+void tb_cache_map(target_ulong start, target_ulong len, int prot,
+                  int fd, target_ulong offset)
+{
+    TBCacheMap m;
+    struct stat st;
+    uint32_t i;
+
+    if (!tb_cache.live) {
+        return;
+    }
+    tb_cache_unmap(start, len);
+    if (fd < 0 || !(prot & PROT_EXEC) || fstat(fd, &st) < 0) {
+        return;
+    }
+
+    m = (TBCacheMap) {
+        .dev = st.st_dev,
+        .ino = st.st_ino,
+        .mtime = st.st_mtim.tv_sec,
+        .mtime_nsec = st.st_mtim.tv_nsec,
+        .offset = offset,
+        .start = start,
+        .len = len,
+    };
+    g_array_append_val(tb_cache.live, m);
+
+    if (!tb_cache.image) {
+        return;
+    }
+    if (qatomic_read(&tb_ctx.tb_flush_count) != tb_cache.flush_count) {
+        /* the image was overwritten */
+        tb_cache.image = NULL;
+        return;
+    }
+    for (i = 0; i < tb_cache.header.n_maps; i++) {
+        TBCacheMap *c = &tb_cache.maps[i];
+
+        if (c->len && c->dev == m.dev && c->ino == m.ino &&
+            c->mtime == m.mtime && c->mtime_nsec == m.mtime_nsec &&
+            c->start >= m.start && c->start + c->len <= m.start + m.len &&
+            c->offset - m.offset == c->start - m.start) {
+            tb_cache_link(&m, i);
+            /* a TB is linked at most once, even if it gets invalidated */
+            c->len = 0;
+        }
+    }
+}
+
+void tb_cache_unmap(target_ulong start, target_ulong len)
+{
+    target_ulong end = start + len;
+    guint i;
+
+    if (!tb_cache.live) {
+        return;
+    }
+    for (i = tb_cache.live->len; i-- > 0; ) {
+        TBCacheMap m = g_array_index(tb_cache.live, TBCacheMap, i);
+
+        if (m.start >= end || m.start + m.len <= start) {
+            continue;
+        }
+        /* keep what is left on either side */
+        g_array_remove_index_fast(tb_cache.live, i);
+        if (m.start < start) {
+            TBCacheMap left = m;
+
+            left.len = start - m.start;
+            g_array_append_val(tb_cache.live, left);
+        }
+        if (m.start + m.len > end) {
+            TBCacheMap right = m;
+
+            right.start = end;
+            right.offset += end - m.start;
+            right.len = m.start + m.len - end;
+            g_array_append_val(tb_cache.live, right);
+        }
+    }
+}
+
+typedef struct TBCacheSave {
+    uint8_t *base;
+    uint8_t *copy;
+    size_t size;
+    GArray *entries;
+} TBCacheSave;
+
+static gboolean tb_cache_save_tb(gpointer key, gpointer value, gpointer data)
+{
+    TranslationBlock *tb = value;
+    TBCacheSave *s = data;
+    uintptr_t tc_ptr = (uintptr_t)tb->tc.ptr;
+    TBCacheEntry e;
+    guint i;
+    int n;
+
+    if ((uint8_t *)tb < s->base || (uint8_t *)tb >= s->base + s->size) {
+        return false;
+    }
+
+    /* the copy of the code must not jump to TBs that might not be linked */
+    for (n = 0; n < 2; n++) {
+        uintptr_t addr = tc_ptr + tb->jmp_reset_offset[n];
+
+        if (tb->jmp_reset_offset[n] == TB_JMP_RESET_OFFSET_INVALID) {
+            continue;
+        }
+        if (TCG_TARGET_HAS_direct_jump) {
+            uintptr_t jmp_rx = tc_ptr + tb->jmp_target_arg[n];
+            uintptr_t jmp_rw = jmp_rx - (uintptr_t)s->base +
+                               (uintptr_t)s->copy;
+
+            tb_target_set_jmp_target(tc_ptr, jmp_rx, jmp_rw, addr);
+        } else {
+            TranslationBlock *copy = (TranslationBlock *)
+                (s->copy + ((uint8_t *)tb - s->base));
+
+            copy->jmp_target_arg[n] = addr;
+        }
+    }
+
+    if ((tb_cflags(tb) & CF_INVALID) || tb->page_addr[0] == -1 ||
+        tb->page_addr[1] != -1 ||
+        !(page_get_flags(tb->pc) & (PAGE_READ | PAGE_EXEC))) {
+        return false;
+    }
+    for (i = 0; i < tb_cache.live->len; i++) {
+        TBCacheMap *m = &g_array_index(tb_cache.live, TBCacheMap, i);
+
+        if (tb->pc >= m->start && tb->pc + tb->size <= m->start + m->len) {
+            e.tb = (uint8_t *)tb - s->base;
+            e.map = i;
+            e.crc = crc32c(0, g2h_untagged(tb->pc), tb->size);
+            g_array_append_val(s->entries, e);
+            break;
+        }
+    }
+    return false;
+}
+
+void tb_cache_save(void)
+{
+    TBCacheHeader h = { .magic = TB_CACHE_MAGIC, .version = TB_CACHE_VERSION };
+    TBCacheSave s;
+    g_autofree char *tmp = NULL;
+    bool ok;
+    int fd;
+
+    if (!tb_cache.live || tcg_tb_evict || tcg_splitwx_diff ||
+        !qatomic_read(&tb_ctx.tb_gen_count) || !tb_cache_get_exe(&h)) {
+        return;
+    }
+
+    mmap_lock();
+    s.base = tcg_ctx->code_gen_buffer;
+    s.size = tcg_current_code_size(tcg_ctx);
+    s.copy = g_malloc(s.size);
+    s.entries = g_array_new(false, false, sizeof(TBCacheEntry));
+    memcpy(s.copy, s.base, s.size);
+    tcg_tb_foreach(tb_cache_save_tb, &s);
+    mmap_unlock();
+
+    h.n_maps = tb_cache.live->len;
+    h.n_tbs = s.entries->len;
+    h.guest_base = guest_base;
+    h.buffer = (uintptr_t)s.base;
+    h.image_size = s.size;
+    tb_cache_config(h.config, sizeof(h.config));
+
+    /* concurrent processes each write their own file, the last one wins */
+    tmp = g_strdup_printf("%s.%d", tb_cache.path, getpid());
+    unlink(tmp);
+    fd = open(tmp, O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW, 0600);
+    if (fd >= 0) {
+        ok = qemu_write_full(fd, &h, sizeof(h)) == sizeof(h) &&
+             qemu_write_full(fd, tb_cache.live->data,
+                             h.n_maps * sizeof(TBCacheMap)) ==
+                 h.n_maps * sizeof(TBCacheMap) &&
+             qemu_write_full(fd, s.entries->data,
+                             h.n_tbs * sizeof(TBCacheEntry)) ==
+                 h.n_tbs * sizeof(TBCacheEntry) &&
+             qemu_write_full(fd, s.copy, s.size) == s.size;
+        close(fd);
+        if (ok && rename(tmp, tb_cache.path) == 0) {
+            trace_tb_cache_save(tb_cache.path, h.n_tbs, h.image_size);
+        } else {
+            unlink(tmp);
+        }
+    }
+
+    g_array_free(s.entries, true);
+    g_free(s.copy);
+}
@@ -35,6 +35,12 @@ struct TBContext {
     /* statistics */
     unsigned tb_flush_count;
     unsigned tb_phys_invalidate_count;
+    unsigned tb_evict_count;
+    unsigned tb_tier_up_count;
+    size_t tb_evicted_count;
+    /* TBs translated, and translated again after a flush or an eviction */
+    size_t tb_gen_count;
+    size_t tb_regen_count;
 };
 
 extern TBContext tb_ctx;
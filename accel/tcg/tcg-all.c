@@ -42,8 +42,12 @@ struct TCGState {
     AccelState parent_obj;
 
     bool mttcg_enabled;
+    bool chain_liveness;
+    bool return_stack;
+    bool tb_evict;
     int splitwx_enabled;
     unsigned long tb_size;
+    uint32_t tier_threshold;
 };
 typedef struct TCGState TCGState;
 
@@ -109,6 +113,10 @@ static void tcg_accel_instance_init(Object *obj)
 }
 
 bool mttcg_enabled;
+bool tcg_chain_liveness;
+bool tcg_return_stack;
+bool tcg_tb_evict;
+unsigned int tcg_tier_threshold;
 
 static int tcg_init_machine(MachineState *ms)
 {
@@ -121,6 +129,18 @@ static int tcg_init_machine(MachineState *ms)
 
     tcg_allowed = true;
     mttcg_enabled = s->mttcg_enabled;
+    tcg_chain_liveness = s->chain_liveness;
+    tcg_return_stack = s->return_stack;
+    tcg_tb_evict = s->tb_evict;
+#ifdef TARGET_SUPPORTS_SUPERBLOCKS
+    tcg_tier_threshold = s->tier_threshold;
+#else
+    /* retranslating would produce the same code again */
+    if (s->tier_threshold) {
+        warn_report("Guest does not form superblocks, "
+                    "ignoring tier-threshold");
+    }
+#endif
 
     page_init();
     tb_htable_init();
@@ -196,6 +216,30 @@ static void tcg_set_tb_size(Object *obj, Visitor *v,
     s->tb_size = value;
 }
 
+static void tcg_get_tier_threshold(Object *obj, Visitor *v,
+                                   const char *name, void *opaque,
+                                   Error **errp)
+{
+    TCGState *s = TCG_STATE(obj);
+    uint32_t value = s->tier_threshold;
+
+    visit_type_uint32(v, name, &value, errp);
+}
+
+static void tcg_set_tier_threshold(Object *obj, Visitor *v,
+                                   const char *name, void *opaque,
+                                   Error **errp)
+{
+    TCGState *s = TCG_STATE(obj);
+    uint32_t value;
+
+    if (!visit_type_uint32(v, name, &value, errp)) {
+        return;
+    }
+
+    s->tier_threshold = value;
+}
+
 static bool tcg_get_splitwx(Object *obj, Error **errp)
 {
     TCGState *s = TCG_STATE(obj);
@@ -208,6 +252,42 @@ static void tcg_set_splitwx(Object *obj, bool value, Error **errp)
     s->splitwx_enabled = value;
 }
 
+static bool tcg_get_chain_liveness(Object *obj, Error **errp)
+{
+    TCGState *s = TCG_STATE(obj);
+    return s->chain_liveness;
+}
+
+static void tcg_set_chain_liveness(Object *obj, bool value, Error **errp)
+{
+    TCGState *s = TCG_STATE(obj);
+    s->chain_liveness = value;
+}
+
+static bool tcg_get_return_stack(Object *obj, Error **errp)
+{
+    TCGState *s = TCG_STATE(obj);
+    return s->return_stack;
+}
+
+static void tcg_set_return_stack(Object *obj, bool value, Error **errp)
+{
+    TCGState *s = TCG_STATE(obj);
+    s->return_stack = value;
+}
+
+static bool tcg_get_tb_evict(Object *obj, Error **errp)
+{
+    TCGState *s = TCG_STATE(obj);
+    return s->tb_evict;
+}
+
+static void tcg_set_tb_evict(Object *obj, bool value, Error **errp)
+{
+    TCGState *s = TCG_STATE(obj);
+    s->tb_evict = value;
+}
+
 static void tcg_accel_class_init(ObjectClass *oc, void *data)
 {
     AccelClass *ac = ACCEL_CLASS(oc);
@@ -229,6 +309,27 @@ static void tcg_accel_class_init(ObjectClass *oc, void *data)
         tcg_get_splitwx, tcg_set_splitwx);
     object_class_property_set_description(oc, "split-wx",
         "Map jit pages into separate RW and RX regions");
+
+    object_class_property_add_bool(oc, "chain-liveness",
+        tcg_get_chain_liveness, tcg_set_chain_liveness);
+    object_class_property_set_description(oc, "chain-liveness",
+        "Skip syncing guest registers the next chained TB overwrites");
+
+    object_class_property_add_bool(oc, "return-stack",
+        tcg_get_return_stack, tcg_set_return_stack);
+    object_class_property_set_description(oc, "return-stack",
+        "Predict guest returns with a shadow return stack");
+
+    object_class_property_add_bool(oc, "tb-evict",
+        tcg_get_tb_evict, tcg_set_tb_evict);
+    object_class_property_set_description(oc, "tb-evict",
+        "Evict the oldest translations instead of flushing them all");
+
+    object_class_property_add(oc, "tier-threshold", "int",
+        tcg_get_tier_threshold, tcg_set_tier_threshold,
+        NULL, NULL);
+    object_class_property_set_description(oc, "tier-threshold",
+        "Executions after which a TB is retranslated as a superblock");
 }
 
 static const TypeInfo tcg_accel_type = {
@@ -220,6 +220,45 @@ static void *l1_map[V_L1_MAX_SIZE];
 
 TBContext tb_ctx;
 
+/*
+ * Code thrown away by a flush or an eviction, hashed into a bitmap so
+ * that translating it again can be counted, approximately, as a
+ * retranslation in tb_ctx.tb_regen_count.
+ */
+#define TB_DISCARD_BITS 20
+#define TB_DISCARD_SIZE (1 << TB_DISCARD_BITS)
+
+static unsigned long tb_discarded[BITS_TO_LONGS(TB_DISCARD_SIZE)];
+
+static unsigned long tb_discard_bit(const TranslationBlock *tb)
+{
+    tb_page_addr_t phys_pc = tb->page_addr[0] + (tb->pc & ~TARGET_PAGE_MASK);
+    uint32_t h = tb_hash_func(phys_pc, tb->pc, tb->flags,
+                              tb_cflags(tb) & ~CF_INVALID,
+                              tb->trace_vcpu_dstate);
+
+    return h & (TB_DISCARD_SIZE - 1);
+}
+
+/* Call before discarding @tb because the code buffer is full */
+static void tb_discard_mark(const TranslationBlock *tb)
+{
+    /* invalidated TBs were not discarded for lack of space */
+    if (tb->page_addr[0] != -1 && !(tb_cflags(tb) & CF_INVALID)) {
+        set_bit_atomic(tb_discard_bit(tb), tb_discarded);
+    }
+}
+
+/* Return true if @tb, just translated, had been discarded before */
+static bool tb_discard_clear(const TranslationBlock *tb)
+{
+    unsigned long bit = tb_discard_bit(tb);
+    unsigned long *p = &tb_discarded[BIT_WORD(bit)];
+
+    return qatomic_read(p) & BIT_MASK(bit) &&
+           qatomic_fetch_and(p, ~BIT_MASK(bit)) & BIT_MASK(bit);
+}
+
 static void page_table_config_init(void)
 {
     uint32_t v_l1_bits;
@@ -952,6 +991,12 @@ static void page_flush_tb(void)
     }
 }
 
+static gboolean tb_discard_iter(gpointer key, gpointer value, gpointer data)
+{
+    tb_discard_mark(value);
+    return false;
+}
+
 static gboolean tb_host_size_iter(gpointer key, gpointer value, gpointer data)
 {
     const TranslationBlock *tb = value;
@@ -988,6 +1033,7 @@ static void do_tb_flush(CPUState *cpu, run_on_cpu_data tb_flush_count)
         cpu_tb_jmp_cache_clear(cpu);
     }
 
+    tcg_tb_foreach(tb_discard_iter, NULL);
     qht_reset_size(&tb_ctx.htable, CODE_GEN_HTABLE_SIZE);
     page_flush_tb();
 
@@ -1017,6 +1063,72 @@ void tb_flush(CPUState *cpu)
     }
 }
 
+static gboolean tb_evict_iter(gpointer key, gpointer value, gpointer data)
+{
+    TranslationBlock *tb = value;
+    size_t *nb_tbs = data;
+
+    tb_discard_mark(tb);
+    tb_phys_invalidate(tb, -1);
+    (*nb_tbs)++;
+    return false;
+}
+
+/*
+ * Evict the oldest regions of the code buffer. Their TBs are invalidated
+ * one by one, which also unlinks them from the TBs that remain.
+ * Unlike do_tb_flush, plugins are not told: that would free the dynamic
+ * callbacks of the TBs that remain, so the ones of evicted TBs are only
+ * freed by the next flush.
+ *
+ * Invalidation only drops the indirect branch cache and return stack
+ * entries leading to a TB, not those whose site is the TB. Evicted TB
+ * structs are reused for new TBs, which could then match such a stale
+ * site, so those caches are cleared on every CPU like on a flush.
+ */
+static void do_tb_evict(CPUState *cpu, run_on_cpu_data tb_evict_count)
+{
+    CPUState *c;
+    size_t nb_tbs = 0;
+
+    mmap_lock();
+    /* If another CPU got the oldest regions evicted meanwhile, just retry. */
+    if (tb_ctx.tb_evict_count != tb_evict_count.host_int) {
+        goto done;
+    }
+
+    qemu_thread_jit_write();
+    tcg_region_evict(tb_evict_iter, &nb_tbs);
+    qemu_thread_jit_execute();
+
+    CPU_FOREACH(c) {
+        cpu_tb_ibtc_clear(c);
+    }
+
+    if (DEBUG_TB_FLUSH_GATE) {
+        printf("qemu: evict code_size=%zu nb_tbs=%zu\n",
+               tcg_code_size(), nb_tbs);
+    }
+
+    qatomic_set(&tb_ctx.tb_evicted_count, tb_ctx.tb_evicted_count + nb_tbs);
+    qatomic_mb_set(&tb_ctx.tb_evict_count, tb_ctx.tb_evict_count + 1);
+
+done:
+    mmap_unlock();
+}
+
+static void tb_evict(CPUState *cpu)
+{
+    unsigned tb_evict_count = qatomic_mb_read(&tb_ctx.tb_evict_count);
+
+    if (cpu_in_exclusive_context(cpu)) {
+        do_tb_evict(cpu, RUN_ON_CPU_HOST_INT(tb_evict_count));
+    } else {
+        async_safe_run_on_cpu(cpu, do_tb_evict,
+                              RUN_ON_CPU_HOST_INT(tb_evict_count));
+    }
+}
+
 /*
  * Formerly ifdef DEBUG_TB_CHECK. These debug functions are user-mode-only,
  * so in order to prevent bit rot we compile them unconditionally in user-mode,
@@ -1164,6 +1276,42 @@ static inline void tb_jmp_unlink(TranslationBlock *dest)
     qemu_spin_unlock(&dest->jmp_lock);
 }
 
+/*
+ * Drop the indirect branch target cache and return stack entries of @cpu
+ * leading to @tb. Entries are filled under tb->jmp_lock once CF_INVALID
+ * is checked, so none can be added after this runs. A return stack entry
+ * copied from its cell just before may still lead to @tb once, like a
+ * jump being taken while the TB is unlinked.
+ */
+static void tb_ibtc_remove(CPUState *cpu, TranslationBlock *tb)
+{
+    unsigned int i, j;
+
+    for (i = 0; i < TB_IBTC_SIZE; i++) {
+        for (j = 0; j < TB_IBTC_WAYS; j++) {
+            TBIndirectCacheEntry *e = &cpu->tb_ibtc[i].entry[j];
+
+            if (qatomic_read(&e->tc_ptr) == tb->tc.ptr) {
+                qatomic_set(&e->site, NULL);
+            }
+        }
+    }
+    for (i = 0; i < TB_RAS_CONT_SIZE; i++) {
+        TBReturnCont *c = &cpu->tb_ras.cont[i];
+
+        if (qatomic_read(&c->tc_ptr) == tb->tc.ptr) {
+            qatomic_set(&c->site, NULL);
+        }
+    }
+    for (i = 0; i < TB_RAS_SIZE; i++) {
+        TBReturnStackEntry *e = &cpu->tb_ras.entry[i];
+
+        if (qatomic_read(&e->tc_ptr) == tb->tc.ptr) {
+            qatomic_set(&e->cont_site, NULL);
+        }
+    }
+}
+
 /*
  * In user-mode, call with mmap_lock held.
  * In !user-mode, if @rm_from_page_list is set, call with the TB's pages'
@@ -1210,6 +1358,7 @@ static void do_tb_phys_invalidate(TranslationBlock *tb, bool rm_from_page_list)
         if (qatomic_read(&cpu->tb_jmp_cache[h]) == tb) {
             qatomic_set(&cpu->tb_jmp_cache[h], NULL);
         }
+        tb_ibtc_remove(cpu, tb);
     }
 
     /* suppress this TB from the two jump lists */
@@ -1377,10 +1526,69 @@ tb_link_page(TranslationBlock *tb, tb_page_addr_t phys_pc,
     return tb;
 }
 
-/* Called with mmap_lock held for user mode emulation.  */
-TranslationBlock *tb_gen_code(CPUState *cpu,
-                              target_ulong pc, target_ulong cs_base,
-                              uint32_t flags, int cflags)
+/* Whether a TB with @cflags has no constraint on the instructions it runs */
+static bool tb_cflags_free(uint32_t cflags)
+{
+    uint32_t fixed = CF_COUNT_MASK | CF_LAST_IO | CF_USE_ICOUNT |
+                     CF_NOIRQ | CF_SINGLE_STEP;
+
+    return !(cflags & fixed);
+}
+
+/*
+ * Tier of a new TB with @cflags. Only TBs with no constraint on the
+ * instructions they run are counted, and then retranslated.
+ */
+static int tb_tier(uint32_t cflags)
+{
+    return tcg_tier_threshold && tb_cflags_free(cflags) ? 1 : 0;
+}
+
+/*
+ * With tcg_chain_liveness, find the globals that the TBs the direct jumps
+ * of @tb lead to overwrite before reading them, so that the jumps need
+ * not sync them. Only the TBs in the jump cache are considered, as a
+ * full lookup may have to fill the TLB.
+ */
+static void tb_chain_carry(CPUState *cpu, TranslationBlock *tb)
+{
+    int n;
+
+    for (n = 0; n < 2; n++) {
+        int i = tcg_ctx->goto_tb_slot[n];
+        TranslationBlock *next;
+        target_ulong dest;
+
+        tcg_ctx->goto_tb_carry[n] = 0;
+        if (!tcg_chain_liveness || !TCG_TARGET_HAS_goto_tb_exitreq ||
+            (tb->cflags & (CF_USE_ICOUNT | CF_NOIRQ)) || i < 0) {
+            continue;
+        }
+        dest = tcg_ctx->goto_tb_dest[i];
+        if (dest == tb->pc) {
+            /* tcg_gen_code() knows once it has analyzed the TB */
+            tcg_ctx->goto_tb_carry[n] = UINT64_MAX;
+            continue;
+        }
+        next = qatomic_rcu_read(&cpu->tb_jmp_cache[
+                                    tb_jmp_cache_hash_func(dest)]);
+        if (next && next->pc == dest && next->cs_base == tb->cs_base &&
+            next->flags == tb->flags && tb_cflags(next) == tb->cflags &&
+            next->chain_offset) {
+            tcg_ctx->goto_tb_carry[n] = next->dead_in;
+        }
+    }
+}
+
+/*
+ * Translate a TB, as a tier 2 superblock if @superblock.
+ * Called with mmap_lock held for user mode emulation.
+ */
+static TranslationBlock *tb_gen_code_tier(CPUState *cpu,
+                                          target_ulong pc,
+                                          target_ulong cs_base,
+                                          uint32_t flags, int cflags,
+                                          bool superblock)
 {
     CPUArchState *env = cpu->env_ptr;
     TranslationBlock *tb, *existing_tb;
@@ -1412,8 +1620,12 @@ TranslationBlock *tb_gen_code(CPUState *cpu,
  buffer_overflow:
     tb = tcg_tb_alloc(tcg_ctx);
     if (unlikely(!tb)) {
-        /* flush must be done */
-        tb_flush(cpu);
+        /* make room, either for all new code or in the oldest regions */
+        if (tcg_tb_evict) {
+            tb_evict(cpu);
+        } else {
+            tb_flush(cpu);
+        }
         mmap_unlock();
         /* Make the execution loop process the flush as soon as possible.  */
         cpu->exception_index = EXCP_INTERRUPT;
@@ -1427,6 +1639,8 @@ TranslationBlock *tb_gen_code(CPUState *cpu,
     tb->flags = flags;
     tb->cflags = cflags;
     tb->trace_vcpu_dstate = *cpu->trace_dstate;
+    tb->tier = superblock ? 2 : tb_tier(cflags);
+    tb->tier_count = tcg_tier_threshold;
     tcg_ctx->tb_cflags = cflags;
  tb_overflow:
 
@@ -1462,6 +1676,7 @@ TranslationBlock *tb_gen_code(CPUState *cpu,
         tcg_ctx->tb_jmp_insn_offset = NULL;
         tcg_ctx->tb_jmp_target_addr = tb->jmp_target_arg;
     }
+    tb_chain_carry(cpu, tb);
 
 #ifdef CONFIG_PROFILER
     qatomic_set(&prof->tb_count, prof->tb_count + 1);
@@ -1651,9 +1866,78 @@ TranslationBlock *tb_gen_code(CPUState *cpu,
         tcg_tb_remove(tb);
         return existing_tb;
     }
+
+    qatomic_inc(&tb_ctx.tb_gen_count);
+    if (tb_discard_clear(tb)) {
+        qatomic_inc(&tb_ctx.tb_regen_count);
+    }
+#ifdef CONFIG_USER_ONLY
+    /* the jumps of TBs for special cases lead to ordinary TBs */
+    if (tb_cflags_free(cflags)) {
+        translate_pool_add_jumps(cpu, tb);
+    }
+#endif
     return tb;
 }
 
+/* Called with mmap_lock held for user mode emulation.  */
+TranslationBlock *tb_gen_code(CPUState *cpu,
+                              target_ulong pc, target_ulong cs_base,
+                              uint32_t flags, int cflags)
+{
+    return tb_gen_code_tier(cpu, pc, cs_base, flags, cflags, false);
+}
+
+/*
+ * Retranslate @tb, whose execution count hit zero, as a tier 2
+ * superblock. @tb is invalidated first: that unlinks it from the TBs
+ * jumping to it and drops it from the lookup caches, so that they all
+ * pick up the superblock, which has the same hash, instead.
+ */
+void tb_tier_up(CPUState *cpu, TranslationBlock *tb)
+{
+    uint32_t cflags;
+
+    mmap_lock();
+    cflags = tb_cflags(tb);
+    /* another vCPU may have got there first */
+    if (!(cflags & CF_INVALID)) {
+        tb_phys_invalidate(tb, -1);
+        qatomic_inc(&tb_ctx.tb_tier_up_count);
+        tb_gen_code_tier(cpu, tb->pc, tb->cs_base, tb->flags, cflags, true);
+    }
+    mmap_unlock();
+}
+
+#ifdef CONFIG_USER_ONLY
+/*
+ * Publish @tb, loaded from the persistent translation cache, as if
+ * tb_gen_code() had just generated it. Its guest code must be on a
+ * single page. Returns false if an equivalent TB was already there.
+ *
+ * Called with mmap_lock held.
+ */
+bool tb_link_cached(TranslationBlock *tb)
+{
+    assert_memory_lock();
+
+    qemu_spin_init(&tb->jmp_lock);
+    tb->jmp_list_head = (uintptr_t)NULL;
+    tb->jmp_list_next[0] = (uintptr_t)NULL;
+    tb->jmp_list_next[1] = (uintptr_t)NULL;
+    tb->jmp_dest[0] = (uintptr_t)NULL;
+    tb->jmp_dest[1] = (uintptr_t)NULL;
+
+    page_protect(tb->pc);
+    tcg_tb_insert(tb);
+    if (tb_link_page(tb, tb->pc, -1) != tb) {
+        tcg_tb_remove(tb);
+        return false;
+    }
+    return true;
+}
+#endif
+
 /*
  * @p must be non-NULL.
  * user-mode: call with mmap_lock held.
@@ -2069,7 +2353,9 @@ void dump_exec_info(GString *buf)
 {
     struct tb_tree_stats tst = {};
     struct qht_stats hst;
-    size_t nb_tbs, flush_full, flush_part, flush_elide;
+    size_t nb_tbs, flush_full, flush_part, flush_elide, flush_large;
+    size_t flush_coalesced;
+    size_t gen, regen;
 
     tcg_tb_foreach(tb_tree_stats_iter, &tst);
     nb_tbs = tst.nb_tbs;
@@ -2110,11 +2396,26 @@ void dump_exec_info(GString *buf)
                            qatomic_read(&tb_ctx.tb_flush_count));
     g_string_append_printf(buf, "TB invalidate count %u\n",
                            qatomic_read(&tb_ctx.tb_phys_invalidate_count));
-
-    tlb_flush_counts(&flush_full, &flush_part, &flush_elide);
+    g_string_append_printf(buf, "TB tier-up count    %u\n",
+                           qatomic_read(&tb_ctx.tb_tier_up_count));
+    g_string_append_printf(buf, "TB evict count      %u (%zu TBs)\n",
+                           qatomic_read(&tb_ctx.tb_evict_count),
+                           qatomic_read(&tb_ctx.tb_evicted_count));
+    gen = qatomic_read(&tb_ctx.tb_gen_count);
+    regen = qatomic_read(&tb_ctx.tb_regen_count);
+    g_string_append_printf(buf, "TB retranslations   %zu/%zu (%zu%%)\n",
+                           regen, gen, gen ? (regen * 100) / gen : 0);
+
+    tlb_flush_counts(&flush_full, &flush_part, &flush_elide, &flush_large,
+                     &flush_coalesced);
     g_string_append_printf(buf, "TLB full flushes    %zu\n", flush_full);
     g_string_append_printf(buf, "TLB partial flushes %zu\n", flush_part);
     g_string_append_printf(buf, "TLB elided flushes  %zu\n", flush_elide);
+    g_string_append_printf(buf, "TLB large page flushes %zu "
+                           "(full flushes avoided)\n", flush_large);
+    g_string_append_printf(buf, "TLB coalesced flushes %zu\n",
+                           flush_coalesced);
+    tlb_dump_mmu_stats(buf);
     tcg_dump_info(buf);
 }
 
@@ -2292,6 +2593,15 @@ void page_set_flags(target_ulong start, target_ulong end, int flags)
             (flags & PAGE_WRITE) &&
             p->first_tb) {
             tb_invalidate_phys_page(addr, 0);
+        } else if ((p->flags & PAGE_EXEC) &&
+                   (!(flags & PAGE_EXEC) || !(flags & PAGE_VALID)) &&
+                   p->first_tb) {
+            /*
+             * Direct jumps may chain into this page from any other page,
+             * see translator_use_goto_tb(). Invalidating its TBs unlinks
+             * them before the page stops being executable.
+             */
+            tb_invalidate_phys_page(addr, 0);
         }
         if (reset_target_data) {
             g_free(p->target_data);
@@ -0,0 +1,267 @@
+/*
+ * Background translation for user-mode emulation
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "qemu/osdep.h"
+#include "qemu/units.h"
+#include "qemu/thread.h"
+#include "qemu/rcu.h"
+#include "qom/object.h"
+#include "exec/exec-all.h"
+#include "tcg/tcg.h"
+#include "tb-context.h"
+#include "internal.h"
+#include "trace.h"
+
+/*
+ * Translator threads take work off the vCPU threads: they translate the
+ * direct jump destinations of new TBs before the guest gets there, and
+ * retranslate hot TBs as superblocks while the vCPU keeps running the
+ * old code.
+ *
+ * In user mode all translation is serialized by mmap_lock, so a job
+ * runs under it like any other translation, and a vCPU that needs the
+ * lock meanwhile waits for the job. To keep that wait to at most one
+ * TB, jobs for jump destinations, which are only guesses, are dropped
+ * rather than waiting for the lock; only the rarer hot TB jobs wait.
+ * Faults raised by code fetches can only be handled on a vCPU thread
+ * though, so a job is dropped unless its code is mapped executable,
+ * and so is a job that would have to flush the code buffer.
+ */
+
+/* Jobs beyond this many are dropped */
+#define TRANSLATE_POOL_JOBS 256
+/* How many direct jumps ahead of the translated code to go */
+#define TRANSLATE_POOL_DEPTH 2
+/* Free code buffer a job needs, so that it never has to make room */
+#define TRANSLATE_POOL_ROOM (128 * KiB)
+
+typedef struct TranslateJob {
+    CPUState *cpu;
+    /* the hot TB to retranslate, or NULL to translate pc */
+    TranslationBlock *tb;
+    unsigned int gen;
+    /* for hot TBs, the key of tb in case it was freed */
+    target_ulong pc;
+    target_ulong cs_base;
+    uint32_t flags;
+    uint32_t cflags;
+    int depth;
+} TranslateJob;
+
+static struct {
+    QemuMutex lock;
+    QemuCond cond;
+    GQueue jobs;
+    unsigned int n_threads;
+} pool;
+
+/* Depth of the job being translated by this thread, 0 on vCPU threads */
+static __thread int translate_depth;
+
+/* Changes whenever TBs are freed, making the TBs of pending jobs stale */
+static unsigned int translate_pool_gen(void)
+{
+    return qatomic_read(&tb_ctx.tb_flush_count) +
+           qatomic_read(&tb_ctx.tb_evict_count);
+}
+
+static bool translate_pool_push(const TranslateJob *job)
+{
+    bool ok;
+
+    qemu_mutex_lock(&pool.lock);
+    ok = g_queue_get_length(&pool.jobs) < TRANSLATE_POOL_JOBS;
+    if (ok) {
+        object_ref(OBJECT(job->cpu));
+        g_queue_push_tail(&pool.jobs, g_memdup(job, sizeof(*job)));
+        qemu_cond_signal(&pool.cond);
+    }
+    qemu_mutex_unlock(&pool.lock);
+    return ok;
+}
+
+void translate_pool_add_jumps(CPUState *cpu, TranslationBlock *tb)
+{
+    int i;
+
+    if (!pool.n_threads || translate_depth >= TRANSLATE_POOL_DEPTH) {
+        return;
+    }
+    for (i = 0; i < tcg_ctx->nb_goto_tb_dest; i++) {
+        TranslateJob job = {
+            .cpu = cpu,
+            .pc = tcg_ctx->goto_tb_dest[i],
+            .cs_base = tb->cs_base,
+            .flags = tb->flags,
+            .cflags = tb_cflags(tb),
+            .depth = translate_depth + 1,
+        };
+
+        translate_pool_push(&job);
+    }
+}
+
+bool translate_pool_add_hot(CPUState *cpu, TranslationBlock *tb)
+{
+    TranslateJob job = {
+        .cpu = cpu,
+        .tb = tb,
+        .gen = translate_pool_gen(),
+        .pc = tb->pc,
+        .cs_base = tb->cs_base,
+        .flags = tb->flags,
+        .cflags = tb_cflags(tb),
+    };
+
+    return pool.n_threads && translate_pool_push(&job);
+}
+
+/* Called with mmap_lock held */
+static bool translate_pool_can_translate(TranslateJob *job)
+{
+    target_ulong next = (job->pc | ~TARGET_PAGE_MASK) + 1;
+    TranslationBlock *tb;
+
+    if ((uintptr_t)tcg_ctx->code_gen_highwater -
+        (uintptr_t)tcg_ctx->code_gen_ptr < TRANSLATE_POOL_ROOM) {
+        return false;
+    }
+    if (job->tb) {
+        return job->gen == translate_pool_gen();
+    }
+
+    /* a TB spans at most two pages */
+    if (!(page_get_flags(job->pc) & PAGE_EXEC) ||
+        !(page_get_flags(next) & PAGE_EXEC)) {
+        return false;
+    }
+    WITH_RCU_READ_LOCK_GUARD() {
+        tb = tb_htable_lookup(job->cpu, job->pc, job->cs_base, job->flags,
+                              job->cflags);
+    }
+    return !tb;
+}
+
+/*
+ * The tier_count of a hot TB has gone past zero and will not hit it
+ * again: when its job is dropped, start the count over so that it can
+ * be queued again later. Called with mmap_lock held, or in the child
+ * after fork().
+ */
+static void translate_pool_refuse_hot(TranslateJob *job)
+{
+    TranslationBlock *tb = job->tb;
+
+    if (job->gen != translate_pool_gen()) {
+        /* job->tb may have been freed, look for what replaced it */
+        WITH_RCU_READ_LOCK_GUARD() {
+            tb = tb_htable_lookup(job->cpu, job->pc, job->cs_base,
+                                  job->flags, job->cflags);
+        }
+        if (!tb || tb->tier != 1) {
+            return;
+        }
+    }
+    qatomic_set(&tb->tier_count, tcg_tier_threshold);
+}
+
+static void translate_pool_drop(TranslateJob *job)
+{
+    object_unref(OBJECT(job->cpu));
+    g_free(job);
+}
+
+static void *translate_pool_thread(void *arg)
+{
+    rcu_register_thread();
+    tcg_register_thread();
+
+    while (true) {
+        TranslateJob *job;
+
+        qemu_mutex_lock(&pool.lock);
+        while (g_queue_is_empty(&pool.jobs)) {
+            qemu_cond_wait(&pool.cond, &pool.lock);
+        }
+        job = g_queue_pop_head(&pool.jobs);
+        qemu_mutex_unlock(&pool.lock);
+
+        /* a vCPU may be translating, do not make it wait for a guess */
+        if (job->tb) {
+            mmap_lock();
+        } else if (!mmap_trylock()) {
+            translate_pool_drop(job);
+            continue;
+        }
+        if (translate_pool_can_translate(job)) {
+            translate_depth = job->depth;
+            if (job->tb) {
+                tb_tier_up(job->cpu, job->tb);
+            } else {
+                tb_gen_code(job->cpu, job->pc, job->cs_base, job->flags,
+                            job->cflags);
+            }
+            trace_translate_pool_job(job->tb, job->pc, job->depth);
+        } else if (job->tb) {
+            translate_pool_refuse_hot(job);
+        }
+        mmap_unlock();
+
+        translate_pool_drop(job);
+    }
+    return NULL;
+}
+
+static void translate_pool_start(void)
+{
+    QemuThread thread;
+    unsigned int i;
+
+    qemu_mutex_init(&pool.lock);
+    qemu_cond_init(&pool.cond);
+    g_queue_init(&pool.jobs);
+    for (i = 0; i < pool.n_threads; i++) {
+        qemu_thread_create(&thread, "tcg-translate", translate_pool_thread,
+                           NULL, QEMU_THREAD_DETACHED);
+    }
+}
+
+void translate_pool_init(unsigned int n_threads)
+{
+    pool.n_threads = n_threads;
+    if (n_threads) {
+        translate_pool_start();
+    }
+}
+
+void translate_pool_fork_start(void)
+{
+    if (pool.n_threads) {
+        qemu_mutex_lock(&pool.lock);
+    }
+}
+
+void translate_pool_fork_end(int child)
+{
+    if (!pool.n_threads) {
+        return;
+    }
+    if (!child) {
+        qemu_mutex_unlock(&pool.lock);
+        return;
+    }
+
+    /* the child has no translator thread: drop the jobs, start new ones */
+    while (!g_queue_is_empty(&pool.jobs)) {
+        TranslateJob *job = g_queue_pop_head(&pool.jobs);
+
+        if (job->tb) {
+            translate_pool_refuse_hot(job);
+        }
+        translate_pool_drop(job);
+    }
+    translate_pool_start();
+}
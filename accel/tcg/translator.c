@@ -33,13 +33,37 @@ void translator_loop_temp_check(DisasContextBase *db)
 
 bool translator_use_goto_tb(DisasContextBase *db, target_ulong dest)
 {
+    bool ok;
+
     /* Suppress goto_tb if requested. */
     if (tb_cflags(db->tb) & CF_NO_GOTO_TB) {
         return false;
     }
 
+#ifdef CONFIG_USER_ONLY
+    /*
+     * Guest mappings only change under mmap_lock, and every page that is
+     * unmapped, remapped or made non-executable has its TBs invalidated,
+     * which unlinks the jumps into them. So the destination may be on
+     * any page.
+     */
+    ok = true;
+#else
     /* Check for the dest on the same page as the start of the TB.  */
-    return ((db->pc_first ^ dest) & TARGET_PAGE_MASK) == 0;
+    ok = ((db->pc_first ^ dest) & TARGET_PAGE_MASK) == 0;
+#endif
+
+    /* Remember it, so that it can be translated ahead of time */
+    if (ok && tcg_ctx->nb_goto_tb_dest < ARRAY_SIZE(tcg_ctx->goto_tb_dest)) {
+        tcg_ctx->goto_tb_dest[tcg_ctx->nb_goto_tb_dest++] = dest;
+    }
+    return ok;
+}
+
+bool translator_follow_jump(DisasContextBase *db, target_ulong dest)
+{
+    return db->tb->tier == 2 && dest > db->pc_next &&
+           ((db->pc_first ^ dest) & TARGET_PAGE_MASK) == 0;
 }
 
 static inline void translator_page_protect(DisasContextBase *dcbase,
@@ -65,6 +89,9 @@ void translator_loop(const TranslatorOps *ops, DisasContextBase *db,
     db->num_insns = 0;
     db->max_insns = max_insns;
     db->singlestep_enabled = cflags & CF_SINGLE_STEP;
+    tcg_ctx->nb_goto_tb_dest = 0;
+    tcg_ctx->goto_tb_slot[0] = tcg_ctx->goto_tb_slot[1] = -1;
+    tcg_ctx->nb_branch_sites = 0;
     translator_page_protect(db, db->pc_next);
 
     ops->init_disas_context(db, cpu);
@@ -1102,6 +1102,8 @@ int bdrv_parse_aio(const char *mode, int *flags)
 #ifdef CONFIG_LINUX_IO_URING
     } else if (!strcmp(mode, "io_uring")) {
         *flags |= BDRV_O_IO_URING;
+    } else if (!strcmp(mode, "io_uring-poll")) {
+        *flags |= BDRV_O_IO_URING_POLL;
 #endif
     } else {
         return -1;
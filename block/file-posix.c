@@ -157,6 +157,9 @@ typedef struct BDRVRawState {
     bool discard_zeroes:1;
     bool use_linux_aio:1;
     bool use_linux_io_uring:1;
+    bool use_linux_io_uring_poll:1;
+    /* the device refused polled I/O, use the regular ring instead */
+    bool io_uring_poll_unsupported:1;
     int page_cache_inconsistent; /* errno from fdatasync failure */
     bool has_fallocate;
     bool needs_alignment;
@@ -543,7 +546,8 @@ static QemuOptsList raw_runtime_opts = {
         {
             .name = "aio",
             .type = QEMU_OPT_STRING,
-            .help = "host AIO implementation (threads, native, io_uring)",
+            .help = "host AIO implementation "
+                    "(threads, native, io_uring, io_uring-poll)",
         },
         {
             .name = "aio-max-batch",
@@ -578,6 +582,60 @@ static QemuOptsList raw_runtime_opts = {
 
 static const char *const mutable_opts[] = { "x-check-cache-dropped", NULL };
 
+#ifdef CONFIG_LINUX_IO_URING
+/*
+ * Return the polled io_uring ring for the requests of @bs, or NULL.  The
+ * main loop never polls, so polling for completions would only add
+ * latency there; nodes in the main AioContext use the regular ring.
+ */
+static LuringState *raw_io_uring_poll(BlockDriverState *bs)
+{
+    BDRVRawState *s = bs->opaque;
+    AioContext *ctx = bdrv_get_aio_context(bs);
+
+    if (!s->use_linux_io_uring_poll || ctx == qemu_get_aio_context()) {
+        return NULL;
+    }
+    return aio_get_linux_io_uring_poll(ctx);
+}
+#endif
+
+/*
+ * Add @fd to, or remove it from, the io_uring registered files of the
+ * AioContext of @bs.  Registered files stay open until they are removed.
+ */
+static void raw_register_fd(BlockDriverState *bs, int fd)
+{
+#ifdef CONFIG_LINUX_IO_URING
+    BDRVRawState *s = bs->opaque;
+    LuringState *poll_ring = raw_io_uring_poll(bs);
+
+    if (s->use_linux_io_uring && fd >= 0) {
+        luring_register_fd(aio_get_linux_io_uring(bdrv_get_aio_context(bs)),
+                           fd);
+    }
+    if (poll_ring && fd >= 0) {
+        luring_register_fd(poll_ring, fd);
+    }
+#endif
+}
+
+static void raw_unregister_fd(BlockDriverState *bs, int fd)
+{
+#ifdef CONFIG_LINUX_IO_URING
+    BDRVRawState *s = bs->opaque;
+    LuringState *poll_ring = raw_io_uring_poll(bs);
+
+    if (s->use_linux_io_uring && fd >= 0) {
+        luring_unregister_fd(aio_get_linux_io_uring(bdrv_get_aio_context(bs)),
+                             fd);
+    }
+    if (poll_ring && fd >= 0) {
+        luring_unregister_fd(poll_ring, fd);
+    }
+#endif
+}
+
 static int raw_open_common(BlockDriverState *bs, QDict *options,
                            int bdrv_flags, int open_flags,
                            bool device, Error **errp)
@@ -610,6 +668,8 @@ static int raw_open_common(BlockDriverState *bs, QDict *options,
 #ifdef CONFIG_LINUX_IO_URING
     } else if (bdrv_flags & BDRV_O_IO_URING) {
         aio_default = BLOCKDEV_AIO_OPTIONS_IO_URING;
+    } else if (bdrv_flags & BDRV_O_IO_URING_POLL) {
+        aio_default = BLOCKDEV_AIO_OPTIONS_IO_URING_POLL;
 #endif
     } else {
         aio_default = BLOCKDEV_AIO_OPTIONS_THREADS;
@@ -626,7 +686,10 @@ static int raw_open_common(BlockDriverState *bs, QDict *options,
 
     s->use_linux_aio = (aio == BLOCKDEV_AIO_OPTIONS_NATIVE);
 #ifdef CONFIG_LINUX_IO_URING
-    s->use_linux_io_uring = (aio == BLOCKDEV_AIO_OPTIONS_IO_URING);
+    /* the regular ring takes the requests that cannot be polled */
+    s->use_linux_io_uring = (aio == BLOCKDEV_AIO_OPTIONS_IO_URING ||
+                             aio == BLOCKDEV_AIO_OPTIONS_IO_URING_POLL);
+    s->use_linux_io_uring_poll = (aio == BLOCKDEV_AIO_OPTIONS_IO_URING_POLL);
 #endif
 
     s->aio_max_batch = qemu_opt_get_number(opts, "aio-max-batch", 0);
@@ -730,6 +793,21 @@ static int raw_open_common(BlockDriverState *bs, QDict *options,
             goto fail;
         }
     }
+    if (s->use_linux_io_uring_poll) {
+        /* Polled I/O bypasses the page cache */
+        if (!(s->open_flags & O_DIRECT)) {
+            error_setg(errp, "aio=io_uring-poll was specified, but it "
+                             "requires cache.direct=on, which was not "
+                             "specified.");
+            ret = -EINVAL;
+            goto fail;
+        }
+        if (bdrv_get_aio_context(bs) != qemu_get_aio_context() &&
+            !aio_setup_linux_io_uring_poll(bdrv_get_aio_context(bs), errp)) {
+            error_prepend(errp, "Unable to use io_uring-poll: ");
+            goto fail;
+        }
+    }
 #else
     if (s->use_linux_io_uring) {
         error_setg(errp, "aio=io_uring was specified, but is not supported "
@@ -804,6 +882,7 @@ static int raw_open_common(BlockDriverState *bs, QDict *options,
         /* When extending regular files, we get zeros from the OS */
         bs->supported_truncate_flags = BDRV_REQ_ZERO_WRITE;
     }
+    raw_register_fd(bs, s->fd);
     ret = 0;
 fail:
     if (ret < 0 && s->fd != -1) {
@@ -2066,7 +2145,19 @@ static int coroutine_fn raw_co_prw(BlockDriverState *bs, uint64_t offset,
 #ifdef CONFIG_LINUX_IO_URING
     } else if (s->use_linux_io_uring) {
         LuringState *aio = aio_get_linux_io_uring(bdrv_get_aio_context(bs));
+        LuringState *poll_ring = raw_io_uring_poll(bs);
         assert(qiov->size == bytes);
+        if (poll_ring && !s->io_uring_poll_unsupported) {
+            int ret;
+
+            ret = luring_co_submit(bs, poll_ring, s->fd, offset, qiov, type);
+            if (ret != -EOPNOTSUPP) {
+                return ret;
+            }
+            warn_report_once("%s: the device does not support polled I/O, "
+                             "falling back to aio=io_uring", bs->filename);
+            s->io_uring_poll_unsupported = true;
+        }
         return luring_co_submit(bs, aio, s->fd, offset, qiov, type);
 #endif
 #ifdef CONFIG_LINUX_AIO
@@ -2169,6 +2260,13 @@ static int raw_co_flush_to_disk(BlockDriverState *bs)
     return raw_thread_pool_submit(bs, handle_aiocb_flush, &acb);
 }
 
+static void raw_aio_detach_aio_context(BlockDriverState *bs)
+{
+    BDRVRawState *s = bs->opaque;
+
+    raw_unregister_fd(bs, s->fd);
+}
+
 static void raw_aio_attach_aio_context(BlockDriverState *bs,
                                        AioContext *new_context)
 {
@@ -2190,9 +2288,19 @@ static void raw_aio_attach_aio_context(BlockDriverState *bs,
             error_reportf_err(local_err, "Unable to use linux io_uring, "
                                          "falling back to thread pool: ");
             s->use_linux_io_uring = false;
+            s->use_linux_io_uring_poll = false;
+        }
+    }
+    if (s->use_linux_io_uring_poll && new_context != qemu_get_aio_context()) {
+        Error *local_err = NULL;
+        if (!aio_setup_linux_io_uring_poll(new_context, &local_err)) {
+            error_reportf_err(local_err, "Unable to use linux io_uring-poll, "
+                                         "falling back to io_uring: ");
+            s->use_linux_io_uring_poll = false;
         }
     }
 #endif
+    raw_register_fd(bs, s->fd);
 }
 
 static void raw_close(BlockDriverState *bs)
@@ -2200,6 +2308,7 @@ static void raw_close(BlockDriverState *bs)
     BDRVRawState *s = bs->opaque;
 
     if (s->fd >= 0) {
+        raw_unregister_fd(bs, s->fd);
         qemu_close(s->fd);
         s->fd = -1;
     }
@@ -3195,7 +3304,9 @@ static void raw_set_perm(BlockDriverState *bs, uint64_t perm, uint64_t shared)
     /* For reopen, we have already switched to the new fd (.bdrv_set_perm is
      * called after .bdrv_reopen_commit) */
     if (s->perm_change_fd && s->fd != s->perm_change_fd) {
+        raw_unregister_fd(bs, s->fd);
         qemu_close(s->fd);
+        raw_register_fd(bs, s->perm_change_fd);
         s->fd = s->perm_change_fd;
         s->open_flags = s->perm_change_flags;
     }
@@ -3297,6 +3408,7 @@ BlockDriver bdrv_file = {
     .bdrv_io_plug = raw_aio_plug,
     .bdrv_io_unplug = raw_aio_unplug,
     .bdrv_attach_aio_context = raw_aio_attach_aio_context,
+    .bdrv_detach_aio_context = raw_aio_detach_aio_context,
 
     .bdrv_co_truncate = raw_co_truncate,
     .bdrv_getlength = raw_getlength,
@@ -3663,6 +3775,7 @@ static BlockDriver bdrv_host_device = {
     .bdrv_io_plug = raw_aio_plug,
     .bdrv_io_unplug = raw_aio_unplug,
     .bdrv_attach_aio_context = raw_aio_attach_aio_context,
+    .bdrv_detach_aio_context = raw_aio_detach_aio_context,
 
     .bdrv_co_truncate       = raw_co_truncate,
     .bdrv_getlength	= raw_getlength,
@@ -3787,6 +3900,7 @@ static BlockDriver bdrv_host_cdrom = {
     .bdrv_io_plug = raw_aio_plug,
     .bdrv_io_unplug = raw_aio_unplug,
     .bdrv_attach_aio_context = raw_aio_attach_aio_context,
+    .bdrv_detach_aio_context = raw_aio_detach_aio_context,
 
     .bdrv_co_truncate    = raw_co_truncate,
     .bdrv_getlength      = raw_getlength,
@@ -3917,6 +4031,7 @@ static BlockDriver bdrv_host_cdrom = {
     .bdrv_io_plug = raw_aio_plug,
     .bdrv_io_unplug = raw_aio_unplug,
     .bdrv_attach_aio_context = raw_aio_attach_aio_context,
+    .bdrv_detach_aio_context = raw_aio_detach_aio_context,
 
     .bdrv_co_truncate    = raw_co_truncate,
     .bdrv_getlength      = raw_getlength,
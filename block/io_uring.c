@@ -16,12 +16,27 @@
 #include "block/block.h"
 #include "block/raw-aio.h"
 #include "qemu/coroutine.h"
+#include "qemu/error-report.h"
 #include "qapi/error.h"
+#include "exec/ramlist.h"
+#include "exec/cpu-common.h"
 #include "trace.h"
 
 /* io_uring ring size */
 #define MAX_ENTRIES 128
 
+/* Size of the registered file table */
+#define MAX_FIXED_FILES 64
+
+/* The kernel refuses to register buffers larger than this */
+#define MAX_FIXED_BUFFER_SIZE (1ULL << 30)
+
+/* How long the SQPOLL thread spins before it goes to sleep, in ms */
+#define SQPOLL_IDLE_MS 1000
+
+/* How often an IOPOLL ring is reaped once busy-waiting stopped, in ns */
+#define IOPOLL_INTERVAL_NS (10 * SCALE_US)
+
 typedef struct LuringAIOCB {
     Coroutine *co;
     struct io_uring_sqe sqeq;
@@ -50,12 +65,39 @@ typedef struct LuringState {
     AioContext *aio_context;
 
     struct io_uring ring;
+    unsigned int flags;
 
     /* io queue for submit at batch.  Protected by AioContext lock. */
     LuringQueue io_q;
 
     /* I/O completion processing.  Only runs in I/O thread.  */
     QEMUBH *completion_bh;
+
+    /*
+     * IOPOLL rings only: when requests were last submitted or completed,
+     * and the timer that reaps completions once busy-waiting stopped.
+     */
+    int64_t iopoll_progress_ns;
+    QEMUTimer *iopoll_timer;
+
+    /*
+     * Registered file table, -1 for free slots.  Protected by AioContext
+     * lock.
+     */
+    int files[MAX_FIXED_FILES];
+    unsigned int files_refcnt[MAX_FIXED_FILES];
+
+    /*
+     * Registered buffers, as struct iovec indexed by buf_index.  The
+     * kernel may read an SQE long after it was queued, so a buffer keeps
+     * its index until it is removed; the slot then points to @hole until
+     * a new buffer takes it.  @buffer_map has the indexes of the other
+     * slots, sorted by address.  Protected by AioContext lock.
+     */
+    GArray *buffers;
+    GArray *buffer_map;
+    void *hole;
+    RAMBlockNotifier ram_notifier;
 } LuringState;
 
 /**
@@ -70,6 +112,26 @@ static void luring_resubmit(LuringState *s, LuringAIOCB *luringcb)
     s->io_q.in_queue++;
 }
 
+/*
+ * Turn a request that uses a fixed buffer back into a plain one.  Return
+ * false if @luringcb does not use a fixed buffer.
+ */
+static bool luring_unfix(LuringAIOCB *luringcb)
+{
+    struct io_uring_sqe *sqe = &luringcb->sqeq;
+
+    if (sqe->opcode != IORING_OP_READ_FIXED &&
+        sqe->opcode != IORING_OP_WRITE_FIXED) {
+        return false;
+    }
+    sqe->opcode = sqe->opcode == IORING_OP_READ_FIXED ?
+                  IORING_OP_READV : IORING_OP_WRITEV;
+    sqe->addr = (__u64)(uintptr_t)luringcb->qiov->iov;
+    sqe->len = luringcb->qiov->niov;
+    sqe->buf_index = 0;
+    return true;
+}
+
 /**
  * luring_resubmit_short_read:
  *
@@ -102,7 +164,11 @@ static void luring_resubmit_short_read(LuringState *s, LuringAIOCB *luringcb,
     qemu_iovec_concat(resubmit_qiov, luringcb->qiov, luringcb->total_read,
                       remaining);
 
-    /* Update sqe */
+    /* Update sqe, a fixed buffer read continues as a plain one */
+    if (luringcb->sqeq.opcode == IORING_OP_READ_FIXED) {
+        luringcb->sqeq.opcode = IORING_OP_READV;
+        luringcb->sqeq.buf_index = 0;
+    }
     luringcb->sqeq.off = nread;
     luringcb->sqeq.addr = (__u64)(uintptr_t)luringcb->resubmit_qiov.iov;
     luringcb->sqeq.len = luringcb->resubmit_qiov.niov;
@@ -110,6 +176,47 @@ static void luring_resubmit_short_read(LuringState *s, LuringAIOCB *luringcb,
     luring_resubmit(s, luringcb);
 }
 
+/**
+ * luring_iopoll:
+ * @s: AIO state
+ *
+ * An IORING_SETUP_IOPOLL ring posts no completion events by itself, the
+ * kernel polls the device for completions when asked to.  Do that if
+ * requests are in flight.
+ */
+static void luring_iopoll(LuringState *s)
+{
+    if ((s->flags & LURING_IOPOLL) && qatomic_read(&s->io_q.in_flight)) {
+        /* with nothing to submit, this only reaps completions */
+        io_uring_submit(&s->ring);
+    }
+}
+
+/**
+ * luring_iopoll_rearm:
+ * @s: AIO state
+ * @progress: whether requests completed since the last call
+ *
+ * Completions of an IOPOLL ring never make the ring fd readable, so
+ * something else has to reap them while requests are in flight.  Within
+ * poll-max-ns of the last progress the AioContext's polling, or failing
+ * that the completion BH, busy-waits for them.  After that, and always
+ * with poll-max-ns=0, a timer reaps them every IOPOLL_INTERVAL_NS.
+ */
+static void luring_iopoll_rearm(LuringState *s, bool progress)
+{
+    int64_t now = qemu_clock_get_ns(QEMU_CLOCK_REALTIME);
+
+    if (progress) {
+        s->iopoll_progress_ns = now;
+    }
+    if (now - s->iopoll_progress_ns < s->aio_context->poll_max_ns) {
+        qemu_bh_schedule(s->completion_bh);
+    } else {
+        timer_mod(s->iopoll_timer, now + IOPOLL_INTERVAL_NS);
+    }
+}
+
 /**
  * luring_process_completions:
  * @s: AIO state
@@ -127,6 +234,7 @@ static void luring_process_completions(LuringState *s)
 {
     struct io_uring_cqe *cqes;
     int total_bytes;
+    bool progress = false;
     /*
      * Request completion callbacks can run the nested event loop.
      * Schedule ourselves so the nested event loop will "see" remaining
@@ -144,6 +252,7 @@ static void luring_process_completions(LuringState *s)
      */
     qemu_bh_schedule(s->completion_bh);
 
+    luring_iopoll(s);
     while (io_uring_peek_cqe(&s->ring, &cqes) == 0) {
         LuringAIOCB *luringcb;
         int ret;
@@ -156,6 +265,7 @@ static void luring_process_completions(LuringState *s)
         ret = cqes->res;
         io_uring_cqe_seen(&s->ring, cqes);
         cqes = NULL;
+        progress = true;
 
         /* Change counters one-by-one because we can be nested. */
         s->io_q.in_flight--;
@@ -183,6 +293,15 @@ static void luring_process_completions(LuringState *s)
                 luring_resubmit(s, luringcb);
                 continue;
             }
+            /*
+             * The fixed buffer went away before the kernel read the SQE,
+             * for example because registering the buffers failed after
+             * RAM hotplug.  Try again without it.
+             */
+            if (ret == -EFAULT && luring_unfix(luringcb)) {
+                luring_resubmit(s, luringcb);
+                continue;
+            }
         } else if (!luringcb->qiov) {
             goto end;
         } else if (total_bytes == luringcb->qiov->size) {
@@ -219,6 +338,14 @@ end:
         }
     }
     qemu_bh_cancel(s->completion_bh);
+
+    if (s->flags & LURING_IOPOLL) {
+        if (s->io_q.in_flight) {
+            luring_iopoll_rearm(s, progress);
+        } else {
+            timer_del(s->iopoll_timer);
+        }
+    }
 }
 
 static int ioq_submit(LuringState *s)
@@ -252,6 +379,9 @@ static int ioq_submit(LuringState *s)
         }
         s->io_q.in_flight += ret;
         s->io_q.in_queue  -= ret;
+        if (s->flags & LURING_IOPOLL) {
+            s->iopoll_progress_ns = qemu_clock_get_ns(QEMU_CLOCK_REALTIME);
+        }
     }
     s->io_q.blocked = (s->io_q.in_queue > 0);
 
@@ -288,10 +418,17 @@ static void qemu_luring_completion_cb(void *opaque)
     luring_process_completions_and_submit(s);
 }
 
+static void qemu_luring_iopoll_timer_cb(void *opaque)
+{
+    LuringState *s = opaque;
+    luring_process_completions_and_submit(s);
+}
+
 static bool qemu_luring_poll_cb(void *opaque)
 {
     LuringState *s = opaque;
 
+    luring_iopoll(s);
     return io_uring_cq_ready(&s->ring);
 }
 
@@ -328,6 +465,95 @@ void luring_io_unplug(BlockDriverState *bs, LuringState *s)
     }
 }
 
+/* Return the registered file table slot of @fd, or -1 */
+static int luring_fixed_file(LuringState *s, int fd)
+{
+    int i;
+
+    if (!(s->flags & LURING_FIXED_FILES)) {
+        return -1;
+    }
+    for (i = 0; i < MAX_FIXED_FILES; i++) {
+        if (s->files[i] == fd) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * luring_register_fd:
+ * @s: AIO state
+ * @fd: file descriptor
+ *
+ * Add @fd to the registered file table, so that requests for it skip the
+ * file lookup in the kernel.  Registration is only an optimization, @fd
+ * stays usable if the table is full or the kernel refuses it.  Every call
+ * must be paired with luring_unregister_fd() before @fd is closed.
+ */
+void luring_register_fd(LuringState *s, int fd)
+{
+    int i;
+
+    if (!(s->flags & LURING_FIXED_FILES)) {
+        return;
+    }
+    i = luring_fixed_file(s, fd);
+    if (i < 0) {
+        i = luring_fixed_file(s, -1);
+        if (i < 0 || io_uring_register_files_update(&s->ring, i, &fd, 1) < 0) {
+            return;
+        }
+        s->files[i] = fd;
+    }
+    s->files_refcnt[i]++;
+    trace_luring_register_fd(s, fd, i);
+}
+
+void luring_unregister_fd(LuringState *s, int fd)
+{
+    int i = luring_fixed_file(s, fd);
+    int unused = -1;
+
+    if (i < 0 || --s->files_refcnt[i]) {
+        return;
+    }
+    /* the kernel keeps the file open until it leaves the table */
+    io_uring_register_files_update(&s->ring, i, &unused, 1);
+    s->files[i] = -1;
+    trace_luring_unregister_fd(s, fd, i);
+}
+
+/* Return the buf_index of a registered buffer containing @iov, or -1 */
+static int luring_fixed_buffer(LuringState *s, QEMUIOVector *qiov)
+{
+    uintptr_t start, end;
+    int lo = 0, hi;
+
+    if (!s->buffer_map || qiov->niov != 1) {
+        return -1;
+    }
+    start = (uintptr_t)qiov->iov[0].iov_base;
+    end = start + qiov->iov[0].iov_len;
+
+    hi = s->buffer_map->len;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        guint index = g_array_index(s->buffer_map, guint, mid);
+        struct iovec *buf = &g_array_index(s->buffers, struct iovec, index);
+        uintptr_t base = (uintptr_t)buf->iov_base;
+
+        if (end <= base) {
+            hi = mid;
+        } else if (start >= base + buf->iov_len) {
+            lo = mid + 1;
+        } else {
+            return end <= base + buf->iov_len ? index : -1;
+        }
+    }
+    return -1;
+}
+
 /**
  * luring_do_submit:
  * @fd: file descriptor for I/O
@@ -344,13 +570,32 @@ static int luring_do_submit(int fd, LuringAIOCB *luringcb, LuringState *s,
 {
     int ret;
     struct io_uring_sqe *sqes = &luringcb->sqeq;
+    int file = luring_fixed_file(s, fd);
+    int buf = -1;
+
+    if (file >= 0) {
+        fd = file;
+    }
+    if (type == QEMU_AIO_WRITE || type == QEMU_AIO_READ) {
+        buf = luring_fixed_buffer(s, luringcb->qiov);
+    }
 
     switch (type) {
     case QEMU_AIO_WRITE:
+        if (buf >= 0) {
+            io_uring_prep_write_fixed(sqes, fd, luringcb->qiov->iov[0].iov_base,
+                                      luringcb->qiov->size, offset, buf);
+            break;
+        }
         io_uring_prep_writev(sqes, fd, luringcb->qiov->iov,
                              luringcb->qiov->niov, offset);
         break;
     case QEMU_AIO_READ:
+        if (buf >= 0) {
+            io_uring_prep_read_fixed(sqes, fd, luringcb->qiov->iov[0].iov_base,
+                                     luringcb->qiov->size, offset, buf);
+            break;
+        }
         io_uring_prep_readv(sqes, fd, luringcb->qiov->iov,
                             luringcb->qiov->niov, offset);
         break;
@@ -362,6 +607,9 @@ static int luring_do_submit(int fd, LuringAIOCB *luringcb, LuringState *s,
                         __func__, type);
         abort();
     }
+    if (file >= 0) {
+        sqes->flags |= IOSQE_FIXED_FILE;
+    }
     io_uring_sqe_set_data(sqes, luringcb);
 
     QSIMPLEQ_INSERT_TAIL(&s->io_q.submit_queue, luringcb, next);
@@ -407,6 +655,10 @@ void luring_detach_aio_context(LuringState *s, AioContext *old_context)
     aio_set_fd_handler(old_context, s->ring.ring_fd, false,
                        NULL, NULL, NULL, NULL, s);
     qemu_bh_delete(s->completion_bh);
+    if (s->iopoll_timer) {
+        timer_free(s->iopoll_timer);
+        s->iopoll_timer = NULL;
+    }
     s->aio_context = NULL;
 }
 
@@ -414,26 +666,213 @@ void luring_attach_aio_context(LuringState *s, AioContext *new_context)
 {
     s->aio_context = new_context;
     s->completion_bh = aio_bh_new(new_context, qemu_luring_completion_bh, s);
+    if (s->flags & LURING_IOPOLL) {
+        s->iopoll_timer = aio_timer_new(new_context, QEMU_CLOCK_REALTIME,
+                                        SCALE_NS, qemu_luring_iopoll_timer_cb,
+                                        s);
+    }
     aio_set_fd_handler(s->aio_context, s->ring.ring_fd, false,
                        qemu_luring_completion_cb, NULL,
                        qemu_luring_poll_cb, qemu_luring_poll_ready, s);
 }
 
-LuringState *luring_init(Error **errp)
+/*
+ * Guest RAM is registered if it is backed by memfd or hugepages, which is
+ * shared or uses large pages; pinning anonymous RAM would defeat memory
+ * overcommit.
+ */
+static bool luring_want_ram_block(void *host)
+{
+    ram_addr_t offset;
+    RAMBlock *rb = qemu_ram_block_from_host(host, false, &offset);
+
+    return rb && (qemu_ram_is_shared(rb) ||
+                  qemu_ram_pagesize(rb) > qemu_real_host_page_size);
+}
+
+/*
+ * RAM block notifiers run in the main thread, while requests look up
+ * s->buffers and s->buffer_map in the AioContext of the ring: take its
+ * lock for the whole update, not just for registering the buffers.
+ */
+static void luring_buffers_lock(LuringState *s)
+{
+    if (s->aio_context) {
+        aio_context_acquire(s->aio_context);
+    }
+}
+
+static void luring_buffers_unlock(LuringState *s)
+{
+    if (s->aio_context) {
+        aio_context_release(s->aio_context);
+    }
+}
+
+/*
+ * Replace the registered buffers with the contents of s->buffers.  Buffers
+ * that were registered before keep their index.  Called with the buffers
+ * locked.
+ */
+static void luring_update_buffers(LuringState *s)
+{
+    int ret;
+
+    io_uring_unregister_buffers(&s->ring);
+    ret = s->buffers->len ?
+        io_uring_register_buffers(&s->ring,
+                                  (struct iovec *)s->buffers->data,
+                                  s->buffers->len) : 0;
+    if (ret < 0) {
+        /* most likely RLIMIT_MEMLOCK; keep going with plain requests */
+        warn_report("io_uring: cannot register guest RAM as fixed buffers: "
+                    "%s", strerror(-ret));
+        g_array_set_size(s->buffers, 0);
+        g_array_set_size(s->buffer_map, 0);
+    }
+    trace_luring_update_buffers(s, s->buffers->len, ret);
+}
+
+static gint luring_buffer_compare(gconstpointer a, gconstpointer b,
+                                  gpointer opaque)
+{
+    GArray *buffers = opaque;
+    const struct iovec *x = &g_array_index(buffers, struct iovec,
+                                           *(const guint *)a);
+    const struct iovec *y = &g_array_index(buffers, struct iovec,
+                                           *(const guint *)b);
+
+    return x->iov_base < y->iov_base ? -1 : x->iov_base > y->iov_base;
+}
+
+static void luring_ram_block_added(RAMBlockNotifier *n, void *host,
+                                   size_t size, size_t max_size)
+{
+    LuringState *s = container_of(n, LuringState, ram_notifier);
+    size_t done;
+
+    if (!luring_want_ram_block(host)) {
+        return;
+    }
+    luring_buffers_lock(s);
+    for (done = 0; done < size; done += MAX_FIXED_BUFFER_SIZE) {
+        struct iovec iov = {
+            .iov_base = host + done,
+            .iov_len = MIN(size - done, MAX_FIXED_BUFFER_SIZE),
+        };
+        guint index;
+
+        /* Take the slot of a removed buffer, or add one */
+        for (index = 0; index < s->buffers->len; index++) {
+            if (g_array_index(s->buffers, struct iovec, index).iov_base ==
+                s->hole) {
+                break;
+            }
+        }
+        if (index < s->buffers->len) {
+            g_array_index(s->buffers, struct iovec, index) = iov;
+        } else {
+            g_array_append_val(s->buffers, iov);
+        }
+        g_array_append_val(s->buffer_map, index);
+    }
+    g_array_sort_with_data(s->buffer_map, luring_buffer_compare, s->buffers);
+    luring_update_buffers(s);
+    luring_buffers_unlock(s);
+}
+
+static void luring_ram_block_removed(RAMBlockNotifier *n, void *host,
+                                     size_t size, size_t max_size)
+{
+    LuringState *s = container_of(n, LuringState, ram_notifier);
+    bool changed = false;
+    guint i = 0;
+
+    luring_buffers_lock(s);
+    while (i < s->buffer_map->len) {
+        guint index = g_array_index(s->buffer_map, guint, i);
+        struct iovec *iov = &g_array_index(s->buffers, struct iovec, index);
+
+        if (iov->iov_base >= host && iov->iov_base < host + max_size) {
+            iov->iov_base = s->hole;
+            iov->iov_len = qemu_real_host_page_size;
+            g_array_remove_index(s->buffer_map, i);
+            changed = true;
+        } else {
+            i++;
+        }
+    }
+    while (s->buffers->len &&
+           g_array_index(s->buffers, struct iovec,
+                         s->buffers->len - 1).iov_base == s->hole) {
+        g_array_set_size(s->buffers, s->buffers->len - 1);
+    }
+    if (changed) {
+        luring_update_buffers(s);
+    }
+    luring_buffers_unlock(s);
+}
+
+static void luring_ram_block_resized(RAMBlockNotifier *n, void *host,
+                                     size_t old_size, size_t new_size)
+{
+    LuringState *s = container_of(n, LuringState, ram_notifier);
+
+    if (!luring_want_ram_block(host)) {
+        return;
+    }
+    luring_ram_block_removed(n, host, old_size, old_size);
+    luring_ram_block_added(n, host, new_size, new_size);
+}
+
+LuringState *luring_init(unsigned int flags, Error **errp)
 {
     int rc;
     LuringState *s = g_new0(LuringState, 1);
     struct io_uring *ring = &s->ring;
+    struct io_uring_params params = {};
+    int i;
 
     trace_luring_init_state(s, sizeof(*s));
 
-    rc = io_uring_queue_init(MAX_ENTRIES, ring, 0);
+    if (flags & LURING_IOPOLL) {
+        params.flags |= IORING_SETUP_IOPOLL;
+    }
+    if (flags & LURING_SQPOLL) {
+        /* kernels before 5.11 only poll registered files */
+        flags |= LURING_FIXED_FILES;
+        params.flags |= IORING_SETUP_SQPOLL;
+        params.sq_thread_idle = SQPOLL_IDLE_MS;
+    }
+
+    rc = io_uring_queue_init_params(MAX_ENTRIES, ring, &params);
     if (rc < 0) {
-        error_setg_errno(errp, errno, "failed to init linux io_uring ring");
+        error_setg_errno(errp, -rc, "failed to init linux io_uring ring");
         g_free(s);
         return NULL;
     }
 
+    for (i = 0; i < MAX_FIXED_FILES; i++) {
+        s->files[i] = -1;
+    }
+    if ((flags & LURING_FIXED_FILES) &&
+        io_uring_register_files(ring, s->files, MAX_FIXED_FILES) < 0) {
+        /* sparse file tables need Linux 5.5 */
+        flags &= ~LURING_FIXED_FILES;
+    }
+
+    s->flags = flags;
+    if (flags & LURING_FIXED_BUFFERS) {
+        s->buffers = g_array_new(false, false, sizeof(struct iovec));
+        s->buffer_map = g_array_new(false, false, sizeof(guint));
+        s->hole = qemu_memalign(qemu_real_host_page_size,
+                                qemu_real_host_page_size);
+        s->ram_notifier.ram_block_added = luring_ram_block_added;
+        s->ram_notifier.ram_block_removed = luring_ram_block_removed;
+        s->ram_notifier.ram_block_resized = luring_ram_block_resized;
+        ram_block_notifier_add(&s->ram_notifier);
+    }
+
     ioq_init(&s->io_q);
     return s;
 
@@ -441,6 +880,12 @@ LuringState *luring_init(Error **errp)
 
 void luring_cleanup(LuringState *s)
 {
+    if (s->buffers) {
+        ram_block_notifier_remove(&s->ram_notifier);
+        g_array_free(s->buffers, true);
+        g_array_free(s->buffer_map, true);
+        qemu_vfree(s->hole);
+    }
     io_uring_queue_exit(&s->ring);
     trace_luring_cleanup_state(s);
     g_free(s);
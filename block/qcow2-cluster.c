@@ -215,6 +215,20 @@ static int l2_load(BlockDriverState *bs, uint64_t offset,
                            (void **)l2_slice);
 }
 
+/*
+ * Returns the L2 slice containing the entry for @offset if it is cached,
+ * or NULL. Does no I/O.
+ */
+static uint64_t *l2_lookup(BlockDriverState *bs, uint64_t offset,
+                           uint64_t l2_offset)
+{
+    BDRVQcow2State *s = bs->opaque;
+    int start_of_slice = l2_entry_size(s) *
+        (offset_to_l2_index(s, offset) - offset_to_l2_slice_index(s, offset));
+
+    return qcow2_cache_lookup(s->l2_table_cache, l2_offset + start_of_slice);
+}
+
 /*
  * Writes an L1 entry to disk (note that depending on the alignment
  * requirements this function may write more that just one entry in
@@ -580,10 +594,15 @@ static int coroutine_fn do_perform_cow_write(BlockDriverState *bs,
  * Compressed clusters are always processed one by one.
  *
  * Returns 0 on success, -errno in error cases.
+ *
+ * With @cached_only the lookup never yields: it fails with -EAGAIN if the
+ * L2 slice is not cached or if the image looks corrupt, leaving both to a
+ * lookup under s->lock.
  */
-int qcow2_get_host_offset(BlockDriverState *bs, uint64_t offset,
-                          unsigned int *bytes, uint64_t *host_offset,
-                          QCow2SubclusterType *subcluster_type)
+static int get_host_offset(BlockDriverState *bs, uint64_t offset,
+                           unsigned int *bytes, uint64_t *host_offset,
+                           QCow2SubclusterType *subcluster_type,
+                           bool cached_only)
 {
     BDRVQcow2State *s = bs->opaque;
     unsigned int l2_index, sc_index;
@@ -625,6 +644,9 @@ int qcow2_get_host_offset(BlockDriverState *bs, uint64_t offset,
     }
 
     if (offset_into_cluster(s, l2_offset)) {
+        if (cached_only) {
+            return -EAGAIN;
+        }
         qcow2_signal_corruption(bs, true, -1, -1, "L2 table offset %#" PRIx64
                                 " unaligned (L1 index: %#" PRIx64 ")",
                                 l2_offset, l1_index);
@@ -633,9 +655,16 @@ int qcow2_get_host_offset(BlockDriverState *bs, uint64_t offset,
 
     /* load the l2 slice in memory */
 
-    ret = l2_load(bs, offset, l2_offset, &l2_slice);
-    if (ret < 0) {
-        return ret;
+    if (cached_only) {
+        l2_slice = l2_lookup(bs, offset, l2_offset);
+        if (!l2_slice) {
+            return -EAGAIN;
+        }
+    } else {
+        ret = l2_load(bs, offset, l2_offset, &l2_slice);
+        if (ret < 0) {
+            return ret;
+        }
     }
 
     /* find the cluster offset for the given disk offset */
@@ -654,6 +683,10 @@ int qcow2_get_host_offset(BlockDriverState *bs, uint64_t offset,
     type = qcow2_get_subcluster_type(bs, l2_entry, l2_bitmap, sc_index);
     if (s->qcow_version < 3 && (type == QCOW2_SUBCLUSTER_ZERO_PLAIN ||
                                 type == QCOW2_SUBCLUSTER_ZERO_ALLOC)) {
+        if (cached_only) {
+            ret = -EAGAIN;
+            goto fail;
+        }
         qcow2_signal_corruption(bs, true, -1, -1, "Zero cluster entry found"
                                 " in pre-v3 image (L2 offset: %#" PRIx64
                                 ", L2 index: %#x)", l2_offset, l2_index);
@@ -665,6 +698,10 @@ int qcow2_get_host_offset(BlockDriverState *bs, uint64_t offset,
         break; /* This is handled by count_contiguous_subclusters() below */
     case QCOW2_SUBCLUSTER_COMPRESSED:
         if (has_data_file(bs)) {
+            if (cached_only) {
+                ret = -EAGAIN;
+                goto fail;
+            }
             qcow2_signal_corruption(bs, true, -1, -1, "Compressed cluster "
                                     "entry found in image with external data "
                                     "file (L2 offset: %#" PRIx64 ", L2 index: "
@@ -683,6 +720,10 @@ int qcow2_get_host_offset(BlockDriverState *bs, uint64_t offset,
         uint64_t host_cluster_offset = l2_entry & L2E_OFFSET_MASK;
         *host_offset = host_cluster_offset + offset_in_cluster;
         if (offset_into_cluster(s, host_cluster_offset)) {
+            if (cached_only) {
+                ret = -EAGAIN;
+                goto fail;
+            }
             qcow2_signal_corruption(bs, true, -1, -1,
                                     "Cluster allocation offset %#"
                                     PRIx64 " unaligned (L2 offset: %#" PRIx64
@@ -692,6 +733,10 @@ int qcow2_get_host_offset(BlockDriverState *bs, uint64_t offset,
             goto fail;
         }
         if (has_data_file(bs) && *host_offset != offset) {
+            if (cached_only) {
+                ret = -EAGAIN;
+                goto fail;
+            }
             qcow2_signal_corruption(bs, true, -1, -1,
                                     "External data file host cluster offset %#"
                                     PRIx64 " does not match guest cluster "
@@ -710,6 +755,10 @@ int qcow2_get_host_offset(BlockDriverState *bs, uint64_t offset,
     sc = count_contiguous_subclusters(bs, nb_clusters, sc_index,
                                       l2_slice, &l2_index);
     if (sc < 0) {
+        if (cached_only) {
+            ret = -EAGAIN;
+            goto fail;
+        }
         qcow2_signal_corruption(bs, true, -1, -1, "Invalid cluster entry found "
                                 " (L2 offset: %#" PRIx64 ", L2 index: %#x)",
                                 l2_offset, l2_index);
@@ -740,6 +789,28 @@ fail:
     return ret;
 }
 
+int qcow2_get_host_offset(BlockDriverState *bs, uint64_t offset,
+                          unsigned int *bytes, uint64_t *host_offset,
+                          QCow2SubclusterType *subcluster_type)
+{
+    return get_host_offset(bs, offset, bytes, host_offset, subcluster_type,
+                           false);
+}
+
+/*
+ * Like qcow2_get_host_offset(), but only succeeds if the L2 slice is
+ * already cached, and returns -EAGAIN otherwise. It does not yield, so
+ * it can be called without s->lock: whoever holds the lock never leaves
+ * an L1 or L2 entry half-updated across a yield.
+ */
+int qcow2_get_host_offset_cached(BlockDriverState *bs, uint64_t offset,
+                                 unsigned int *bytes, uint64_t *host_offset,
+                                 QCow2SubclusterType *subcluster_type)
+{
+    return get_host_offset(bs, offset, bytes, host_offset, subcluster_type,
+                           true);
+}
+
 /*
  * get_cluster_table
  *
@@ -1613,14 +1684,18 @@ static int do_alloc_cluster_offset(BlockDriverState *bs, uint64_t guest_offset,
     trace_qcow2_cluster_alloc_phys(qemu_coroutine_self());
     if (*host_offset == INV_OFFSET) {
         int64_t cluster_offset =
-            qcow2_alloc_clusters(bs, *nb_clusters * s->cluster_size);
+            qcow2_alloc_reserved_clusters(bs, guest_offset, nb_clusters);
         if (cluster_offset < 0) {
             return cluster_offset;
         }
         *host_offset = cluster_offset;
         return 0;
     } else {
-        int64_t ret = qcow2_alloc_clusters_at(bs, *host_offset, *nb_clusters);
+        int64_t ret = qcow2_alloc_reserved_clusters_at(bs, *host_offset,
+                                                       *nb_clusters);
+        if (ret == 0) {
+            ret = qcow2_alloc_clusters_at(bs, *host_offset, *nb_clusters);
+        }
         if (ret < 0) {
             return ret;
         }
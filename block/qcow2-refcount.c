@@ -1063,6 +1063,113 @@ int64_t qcow2_alloc_clusters_at(BlockDriverState *bs, uint64_t offset,
     return i;
 }
 
+/*
+ * Allocation streams
+ *
+ * Allocating writes take their clusters from a run reserved by their
+ * stream, instead of each one searching for free clusters and updating
+ * refcounts on its own: the refcount update for a whole run is done at
+ * once when it is reserved. Streams are picked by guest offset, so that
+ * sequential writers to different parts of the disk each get contiguous
+ * host clusters. Runs are only reserved ahead while allocating writes
+ * overlap, so a lone writer lays out clusters exactly as before.
+ *
+ * Reserved clusters already have a refcount of 1. What is left of the
+ * runs is freed by qcow2_release_reserved_clusters(), or leaks if QEMU
+ * exits without closing the image.
+ */
+static uint64_t take_reserved_clusters(BDRVQcow2State *s,
+                                       Qcow2AllocStream *stream,
+                                       uint64_t *nb_clusters)
+{
+    uint64_t offset = stream->offset;
+
+    *nb_clusters = MIN(*nb_clusters, stream->nb_clusters);
+    stream->offset += *nb_clusters << s->cluster_bits;
+    stream->nb_clusters -= *nb_clusters;
+    return offset;
+}
+
+/*
+ * Allocate up to *nb_clusters contiguous clusters for a write to
+ * @guest_offset, reserving a new run for its stream if needed. On
+ * success, returns the offset of the clusters and sets *nb_clusters to
+ * how many there are.
+ */
+int64_t qcow2_alloc_reserved_clusters(BlockDriverState *bs,
+                                      uint64_t guest_offset,
+                                      uint64_t *nb_clusters)
+{
+    BDRVQcow2State *s = bs->opaque;
+    int index = (guest_offset / QCOW2_ALLOC_STREAM_REGION) %
+                QCOW2_ALLOC_STREAMS;
+    Qcow2AllocStream *stream = &s->alloc_streams[index];
+
+    if (stream->nb_clusters == 0) {
+        uint64_t n = *nb_clusters;
+        int64_t offset;
+
+        if (!QLIST_EMPTY(&s->cluster_allocs)) {
+            n = MAX(n, QCOW2_ALLOC_STREAM_RESERVE >> s->cluster_bits);
+        }
+        offset = qcow2_alloc_clusters(bs, n << s->cluster_bits);
+        if (offset < 0) {
+            return offset;
+        }
+        if (n > *nb_clusters) {
+            trace_qcow2_alloc_stream_reserve(bs, index, offset, n);
+        }
+        stream->offset = offset;
+        stream->nb_clusters = n;
+    }
+
+    return take_reserved_clusters(s, stream, nb_clusters);
+}
+
+/*
+ * Allocate up to @nb_clusters clusters at @offset if a stream reserved
+ * them. Returns how many were allocated, which is 0 if @offset is not
+ * where a reserved run starts.
+ */
+uint64_t qcow2_alloc_reserved_clusters_at(BlockDriverState *bs,
+                                          uint64_t offset,
+                                          uint64_t nb_clusters)
+{
+    BDRVQcow2State *s = bs->opaque;
+    int i;
+
+    for (i = 0; i < QCOW2_ALLOC_STREAMS; i++) {
+        Qcow2AllocStream *stream = &s->alloc_streams[i];
+
+        if (stream->nb_clusters && stream->offset == offset) {
+            take_reserved_clusters(s, stream, &nb_clusters);
+            return nb_clusters;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Free the clusters that are reserved but not used yet. Must be called
+ * before anything that expects refcounts to match the clusters in use.
+ */
+void qcow2_release_reserved_clusters(BlockDriverState *bs)
+{
+    BDRVQcow2State *s = bs->opaque;
+    int i;
+
+    for (i = 0; i < QCOW2_ALLOC_STREAMS; i++) {
+        Qcow2AllocStream *stream = &s->alloc_streams[i];
+
+        if (stream->nb_clusters) {
+            qcow2_free_clusters(bs, stream->offset,
+                                stream->nb_clusters << s->cluster_bits,
+                                QCOW2_DISCARD_NEVER);
+            stream->nb_clusters = 0;
+        }
+    }
+}
+
 /* only used to allocate compressed sectors. We try to allocate
    contiguous sectors. size must be <= cluster_size */
 int64_t qcow2_alloc_bytes(BlockDriverState *bs, int size)
@@ -648,6 +648,7 @@ static int coroutine_fn qcow2_co_check(BlockDriverState *bs,
     int ret;
 
     qemu_co_mutex_lock(&s->lock);
+    qcow2_release_reserved_clusters(bs);
     ret = qcow2_co_check_locked(bs, result, fix);
     qemu_co_mutex_unlock(&s->lock);
     return ret;
@@ -1946,6 +1947,7 @@ static int qcow2_reopen_prepare(BDRVReopenState *state,
             goto fail;
         }
 
+        qcow2_release_reserved_clusters(state->bs);
         ret = bdrv_flush(state->bs);
         if (ret < 0) {
             goto fail;
@@ -2330,10 +2332,18 @@ static coroutine_fn int qcow2_co_preadv_part(BlockDriverState *bs,
                             QCOW_MAX_CRYPT_CLUSTERS * s->cluster_size);
         }
 
-        qemu_co_mutex_lock(&s->lock);
-        ret = qcow2_get_host_offset(bs, offset, &cur_bytes,
-                                    &host_offset, &type);
-        qemu_co_mutex_unlock(&s->lock);
+        /*
+         * Mappings whose L2 slice is cached can be looked up without
+         * waiting for s->lock, which may be held across metadata I/O.
+         */
+        ret = qcow2_get_host_offset_cached(bs, offset, &cur_bytes,
+                                           &host_offset, &type);
+        if (ret == -EAGAIN) {
+            qemu_co_mutex_lock(&s->lock);
+            ret = qcow2_get_host_offset(bs, offset, &cur_bytes,
+                                        &host_offset, &type);
+            qemu_co_mutex_unlock(&s->lock);
+        }
         if (ret < 0) {
             goto out;
         }
@@ -2692,6 +2702,8 @@ static int qcow2_inactivate(BlockDriverState *bs)
                           bdrv_get_device_or_node_name(bs));
     }
 
+    qcow2_release_reserved_clusters(bs);
+
     ret = qcow2_cache_flush(bs, s->l2_table_cache);
     if (ret) {
         result = ret;
@@ -4201,6 +4213,9 @@ static int coroutine_fn qcow2_co_truncate(BlockDriverState *bs, int64_t offset,
 
     qemu_co_mutex_lock(&s->lock);
 
+    /* Shrinking and preallocation must not find reserved clusters in use */
+    qcow2_release_reserved_clusters(bs);
+
     /*
      * Even though we store snapshot size for all images, it was not
      * required until v3, so it is not safe to proceed for v2.
@@ -4893,6 +4908,8 @@ static int qcow2_make_empty(BlockDriverState *bs)
     int step = QEMU_ALIGN_DOWN(INT_MAX, s->cluster_size);
     int l1_clusters, ret = 0;
 
+    qcow2_release_reserved_clusters(bs);
+
     l1_clusters = DIV_ROUND_UP(s->l1_size, s->cluster_size / L1E_SIZE);
 
     if (s->qcow_version >= 3 && !s->snapshots && !s->nb_bitmaps &&
@@ -5201,6 +5218,22 @@ static ImageInfoSpecific *qcow2_get_specific_info(BlockDriverState *bs,
     return spec_info;
 }
 
+static BlockStatsSpecific *qcow2_get_specific_stats(BlockDriverState *bs)
+{
+    BDRVQcow2State *s = bs->opaque;
+    BlockStatsSpecific *stats = g_new(BlockStatsSpecific, 1);
+    BlockStatsSpecificQcow2 *qcow2 = &stats->u.qcow2;
+
+    stats->driver = BLOCKDEV_DRIVER_QCOW2;
+    qcow2_cache_get_stats(s->l2_table_cache, &qcow2->l2_cache_hits,
+                          &qcow2->l2_cache_misses);
+    qcow2_cache_get_stats(s->refcount_block_cache,
+                          &qcow2->refcount_cache_hits,
+                          &qcow2->refcount_cache_misses);
+
+    return stats;
+}
+
 static int qcow2_has_zero_init(BlockDriverState *bs)
 {
     BDRVQcow2State *s = bs->opaque;
@@ -5994,6 +6027,7 @@ BlockDriver bdrv_qcow2 = {
     .bdrv_measure           = qcow2_measure,
     .bdrv_get_info          = qcow2_get_info,
     .bdrv_get_specific_info = qcow2_get_specific_info,
+    .bdrv_get_specific_stats = qcow2_get_specific_stats,
 
     .bdrv_save_vmstate    = qcow2_save_vmstate,
     .bdrv_load_vmstate    = qcow2_load_vmstate,
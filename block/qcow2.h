@@ -71,6 +71,14 @@
 /* Maximum of parallel sub-request per guest request */
 #define QCOW2_MAX_WORKERS 8
 
+/*
+ * Allocation streams: number of streams, how much each reserves at once,
+ * and the size of the guest regions that are spread across them
+ */
+#define QCOW2_ALLOC_STREAMS 4
+#define QCOW2_ALLOC_STREAM_RESERVE (4 * MiB)
+#define QCOW2_ALLOC_STREAM_REGION (1 * GiB)
+
 /* indicate that the refcount of the referenced cluster is exactly one. */
 #define QCOW_OFLAG_COPIED     (1ULL << 63)
 /* indicate that the cluster is compressed (they never have the copied flag) */
@@ -323,6 +331,12 @@ typedef struct Qcow2BitmapHeaderExt {
 
 #define QCOW2_MAX_THREADS 4
 
+/* Clusters reserved by an allocation stream and not handed out yet */
+typedef struct Qcow2AllocStream {
+    uint64_t offset;
+    uint64_t nb_clusters;
+} Qcow2AllocStream;
+
 typedef struct BDRVQcow2State {
     int cluster_bits;
     int cluster_size;
@@ -355,6 +369,7 @@ typedef struct BDRVQcow2State {
     uint32_t max_refcount_table_index; /* Last used entry in refcount_table */
     uint64_t free_cluster_index;
     uint64_t free_byte_offset;
+    Qcow2AllocStream alloc_streams[QCOW2_ALLOC_STREAMS];
 
     CoMutex lock;
 
@@ -865,6 +880,13 @@ int64_t qcow2_alloc_clusters(BlockDriverState *bs, uint64_t size);
 int64_t qcow2_alloc_clusters_at(BlockDriverState *bs, uint64_t offset,
                                 int64_t nb_clusters);
 int64_t qcow2_alloc_bytes(BlockDriverState *bs, int size);
+int64_t qcow2_alloc_reserved_clusters(BlockDriverState *bs,
+                                      uint64_t guest_offset,
+                                      uint64_t *nb_clusters);
+uint64_t qcow2_alloc_reserved_clusters_at(BlockDriverState *bs,
+                                          uint64_t offset,
+                                          uint64_t nb_clusters);
+void qcow2_release_reserved_clusters(BlockDriverState *bs);
 void qcow2_free_clusters(BlockDriverState *bs,
                           int64_t offset, int64_t size,
                           enum qcow2_discard_type type);
@@ -908,6 +930,9 @@ int qcow2_encrypt_sectors(BDRVQcow2State *s, int64_t sector_num,
 int qcow2_get_host_offset(BlockDriverState *bs, uint64_t offset,
                           unsigned int *bytes, uint64_t *host_offset,
                           QCow2SubclusterType *subcluster_type);
+int qcow2_get_host_offset_cached(BlockDriverState *bs, uint64_t offset,
+                                 unsigned int *bytes, uint64_t *host_offset,
+                                 QCow2SubclusterType *subcluster_type);
 int qcow2_alloc_host_offset(BlockDriverState *bs, uint64_t offset,
                             unsigned int *bytes, uint64_t *host_offset,
                             QCowL2Meta **m);
@@ -976,6 +1001,8 @@ int qcow2_cache_get_empty(BlockDriverState *bs, Qcow2Cache *c, uint64_t offset,
 void qcow2_cache_put(Qcow2Cache *c, void **table);
 void *qcow2_cache_is_table_offset(Qcow2Cache *c, uint64_t offset);
 void qcow2_cache_discard(Qcow2Cache *c, void *table);
+void *qcow2_cache_lookup(Qcow2Cache *c, uint64_t offset);
+void qcow2_cache_get_stats(Qcow2Cache *c, uint64_t *hits, uint64_t *misses);
 
 /* qcow2-bitmap.c functions */
 int qcow2_check_bitmaps_refcounts(BlockDriverState *bs, BdrvCheckResult *res,
@@ -3777,7 +3777,8 @@ QemuOptsList qemu_common_drive_opts = {
         },{
             .name = "aio",
             .type = QEMU_OPT_STRING,
-            .help = "host AIO implementation (threads, native, io_uring)",
+            .help = "host AIO implementation "
+                    "(threads, native, io_uring, io_uring-poll)",
         },{
             .name = BDRV_OPT_CACHE_WB,
             .type = QEMU_OPT_BOOL,
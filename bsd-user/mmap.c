@@ -31,6 +31,16 @@ void mmap_lock(void)
     }
 }
 
+/* Like mmap_lock, but fail instead of waiting for another thread */
+bool mmap_trylock(void)
+{
+    if (mmap_lock_count == 0 && pthread_mutex_trylock(&mmap_mutex) != 0) {
+        return false;
+    }
+    mmap_lock_count++;
+    return true;
+}
+
 void mmap_unlock(void)
 {
     if (--mmap_lock_count == 0) {
@@ -1,5 +1,6 @@
 TARGET_ARCH=riscv64
 TARGET_BASE_ARCH=riscv
+TARGET_SUPPORTS_SUPERBLOCKS=y
 TARGET_SUPPORTS_MTTCG=y
 TARGET_XML_FILES= gdb-xml/riscv-64bit-cpu.xml gdb-xml/riscv-32bit-fpu.xml gdb-xml/riscv-64bit-fpu.xml gdb-xml/riscv-64bit-virtual.xml
 TARGET_NEED_FDT=y
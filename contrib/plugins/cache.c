@@ -20,7 +20,6 @@ static enum qemu_plugin_mem_rw rw = QEMU_PLUGIN_MEM_RW;
 static GHashTable *miss_ht;
 
 static GMutex hashtable_lock;
-static GRand *rng;
 
 static int limit;
 static bool sys;
@@ -29,6 +28,8 @@ enum EvictionPolicy {
     LRU,
     FIFO,
     RAND,
+    PLRU,
+    SRRIP,
 };
 
 enum EvictionPolicy policy;
@@ -58,6 +59,8 @@ enum EvictionPolicy policy;
 
 typedef struct {
     uint64_t tag;
+    /* coherence generation of the line when it was filled */
+    uint32_t gen;
     bool valid;
 } CacheBlock;
 
@@ -66,6 +69,8 @@ typedef struct {
     uint64_t *lru_priorities;
     uint64_t lru_gen_counter;
     GQueue *fifo_queue;
+    uint64_t plru_bits;
+    uint8_t *rrpv;
 } CacheSet;
 
 typedef struct {
@@ -78,6 +83,14 @@ typedef struct {
     uint64_t tag_mask;
     uint64_t accesses;
     uint64_t misses;
+    /* hits on lines another core had invalidated, counted as misses */
+    uint64_t coherence_misses;
+    /*
+     * GRand is not thread-safe: set i uses rng[i % num_rngs], so that
+     * sets under different locks never share one
+     */
+    GRand **rng;
+    int num_rngs;
 } Cache;
 
 typedef struct {
@@ -87,8 +100,46 @@ typedef struct {
     uint64_t l1_dmisses;
     uint64_t l1_imisses;
     uint64_t l2_misses;
+    uint64_t l3_misses;
 } InsnData;
 
+/*
+ * Accesses are not simulated when they happen. Each vCPU queues them in
+ * its own scoreboard entry, without any locking, and simulates a whole
+ * batch at once while holding the lock of the core it maps to. With one
+ * vCPU per core that lock is never contended.
+ */
+enum AccessType {
+    ACCESS_IFETCH,
+    ACCESS_LOAD,
+    ACCESS_STORE,
+};
+
+typedef struct {
+    uint64_t addr;
+    InsnData *insn;
+    enum AccessType type;
+} Access;
+
+typedef struct {
+    Access *accesses;
+    int n;
+} AccessQueue;
+
+static struct qemu_plugin_scoreboard *queues;
+static int batch_size;
+/* highest vCPU index that has queued accesses, protected by queues_lock */
+static int max_vcpu_index = -1;
+static GMutex queues_lock;
+
+typedef struct {
+    GMutex lock;
+    uint64_t l3_accesses;
+    uint64_t l3_misses;
+    /* stores that invalidated the line in other cores */
+    uint64_t invalidations;
+} CoreData;
+
 void (*update_hit)(Cache *cache, int set, int blk);
 void (*update_miss)(Cache *cache, int set, int blk);
 
@@ -101,9 +152,13 @@ static Cache **l1_dcaches, **l1_icaches;
 static bool use_l2;
 static Cache **l2_ucaches;
 
-static GMutex *l1_dcache_locks;
-static GMutex *l1_icache_locks;
-static GMutex *l2_ucache_locks;
+/* the L3 is shared by all cores, its sets are protected by striped locks */
+#define L3_LOCKS 64
+static bool use_l3;
+static Cache *l3_ucache;
+static GMutex l3_locks[L3_LOCKS];
+
+static CoreData *core_data;
 
 static uint64_t l1_dmem_accesses;
 static uint64_t l1_imem_accesses;
@@ -113,6 +168,29 @@ static uint64_t l1_dmisses;
 static uint64_t l2_mem_accesses;
 static uint64_t l2_misses;
 
+static uint64_t l3_mem_accesses;
+static uint64_t l3_misses;
+
+static uint64_t invalidations;
+static uint64_t coherence_misses;
+
+/*
+ * MESI-style coherence approximation between the private data caches.
+ *
+ * A directory, indexed by a hash of the line address, holds for each
+ * line the mask of cores that may have it and a generation number. A
+ * store from a core that does not own the line alone makes it the only
+ * sharer and bumps the generation, which invalidates every other copy:
+ * cached blocks remember the generation they were filled with, and a
+ * hit on a block of an older generation is a coherence miss. Lines that
+ * hash to the same directory entry are treated as one, so a bigger
+ * directory means less false sharing.
+ */
+static bool coherence;
+static uint64_t *directory;
+static uint64_t dir_mask;
+static int dir_shift;
+
 static int pow_of_two(int num)
 {
     g_assert((num & (num - 1)) == 0);
@@ -220,6 +298,90 @@ static void fifo_destroy(Cache *cache)
     }
 }
 
+/*
+ * Bit pseudo-LRU eviction policy: each set keeps one MRU bit per block.
+ *
+ * On each access the block's bit is set. When that would set all of them,
+ * the other bits are cleared instead.
+ *
+ * On a miss, the first block whose bit is clear is replaced.
+ */
+
+static void plru_update_blk(Cache *cache, int set_idx, int blk_idx)
+{
+    CacheSet *set = &cache->sets[set_idx];
+    uint64_t all = cache->assoc == 64 ? UINT64_MAX :
+                   (1ULL << cache->assoc) - 1;
+
+    set->plru_bits |= 1ULL << blk_idx;
+    if (set->plru_bits == all) {
+        set->plru_bits = 1ULL << blk_idx;
+    }
+}
+
+static int plru_get_block(Cache *cache, int set_idx)
+{
+    return __builtin_ctzll(~cache->sets[set_idx].plru_bits);
+}
+
+/*
+ * SRRIP eviction policy: each block has a 2-bit re-reference prediction
+ * value (RRPV), 0 meaning it is expected to be reused soon.
+ *
+ * On a hit: the block's RRPV is reset to 0.
+ *
+ * On a miss: a block with the maximum RRPV is replaced, ageing all blocks
+ * until there is one. The new block gets a long re-reference prediction
+ * (RRPV_MAX - 1), so that blocks only used once leave the cache first.
+ */
+
+#define RRPV_MAX 3
+
+static void srrip_init(Cache *cache)
+{
+    int i;
+
+    for (i = 0; i < cache->num_sets; i++) {
+        cache->sets[i].rrpv = g_new0(uint8_t, cache->assoc);
+    }
+}
+
+static void srrip_update_on_hit(Cache *cache, int set, int blk_idx)
+{
+    cache->sets[set].rrpv[blk_idx] = 0;
+}
+
+static void srrip_update_on_miss(Cache *cache, int set, int blk_idx)
+{
+    cache->sets[set].rrpv[blk_idx] = RRPV_MAX - 1;
+}
+
+static int srrip_get_block(Cache *cache, int set)
+{
+    uint8_t *rrpv = cache->sets[set].rrpv;
+    int i;
+
+    for (;;) {
+        for (i = 0; i < cache->assoc; i++) {
+            if (rrpv[i] == RRPV_MAX) {
+                return i;
+            }
+        }
+        for (i = 0; i < cache->assoc; i++) {
+            rrpv[i]++;
+        }
+    }
+}
+
+static void srrip_destroy(Cache *cache)
+{
+    int i;
+
+    for (i = 0; i < cache->num_sets; i++) {
+        g_free(cache->sets[i].rrpv);
+    }
+}
+
 static inline uint64_t extract_tag(Cache *cache, uint64_t addr)
 {
     return addr & cache->tag_mask;
@@ -236,6 +398,8 @@ static const char *cache_config_error(int blksize, int assoc, int cachesize)
         return "cache size must be divisible by block size";
     } else if (cachesize % (blksize * assoc) != 0) {
         return "cache size must be divisible by set size (assoc * block size)";
+    } else if (policy == PLRU && assoc > 64) {
+        return "plru eviction supports an associativity of at most 64";
     } else {
         return NULL;
     }
@@ -243,10 +407,11 @@ static const char *cache_config_error(int blksize, int assoc, int cachesize)
 
 static bool bad_cache_params(int blksize, int assoc, int cachesize)
 {
-    return (cachesize % blksize) != 0 || (cachesize % (blksize * assoc) != 0);
+    return (cachesize % blksize) != 0 || (cachesize % (blksize * assoc) != 0) ||
+           (policy == PLRU && assoc > 64);
 }
 
-static Cache *cache_init(int blksize, int assoc, int cachesize)
+static Cache *cache_init(int blksize, int assoc, int cachesize, int num_rngs)
 {
     Cache *cache;
     int i;
@@ -266,9 +431,16 @@ static Cache *cache_init(int blksize, int assoc, int cachesize)
     cache->blksize_shift = pow_of_two(blksize);
     cache->accesses = 0;
     cache->misses = 0;
+    cache->coherence_misses = 0;
+    cache->num_rngs = policy == RAND ? num_rngs : 0;
+    cache->rng = g_new(GRand *, cache->num_rngs);
+    for (i = 0; i < cache->num_rngs; i++) {
+        cache->rng[i] = g_rand_new();
+    }
 
     for (i = 0; i < cache->num_sets; i++) {
         cache->sets[i].blocks = g_new0(CacheBlock, assoc);
+        cache->sets[i].plru_bits = 0;
     }
 
     blk_mask = blksize - 1;
@@ -294,7 +466,7 @@ static Cache **caches_init(int blksize, int assoc, int cachesize)
     caches = g_new(Cache *, cores);
 
     for (i = 0; i < cores; i++) {
-        caches[i] = cache_init(blksize, assoc, cachesize);
+        caches[i] = cache_init(blksize, assoc, cachesize, 1);
     }
 
     return caches;
@@ -317,11 +489,16 @@ static int get_replaced_block(Cache *cache, int set)
 {
     switch (policy) {
     case RAND:
-        return g_rand_int_range(rng, 0, cache->assoc);
+        return g_rand_int_range(cache->rng[set % cache->num_rngs], 0,
+                                cache->assoc);
     case LRU:
         return lru_get_lru_block(cache, set);
     case FIFO:
         return fifo_get_first_block(cache, set);
+    case PLRU:
+        return plru_get_block(cache, set);
+    case SRRIP:
+        return srrip_get_block(cache, set);
     default:
         g_assert_not_reached();
     }
@@ -349,11 +526,13 @@ static int in_cache(Cache *cache, uint64_t addr)
  * access_cache(): Simulate a cache access
  * @cache: The cache under simulation
  * @addr: The address of the requested memory location
+ * @gen: The coherence generation of the line, 0 if not tracked
  *
  * Returns true if the requsted data is hit in the cache and false when missed.
- * The cache is updated on miss for the next access.
+ * The cache is updated on miss for the next access. A hit on a block filled
+ * with an older generation of the line is a coherence miss.
  */
-static bool access_cache(Cache *cache, uint64_t addr)
+static bool access_cache(Cache *cache, uint64_t addr, uint32_t gen)
 {
     int hit_blk, replaced_blk;
     uint64_t tag, set;
@@ -366,6 +545,12 @@ static bool access_cache(Cache *cache, uint64_t addr)
         if (update_hit) {
             update_hit(cache, set, hit_blk);
         }
+        if (cache->sets[set].blocks[hit_blk].gen != gen) {
+            /* refetch the line in place */
+            cache->sets[set].blocks[hit_blk].gen = gen;
+            cache->coherence_misses++;
+            return false;
+        }
         return true;
     }
 
@@ -380,86 +565,204 @@ static bool access_cache(Cache *cache, uint64_t addr)
     }
 
     cache->sets[set].blocks[replaced_blk].tag = tag;
+    cache->sets[set].blocks[replaced_blk].gen = gen;
     cache->sets[set].blocks[replaced_blk].valid = true;
 
     return false;
 }
 
-static void vcpu_mem_access(unsigned int vcpu_index, qemu_plugin_meminfo_t info,
-                            uint64_t vaddr, void *userdata)
+/* Move a block of the line that is at generation @old to generation @new */
+static void cache_update_gen(Cache *cache, uint64_t addr, uint32_t old,
+                             uint32_t new)
 {
-    uint64_t effective_addr;
-    struct qemu_plugin_hwaddr *hwaddr;
-    int cache_idx;
-    InsnData *insn;
-    bool hit_in_l1;
+    int blk = in_cache(cache, addr);
+    CacheBlock *block;
 
-    hwaddr = qemu_plugin_get_hwaddr(info, vaddr);
-    if (hwaddr && qemu_plugin_hwaddr_is_io(hwaddr)) {
-        return;
+    if (blk != -1) {
+        block = &cache->sets[extract_set(cache, addr)].blocks[blk];
+        if (block->gen == old) {
+            block->gen = new;
+        }
     }
+}
 
-    effective_addr = hwaddr ? qemu_plugin_hwaddr_phys_addr(hwaddr) : vaddr;
-    cache_idx = vcpu_index % cores;
+static inline uint64_t *dir_entry(uint64_t addr)
+{
+    return &directory[(addr >> dir_shift) & dir_mask];
+}
+
+/*
+ * Directory entries hold the sharer mask in their low 32 bits and the
+ * generation in the high ones. They are updated with compare-and-swap so
+ * that cores never need each other's locks.
+ */
+static uint32_t dir_share(int core, uint64_t addr)
+{
+    uint64_t *entry = dir_entry(addr);
+    uint64_t old = __atomic_load_n(entry, __ATOMIC_RELAXED);
+    uint64_t new;
+
+    do {
+        if (old & (1ULL << core)) {
+            return old >> 32;
+        }
+        new = old | (1ULL << core);
+    } while (!__atomic_compare_exchange_n(entry, &old, new, true,
+                                          __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+    return new >> 32;
+}
 
-    g_mutex_lock(&l1_dcache_locks[cache_idx]);
-    hit_in_l1 = access_cache(l1_dcaches[cache_idx], effective_addr);
-    if (!hit_in_l1) {
-        insn = (InsnData *) userdata;
-        __atomic_fetch_add(&insn->l1_dmisses, 1, __ATOMIC_SEQ_CST);
-        l1_dcaches[cache_idx]->misses++;
+static uint32_t dir_own(int core, uint64_t addr)
+{
+    uint64_t *entry = dir_entry(addr);
+    uint64_t old = __atomic_load_n(entry, __ATOMIC_RELAXED);
+    uint64_t new;
+    uint32_t old_gen, new_gen;
+
+    do {
+        if ((uint32_t)old == (1U << core)) {
+            /* already exclusive or modified */
+            return old >> 32;
+        }
+        new = (((old >> 32) + 1) << 32) | (1ULL << core);
+    } while (!__atomic_compare_exchange_n(entry, &old, new, true,
+                                          __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+    old_gen = old >> 32;
+    new_gen = new >> 32;
+    if ((uint32_t)old & ~(1U << core)) {
+        core_data[core].invalidations++;
+    }
+    if (old & (1ULL << core)) {
+        /* an upgrade from shared, our own copies stay valid */
+        cache_update_gen(l1_dcaches[core], addr, old_gen, new_gen);
+        if (use_l2) {
+            cache_update_gen(l2_ucaches[core], addr, old_gen, new_gen);
+        }
     }
-    l1_dcaches[cache_idx]->accesses++;
-    g_mutex_unlock(&l1_dcache_locks[cache_idx]);
+    return new_gen;
+}
 
-    if (hit_in_l1 || !use_l2) {
-        /* No need to access L2 */
+static void access_l3(int core, Access *access)
+{
+    GMutex *lock = &l3_locks[extract_set(l3_ucache, access->addr) %
+                             L3_LOCKS];
+    bool hit;
+
+    g_mutex_lock(lock);
+    hit = access_cache(l3_ucache, access->addr, 0);
+    g_mutex_unlock(lock);
+
+    core_data[core].l3_accesses++;
+    if (!hit) {
+        core_data[core].l3_misses++;
+        __atomic_fetch_add(&access->insn->l3_misses, 1, __ATOMIC_RELAXED);
+    }
+}
+
+/* Called with the lock of @core held */
+static void simulate_access(int core, Access *access)
+{
+    InsnData *insn = access->insn;
+    uint32_t gen = 0;
+    Cache *l1;
+    bool hit;
+
+    if (access->type == ACCESS_IFETCH) {
+        l1 = l1_icaches[core];
+    } else {
+        l1 = l1_dcaches[core];
+        if (coherence) {
+            gen = access->type == ACCESS_STORE ?
+                  dir_own(core, access->addr) :
+                  dir_share(core, access->addr);
+        }
+    }
+
+    hit = access_cache(l1, access->addr, gen);
+    l1->accesses++;
+    if (!hit) {
+        l1->misses++;
+        __atomic_fetch_add(access->type == ACCESS_IFETCH ?
+                           &insn->l1_imisses : &insn->l1_dmisses,
+                           1, __ATOMIC_RELAXED);
+    }
+
+    if (hit) {
         return;
     }
 
-    g_mutex_lock(&l2_ucache_locks[cache_idx]);
-    if (!access_cache(l2_ucaches[cache_idx], effective_addr)) {
-        insn = (InsnData *) userdata;
-        __atomic_fetch_add(&insn->l2_misses, 1, __ATOMIC_SEQ_CST);
-        l2_ucaches[cache_idx]->misses++;
+    if (use_l2) {
+        /* instruction lines are not tracked by the directory */
+        hit = access_cache(l2_ucaches[core], access->addr,
+                           access->type == ACCESS_IFETCH ? 0 : gen);
+        l2_ucaches[core]->accesses++;
+        if (hit) {
+            return;
+        }
+        l2_ucaches[core]->misses++;
+        __atomic_fetch_add(&insn->l2_misses, 1, __ATOMIC_RELAXED);
+    }
+
+    if (use_l3) {
+        access_l3(core, access);
     }
-    l2_ucaches[cache_idx]->accesses++;
-    g_mutex_unlock(&l2_ucache_locks[cache_idx]);
 }
 
-static void vcpu_insn_exec(unsigned int vcpu_index, void *userdata)
+static void flush_queue(unsigned int vcpu_index, AccessQueue *q)
 {
-    uint64_t insn_addr;
-    InsnData *insn;
-    int cache_idx;
-    bool hit_in_l1;
+    int core = vcpu_index % cores;
+    int i;
 
-    insn_addr = ((InsnData *) userdata)->addr;
+    g_mutex_lock(&core_data[core].lock);
+    for (i = 0; i < q->n; i++) {
+        simulate_access(core, &q->accesses[i]);
+    }
+    g_mutex_unlock(&core_data[core].lock);
+    q->n = 0;
+}
+
+static void queue_access(unsigned int vcpu_index, uint64_t addr,
+                         InsnData *insn, enum AccessType type)
+{
+    AccessQueue *q = qemu_plugin_scoreboard_find(queues, vcpu_index);
 
-    cache_idx = vcpu_index % cores;
-    g_mutex_lock(&l1_icache_locks[cache_idx]);
-    hit_in_l1 = access_cache(l1_icaches[cache_idx], insn_addr);
-    if (!hit_in_l1) {
-        insn = (InsnData *) userdata;
-        __atomic_fetch_add(&insn->l1_imisses, 1, __ATOMIC_SEQ_CST);
-        l1_icaches[cache_idx]->misses++;
+    if (!q->accesses) {
+        q->accesses = g_new(Access, batch_size);
+        g_mutex_lock(&queues_lock);
+        max_vcpu_index = MAX(max_vcpu_index, (int)vcpu_index);
+        g_mutex_unlock(&queues_lock);
     }
-    l1_icaches[cache_idx]->accesses++;
-    g_mutex_unlock(&l1_icache_locks[cache_idx]);
 
-    if (hit_in_l1 || !use_l2) {
-        /* No need to access L2 */
-        return;
+    q->accesses[q->n++] = (Access) {
+        .addr = addr, .insn = insn, .type = type,
+    };
+    if (q->n == batch_size) {
+        flush_queue(vcpu_index, q);
     }
+}
 
-    g_mutex_lock(&l2_ucache_locks[cache_idx]);
-    if (!access_cache(l2_ucaches[cache_idx], insn_addr)) {
-        insn = (InsnData *) userdata;
-        __atomic_fetch_add(&insn->l2_misses, 1, __ATOMIC_SEQ_CST);
-        l2_ucaches[cache_idx]->misses++;
+static void vcpu_mem_access(unsigned int vcpu_index, qemu_plugin_meminfo_t info,
+                            uint64_t vaddr, void *userdata)
+{
+    uint64_t effective_addr;
+    struct qemu_plugin_hwaddr *hwaddr;
+
+    hwaddr = qemu_plugin_get_hwaddr(info, vaddr);
+    if (hwaddr && qemu_plugin_hwaddr_is_io(hwaddr)) {
+        return;
     }
-    l2_ucaches[cache_idx]->accesses++;
-    g_mutex_unlock(&l2_ucache_locks[cache_idx]);
+
+    effective_addr = hwaddr ? qemu_plugin_hwaddr_phys_addr(hwaddr) : vaddr;
+    queue_access(vcpu_index, effective_addr, userdata,
+                 qemu_plugin_mem_is_store(info) ? ACCESS_STORE : ACCESS_LOAD);
+}
+
+static void vcpu_insn_exec(unsigned int vcpu_index, void *userdata)
+{
+    InsnData *insn = userdata;
+
+    queue_access(vcpu_index, insn->addr, insn, ACCESS_IFETCH);
 }
 
 static void vcpu_tb_trans(qemu_plugin_id_t id, struct qemu_plugin_tb *tb)
@@ -522,6 +825,11 @@ static void cache_free(Cache *cache)
         metadata_destroy(cache);
     }
 
+    for (int i = 0; i < cache->num_rngs; i++) {
+        g_rand_free(cache->rng[i]);
+    }
+    g_free(cache->rng);
+
     g_free(cache->sets);
     g_free(cache);
 }
@@ -538,9 +846,11 @@ static void caches_free(Cache **caches)
 static void append_stats_line(GString *line, uint64_t l1_daccess,
                               uint64_t l1_dmisses, uint64_t l1_iaccess,
                               uint64_t l1_imisses,  uint64_t l2_access,
-                              uint64_t l2_misses)
+                              uint64_t l2_misses, uint64_t l3_access,
+                              uint64_t l3_misses, uint64_t invals,
+                              uint64_t coh_misses)
 {
-    double l1_dmiss_rate, l1_imiss_rate, l2_miss_rate;
+    double l1_dmiss_rate, l1_imiss_rate, l2_miss_rate, l3_miss_rate;
 
     l1_dmiss_rate = ((double) l1_dmisses) / (l1_daccess) * 100.0;
     l1_imiss_rate = ((double) l1_imisses) / (l1_iaccess) * 100.0;
@@ -562,9 +872,28 @@ static void append_stats_line(GString *line, uint64_t l1_daccess,
                                l2_access ? l2_miss_rate : 0.0);
     }
 
+    if (use_l3) {
+        l3_miss_rate =  ((double) l3_misses) / (l3_access) * 100.0;
+        g_string_append_printf(line, "  %-12lu %-11lu %10.4lf%%",
+                               l3_access,
+                               l3_misses,
+                               l3_access ? l3_miss_rate : 0.0);
+    }
+
+    if (coherence) {
+        g_string_append_printf(line, "  %-13lu %-lu", invals, coh_misses);
+    }
+
     g_string_append(line, "\n");
 }
 
+/* coherence misses of a core's private data caches */
+static uint64_t core_coherence_misses(int core)
+{
+    return l1_dcaches[core]->coherence_misses +
+           (use_l2 ? l2_ucaches[core]->coherence_misses : 0);
+}
+
 static void sum_stats(void)
 {
     int i;
@@ -580,6 +909,11 @@ static void sum_stats(void)
             l2_misses += l2_ucaches[i]->misses;
             l2_mem_accesses += l2_ucaches[i]->accesses;
         }
+
+        l3_misses += core_data[i].l3_misses;
+        l3_mem_accesses += core_data[i].l3_accesses;
+        invalidations += core_data[i].invalidations;
+        coherence_misses += core_coherence_misses(i);
     }
 }
 
@@ -607,6 +941,14 @@ static int l2_cmp(gconstpointer a, gconstpointer b)
     return insn_a->l2_misses < insn_b->l2_misses ? 1 : -1;
 }
 
+static int l3_cmp(gconstpointer a, gconstpointer b)
+{
+    InsnData *insn_a = (InsnData *) a;
+    InsnData *insn_b = (InsnData *) b;
+
+    return insn_a->l3_misses < insn_b->l3_misses ? 1 : -1;
+}
+
 static void log_stats(void)
 {
     int i;
@@ -620,6 +962,14 @@ static void log_stats(void)
         g_string_append(rep, ", l2 accesses, l2 misses, l2 miss rate");
     }
 
+    if (use_l3) {
+        g_string_append(rep, ", l3 accesses, l3 misses, l3 miss rate");
+    }
+
+    if (coherence) {
+        g_string_append(rep, ", invalidations, coherence misses");
+    }
+
     g_string_append(rep, "\n");
 
     for (i = 0; i < cores; i++) {
@@ -630,7 +980,9 @@ static void log_stats(void)
         append_stats_line(rep, dcache->accesses, dcache->misses,
                 icache->accesses, icache->misses,
                 l2_cache ? l2_cache->accesses : 0,
-                l2_cache ? l2_cache->misses : 0);
+                l2_cache ? l2_cache->misses : 0,
+                core_data[i].l3_accesses, core_data[i].l3_misses,
+                core_data[i].invalidations, core_coherence_misses(i));
     }
 
     if (cores > 1) {
@@ -638,7 +990,8 @@ static void log_stats(void)
         g_string_append_printf(rep, "%-8s", "sum");
         append_stats_line(rep, l1_dmem_accesses, l1_dmisses,
                 l1_imem_accesses, l1_imisses,
-                l2_cache ? l2_mem_accesses : 0, l2_cache ? l2_misses : 0);
+                l2_cache ? l2_mem_accesses : 0, l2_cache ? l2_misses : 0,
+                l3_mem_accesses, l3_misses, invalidations, coherence_misses);
     }
 
     g_string_append(rep, "\n");
@@ -697,26 +1050,57 @@ static void log_top_insns(void)
     }
 
 finish:
+    if (use_l3) {
+        miss_insns = g_list_sort(miss_insns, l3_cmp);
+        g_string_append_printf(rep, "%s",
+                               "\naddress, L3 misses, instruction\n");
+
+        for (curr = miss_insns, i = 0; curr && i < limit;
+             i++, curr = curr->next) {
+            insn = (InsnData *) curr->data;
+            g_string_append_printf(rep, "0x%" PRIx64, insn->addr);
+            if (insn->symbol) {
+                g_string_append_printf(rep, " (%s)", insn->symbol);
+            }
+            g_string_append_printf(rep, ", %ld, %s\n", insn->l3_misses,
+                                   insn->disas_str);
+        }
+    }
+
     qemu_plugin_outs(rep->str);
     g_list_free(miss_insns);
 }
 
 static void plugin_exit(qemu_plugin_id_t id, void *p)
 {
+    int i;
+
+    /* simulate what is left in the queues, all vCPUs are stopped */
+    for (i = 0; i <= max_vcpu_index; i++) {
+        AccessQueue *q = qemu_plugin_scoreboard_find(queues, i);
+        if (q->accesses) {
+            flush_queue(i, q);
+            g_free(q->accesses);
+            q->accesses = NULL;
+        }
+    }
+
     log_stats();
     log_top_insns();
 
     caches_free(l1_dcaches);
     caches_free(l1_icaches);
 
-    g_free(l1_dcache_locks);
-    g_free(l1_icache_locks);
-
     if (use_l2) {
         caches_free(l2_ucaches);
-        g_free(l2_ucache_locks);
     }
 
+    if (use_l3) {
+        cache_free(l3_ucache);
+    }
+
+    g_free(directory);
+    g_free(core_data);
     g_hash_table_destroy(miss_ht);
 }
 
@@ -735,7 +1119,16 @@ static void policy_init(void)
         metadata_destroy = fifo_destroy;
         break;
     case RAND:
-        rng = g_rand_new();
+        break;
+    case PLRU:
+        update_hit = plru_update_blk;
+        update_miss = plru_update_blk;
+        break;
+    case SRRIP:
+        update_hit = srrip_update_on_hit;
+        update_miss = srrip_update_on_miss;
+        metadata_init = srrip_init;
+        metadata_destroy = srrip_destroy;
         break;
     default:
         g_assert_not_reached();
@@ -750,8 +1143,12 @@ int qemu_plugin_install(qemu_plugin_id_t id, const qemu_info_t *info,
     int l1_iassoc, l1_iblksize, l1_icachesize;
     int l1_dassoc, l1_dblksize, l1_dcachesize;
     int l2_assoc, l2_blksize, l2_cachesize;
+    int l3_assoc, l3_blksize, l3_cachesize;
+    int coherence_opt = -1;
+    uint64_t dir_size = 1 << 20;
 
     limit = 32;
+    batch_size = 64;
     sys = info->system_emulation;
 
     l1_dassoc = 8;
@@ -766,6 +1163,10 @@ int qemu_plugin_install(qemu_plugin_id_t id, const qemu_info_t *info,
     l2_blksize = 64;
     l2_cachesize = l2_assoc * l2_blksize * 2048;
 
+    l3_assoc = 16;
+    l3_blksize = 64;
+    l3_cachesize = l3_assoc * l3_blksize * 8192;
+
     policy = LRU;
 
     cores = sys ? qemu_plugin_n_vcpus() : 1;
@@ -804,6 +1205,31 @@ int qemu_plugin_install(qemu_plugin_id_t id, const qemu_info_t *info,
                 fprintf(stderr, "boolean argument parsing failed: %s\n", opt);
                 return -1;
             }
+        } else if (g_strcmp0(tokens[0], "l3cachesize") == 0) {
+            use_l3 = true;
+            l3_cachesize = STRTOLL(tokens[1]);
+        } else if (g_strcmp0(tokens[0], "l3blksize") == 0) {
+            use_l3 = true;
+            l3_blksize = STRTOLL(tokens[1]);
+        } else if (g_strcmp0(tokens[0], "l3assoc") == 0) {
+            use_l3 = true;
+            l3_assoc = STRTOLL(tokens[1]);
+        } else if (g_strcmp0(tokens[0], "l3") == 0) {
+            if (!qemu_plugin_bool_parse(tokens[0], tokens[1], &use_l3)) {
+                fprintf(stderr, "boolean argument parsing failed: %s\n", opt);
+                return -1;
+            }
+        } else if (g_strcmp0(tokens[0], "coherence") == 0) {
+            bool on;
+            if (!qemu_plugin_bool_parse(tokens[0], tokens[1], &on)) {
+                fprintf(stderr, "boolean argument parsing failed: %s\n", opt);
+                return -1;
+            }
+            coherence_opt = on;
+        } else if (g_strcmp0(tokens[0], "dirsize") == 0) {
+            dir_size = STRTOLL(tokens[1]);
+        } else if (g_strcmp0(tokens[0], "batch") == 0) {
+            batch_size = STRTOLL(tokens[1]);
         } else if (g_strcmp0(tokens[0], "evict") == 0) {
             if (g_strcmp0(tokens[1], "rand") == 0) {
                 policy = RAND;
@@ -811,6 +1237,10 @@ int qemu_plugin_install(qemu_plugin_id_t id, const qemu_info_t *info,
                 policy = LRU;
             } else if (g_strcmp0(tokens[1], "fifo") == 0) {
                 policy = FIFO;
+            } else if (g_strcmp0(tokens[1], "plru") == 0) {
+                policy = PLRU;
+            } else if (g_strcmp0(tokens[1], "srrip") == 0) {
+                policy = SRRIP;
             } else {
                 fprintf(stderr, "invalid eviction policy: %s\n", opt);
                 return -1;
@@ -821,6 +1251,23 @@ int qemu_plugin_install(qemu_plugin_id_t id, const qemu_info_t *info,
         }
     }
 
+    if (cores < 1 || batch_size < 1) {
+        fprintf(stderr, "cores and batch must be positive\n");
+        return -1;
+    }
+
+    /* the directory tracks sharers in a 32-bit mask */
+    if (coherence_opt == 1 && (cores > 32 || cores < 2)) {
+        fprintf(stderr, "coherence needs between 2 and 32 cores\n");
+        return -1;
+    }
+    coherence = coherence_opt == -1 ? cores > 1 && cores <= 32 : coherence_opt;
+
+    if (coherence && (dir_size & (dir_size - 1))) {
+        fprintf(stderr, "dirsize must be a power of two\n");
+        return -1;
+    }
+
     policy_init();
 
     l1_dcaches = caches_init(l1_dblksize, l1_dassoc, l1_dcachesize);
@@ -847,9 +1294,26 @@ int qemu_plugin_install(qemu_plugin_id_t id, const qemu_info_t *info,
         return -1;
     }
 
-    l1_dcache_locks = g_new0(GMutex, cores);
-    l1_icache_locks = g_new0(GMutex, cores);
-    l2_ucache_locks = use_l2 ? g_new0(GMutex, cores) : NULL;
+    if (use_l3) {
+        if (bad_cache_params(l3_blksize, l3_assoc, l3_cachesize)) {
+            const char *err = cache_config_error(l3_blksize, l3_assoc,
+                                                 l3_cachesize);
+            fprintf(stderr, "L3 cache cannot be constructed from given "
+                    "parameters\n");
+            fprintf(stderr, "%s\n", err);
+            return -1;
+        }
+        l3_ucache = cache_init(l3_blksize, l3_assoc, l3_cachesize, L3_LOCKS);
+    }
+
+    if (coherence) {
+        directory = g_new0(uint64_t, dir_size);
+        dir_mask = dir_size - 1;
+        dir_shift = pow_of_two(l1_dblksize);
+    }
+
+    core_data = g_new0(CoreData, cores);
+    queues = qemu_plugin_scoreboard_new(sizeof(AccessQueue));
 
     qemu_plugin_register_vcpu_tb_trans_cb(id, vcpu_tb_trans);
     qemu_plugin_register_atexit_cb(id, plugin_exit, NULL);
@@ -0,0 +1,315 @@
+/*
+ * Decode a binary trace written by the execlog plugin (binfile=) into
+ * the same text format the plugin logs by default.
+ *
+ * License: GNU GPL, version 2 or later.
+ *   See the COPYING file in the top-level directory.
+ */
+#include <glib.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef CONFIG_ZSTD
+#include <zstd.h>
+#endif
+
+#include <qemu-plugin.h>
+
+#include "execlog.h"
+
+typedef struct {
+    FILE *file;
+#ifdef CONFIG_ZSTD
+    ZSTD_DCtx *dctx;
+    ZSTD_inBuffer in;
+    uint8_t *inbuf;
+    size_t inbuf_size;
+    uint8_t *outbuf;
+    size_t outbuf_size;
+    size_t out_pos, out_len;
+#endif
+} TraceReader;
+
+typedef struct {
+    uint64_t vaddr;
+    uint32_t opcode;
+    char *disas;
+} Insn;
+
+/* instructions by id, and register names by index */
+static GHashTable *insns;
+static GPtrArray *reg_names;
+
+static bool reader_open(TraceReader *r, const char *path)
+{
+    qemu_plugin_trace_header header;
+
+    memset(r, 0, sizeof(*r));
+    r->file = fopen(path, "rb");
+    if (!r->file) {
+        perror(path);
+        return false;
+    }
+    if (fread(&header, sizeof(header), 1, r->file) != 1 ||
+        memcmp(header.magic, QEMU_PLUGIN_TRACE_MAGIC, sizeof(header.magic)) ||
+        header.version != QEMU_PLUGIN_TRACE_VERSION) {
+        fprintf(stderr, "%s: not a plugin trace\n", path);
+        fclose(r->file);
+        return false;
+    }
+    if (header.flags & QEMU_PLUGIN_TRACE_ZSTD) {
+#ifdef CONFIG_ZSTD
+        r->dctx = ZSTD_createDCtx();
+        r->inbuf_size = ZSTD_DStreamInSize();
+        r->inbuf = g_malloc(r->inbuf_size);
+        r->outbuf_size = ZSTD_DStreamOutSize();
+        r->outbuf = g_malloc(r->outbuf_size);
+        r->in.src = r->inbuf;
+#else
+        fprintf(stderr, "%s: compressed, but built without zstd\n", path);
+        fclose(r->file);
+        return false;
+#endif
+    }
+    return true;
+}
+
+static void reader_close(TraceReader *r)
+{
+#ifdef CONFIG_ZSTD
+    if (r->dctx) {
+        ZSTD_freeDCtx(r->dctx);
+        g_free(r->inbuf);
+        g_free(r->outbuf);
+    }
+#endif
+    fclose(r->file);
+}
+
+/* Read exactly @len bytes, returns false at end of trace */
+static bool reader_read(TraceReader *r, void *buf, size_t len)
+{
+#ifdef CONFIG_ZSTD
+    uint8_t *p = buf;
+
+    if (!r->dctx) {
+        return fread(buf, 1, len, r->file) == len;
+    }
+
+    while (len) {
+        size_t n;
+
+        if (r->out_pos == r->out_len) {
+            ZSTD_outBuffer out = { r->outbuf, r->outbuf_size, 0 };
+            size_t ret;
+
+            if (r->in.pos == r->in.size) {
+                r->in.size = fread(r->inbuf, 1, r->inbuf_size, r->file);
+                r->in.pos = 0;
+                if (!r->in.size) {
+                    return false;
+                }
+            }
+            ret = ZSTD_decompressStream(r->dctx, &out, &r->in);
+            if (ZSTD_isError(ret)) {
+                fprintf(stderr, "decompression failed: %s\n",
+                        ZSTD_getErrorName(ret));
+                return false;
+            }
+            r->out_pos = 0;
+            r->out_len = out.pos;
+            continue;
+        }
+
+        n = MIN(len, r->out_len - r->out_pos);
+        memcpy(p, r->outbuf + r->out_pos, n);
+        r->out_pos += n;
+        p += n;
+        len -= n;
+    }
+    return true;
+#else
+    return fread(buf, 1, len, r->file) == len;
+#endif
+}
+
+/*
+ * Call @fn on every record of every chunk. Records never straddle
+ * chunks, so each chunk is parsed on its own.
+ */
+static void for_each_record(const char *path,
+                            void (*fn)(uint32_t stream,
+                                       const ExeclogRecord *rec,
+                                       const uint8_t *payload))
+{
+    TraceReader r;
+    qemu_plugin_trace_chunk chunk;
+    g_autoptr(GByteArray) buf = g_byte_array_new();
+
+    if (!reader_open(&r, path)) {
+        exit(EXIT_FAILURE);
+    }
+
+    while (reader_read(&r, &chunk, sizeof(chunk))) {
+        size_t off = 0;
+
+        g_byte_array_set_size(buf, chunk.len);
+        if (!reader_read(&r, buf->data, chunk.len)) {
+            fprintf(stderr, "%s: truncated trace\n", path);
+            break;
+        }
+        while (off + sizeof(ExeclogRecord) <= chunk.len) {
+            ExeclogRecord rec;
+
+            memcpy(&rec, buf->data + off, sizeof(rec));
+            off += sizeof(rec);
+            if (off + rec.len > chunk.len) {
+                fprintf(stderr, "%s: corrupt chunk\n", path);
+                break;
+            }
+            fn(chunk.stream, &rec, buf->data + off);
+            off += rec.len;
+        }
+    }
+
+    reader_close(&r);
+}
+
+static void collect_defs(uint32_t stream, const ExeclogRecord *rec,
+                         const uint8_t *payload)
+{
+    if (stream != EXECLOG_DEFS_STREAM) {
+        return;
+    }
+
+    switch (rec->type) {
+    case EXECLOG_REC_INSN:
+    {
+        Insn *insn = g_new0(Insn, 1);
+        uint64_t id;
+
+        memcpy(&id, payload, sizeof(id));
+        memcpy(&insn->vaddr, payload + sizeof(id), sizeof(insn->vaddr));
+        insn->opcode = rec->data;
+        insn->disas = g_strndup((const char *)payload + 2 * sizeof(uint64_t),
+                                rec->len - 2 * sizeof(uint64_t));
+        g_hash_table_insert(insns, g_memdup(&id, sizeof(id)), insn);
+        break;
+    }
+    case EXECLOG_REC_REGNAME:
+        if (rec->data >= reg_names->len) {
+            g_ptr_array_set_size(reg_names, rec->data + 1);
+        }
+        g_ptr_array_index(reg_names, rec->data) =
+            g_strndup((const char *)payload, rec->len);
+        break;
+    default:
+        break;
+    }
+}
+
+/* line being built for each vCPU, printed at its next instruction */
+static GPtrArray *pending;
+
+static void print_line(GString *s)
+{
+    if (s->len) {
+        fputs(s->str, stdout);
+        fputc('\n', stdout);
+    }
+}
+
+static void print_exec(uint32_t stream, const ExeclogRecord *rec,
+                       const uint8_t *payload)
+{
+    unsigned int cpu_index = stream - 1;
+    GString *s;
+
+    if (stream == EXECLOG_DEFS_STREAM) {
+        return;
+    }
+
+    while (cpu_index >= pending->len) {
+        g_ptr_array_add(pending, g_string_new(NULL));
+    }
+    s = g_ptr_array_index(pending, cpu_index);
+
+    switch (rec->type) {
+    case EXECLOG_REC_EXEC:
+    {
+        uint64_t id;
+        Insn *insn;
+
+        memcpy(&id, payload, sizeof(id));
+        insn = g_hash_table_lookup(insns, &id);
+        print_line(s);
+        if (!insn) {
+            g_string_printf(s, "%u, unknown instruction %" PRIu64,
+                            cpu_index, id);
+            break;
+        }
+        g_string_printf(s, "%u, 0x%" PRIx64 ", 0x%" PRIx32 ", \"%s\"",
+                        cpu_index, insn->vaddr, insn->opcode, insn->disas);
+        break;
+    }
+    case EXECLOG_REC_MEM:
+    {
+        uint64_t addr[2];
+
+        memcpy(addr, payload, MIN(rec->len, sizeof(addr)));
+        g_string_append(s, rec->flags & EXECLOG_MEM_STORE ?
+                        ", store" : ", load");
+        g_string_append_printf(s, ", 0x%08" PRIx64,
+                               rec->flags & EXECLOG_MEM_PHYS ?
+                               addr[1] : addr[0]);
+        break;
+    }
+    case EXECLOG_REC_REG:
+    {
+        const char *name = rec->data < reg_names->len ?
+            g_ptr_array_index(reg_names, rec->data) : NULL;
+        int i;
+
+        /* registers belong to the previous instruction, if there was one */
+        if (!s->len) {
+            break;
+        }
+        g_string_append_printf(s, ", %s=", name ? name : "?");
+        for (i = 0; i < rec->len; i++) {
+            g_string_append_printf(s, "%02x", payload[i]);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    guint i;
+
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s TRACE\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    insns = g_hash_table_new(g_int64_hash, g_int64_equal);
+    reg_names = g_ptr_array_new();
+    pending = g_ptr_array_new();
+
+    /*
+     * Instructions can be executed by one vCPU before the translating
+     * vCPU's definition reaches the file, so collect them all first.
+     */
+    for_each_record(argv[1], collect_defs);
+    for_each_record(argv[1], print_exec);
+
+    for (i = 0; i < pending->len; i++) {
+        print_line(g_ptr_array_index(pending, i));
+    }
+
+    return EXIT_SUCCESS;
+}
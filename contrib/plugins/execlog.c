@@ -15,11 +15,185 @@
 
 #include <qemu-plugin.h>
 
+#include "execlog.h"
+
 QEMU_PLUGIN_EXPORT int qemu_plugin_version = QEMU_PLUGIN_VERSION;
 
 /* Store last executed instruction on each vCPU as a GString */
 GArray *last_exec;
 
+/* Register names requested with reg=, and the matching registers per vCPU */
+static GPtrArray *reg_names;
+static GPtrArray *vcpu_regs;
+static GMutex lock;
+
+/* A register to log, and its index in reg_names */
+typedef struct {
+    qemu_plugin_reg_descriptor desc;
+    uint32_t idx;
+} LogReg;
+
+/* Binary trace, when binfile= is given, and the next instruction id */
+static struct qemu_plugin_trace *trace;
+static uint64_t next_insn_id;
+
+/**
+ * Pick the registers to log for a vCPU once it is initialised
+ */
+static void vcpu_init(qemu_plugin_id_t id, unsigned int cpu_index)
+{
+    GArray *regs;
+    qemu_plugin_reg_descriptor *descs;
+    size_t n, i, j;
+
+    regs = g_array_new(FALSE, FALSE, sizeof(LogReg));
+    descs = qemu_plugin_get_registers(&n);
+    for (i = 0; i < n; i++) {
+        for (j = 0; j < reg_names->len; j++) {
+            const char *name = g_ptr_array_index(reg_names, j);
+            if (g_strcmp0(descs[i].name, name) == 0) {
+                LogReg reg = { .desc = descs[i], .idx = j };
+                g_array_append_val(regs, reg);
+            }
+        }
+    }
+    g_free(descs);
+
+    g_mutex_lock(&lock);
+    if (cpu_index >= vcpu_regs->len) {
+        g_ptr_array_set_size(vcpu_regs, cpu_index + 1);
+    }
+    g_ptr_array_index(vcpu_regs, cpu_index) = regs;
+    g_mutex_unlock(&lock);
+}
+
+static GArray *get_vcpu_regs(unsigned int cpu_index)
+{
+    GArray *regs;
+
+    g_mutex_lock(&lock);
+    regs = cpu_index < vcpu_regs->len ?
+        g_ptr_array_index(vcpu_regs, cpu_index) : NULL;
+    g_mutex_unlock(&lock);
+    return regs;
+}
+
+/**
+ * Append the current value of the selected registers to a log line
+ */
+static void append_regs(GString *s, unsigned int cpu_index)
+{
+    GArray *regs = get_vcpu_regs(cpu_index);
+    uint8_t buf[64];
+    guint i;
+    int j, size;
+
+    if (!regs) {
+        return;
+    }
+
+    for (i = 0; i < regs->len; i++) {
+        LogReg *reg = &g_array_index(regs, LogReg, i);
+
+        size = qemu_plugin_read_register(reg->desc.handle, buf, sizeof(buf));
+        if (size <= 0 || size > sizeof(buf)) {
+            continue;
+        }
+        /* values are in target byte order, print them as raw bytes */
+        g_string_append_printf(s, ", %s=", reg->desc.name);
+        for (j = 0; j < size; j++) {
+            g_string_append_printf(s, "%02x", buf[j]);
+        }
+    }
+}
+
+/**
+ * Write a record and its payload to a stream of the binary trace
+ */
+static void write_record(unsigned int stream, uint8_t type, uint8_t flags,
+                         uint32_t data, const void *payload, uint16_t len)
+{
+    ExeclogRecord rec = {
+        .type = type, .flags = flags, .len = len, .data = data,
+    };
+    uint8_t small[sizeof(rec) + 64];
+    uint8_t *buf = len <= 64 ? small : g_malloc(sizeof(rec) + len);
+
+    memcpy(buf, &rec, sizeof(rec));
+    memcpy(buf + sizeof(rec), payload, len);
+    qemu_plugin_trace_write(trace, stream, buf, sizeof(rec) + len);
+    if (buf != small) {
+        g_free(buf);
+    }
+}
+
+/**
+ * Binary counterpart of vcpu_mem
+ */
+static void vcpu_mem_bin(unsigned int cpu_index, qemu_plugin_meminfo_t info,
+                         uint64_t vaddr, void *udata)
+{
+    struct qemu_plugin_hwaddr *hwaddr = qemu_plugin_get_hwaddr(info, vaddr);
+    uint64_t addr[2] = { vaddr };
+    uint8_t flags = 0;
+
+    if (qemu_plugin_mem_is_store(info)) {
+        flags |= EXECLOG_MEM_STORE;
+    }
+    if (hwaddr) {
+        addr[1] = qemu_plugin_hwaddr_phys_addr(hwaddr);
+        flags |= EXECLOG_MEM_PHYS;
+    }
+    write_record(cpu_index + 1, EXECLOG_REC_MEM, flags, 0, addr,
+                 hwaddr ? sizeof(addr) : sizeof(addr[0]));
+}
+
+/**
+ * Binary counterpart of vcpu_insn_exec
+ */
+static void vcpu_insn_exec_bin(unsigned int cpu_index, void *udata)
+{
+    uint64_t id = (uintptr_t)udata;
+    GArray *regs = reg_names->len ? get_vcpu_regs(cpu_index) : NULL;
+    uint8_t buf[64];
+    guint i;
+    int size;
+
+    /* registers as the previous instruction left them */
+    for (i = 0; regs && i < regs->len; i++) {
+        LogReg *reg = &g_array_index(regs, LogReg, i);
+
+        size = qemu_plugin_read_register(reg->desc.handle, buf, sizeof(buf));
+        if (size > 0 && size <= sizeof(buf)) {
+            write_record(cpu_index + 1, EXECLOG_REC_REG, 0, reg->idx,
+                         buf, size);
+        }
+    }
+
+    write_record(cpu_index + 1, EXECLOG_REC_EXEC, 0, 0, &id, sizeof(id));
+}
+
+/**
+ * Describe an instruction in the binary trace, returning its id
+ */
+static uint64_t trace_insn(uint64_t vaddr, uint32_t opcode, const char *disas)
+{
+    g_autoptr(GByteArray) payload = g_byte_array_new();
+    size_t disas_len = MIN(strlen(disas), UINT16_MAX - 2 * sizeof(uint64_t));
+    uint64_t id;
+
+    g_mutex_lock(&lock);
+    id = next_insn_id++;
+    g_byte_array_append(payload, (guint8 *)&id, sizeof(id));
+    g_byte_array_append(payload, (guint8 *)&vaddr, sizeof(vaddr));
+    g_byte_array_append(payload, (guint8 *)disas, disas_len);
+    write_record(EXECLOG_DEFS_STREAM, EXECLOG_REC_INSN, 0, opcode,
+                 payload->data, payload->len);
+    g_mutex_unlock(&lock);
+
+    return id;
+}
+
 /**
  * Add memory read or write information to current instruction log
  */
@@ -64,8 +238,11 @@ static void vcpu_insn_exec(unsigned int cpu_index, void *udata)
     }
     s = g_array_index(last_exec, GString *, cpu_index);
 
-    /* Print previous instruction in cache */
+    /* Print previous instruction in cache, with the registers it left */
     if (s->len) {
+        if (reg_names->len) {
+            append_regs(s, cpu_index);
+        }
         qemu_plugin_outs(s->str);
         qemu_plugin_outs("\n");
     }
@@ -102,6 +279,21 @@ static void vcpu_tb_trans(qemu_plugin_id_t id, struct qemu_plugin_tb *tb)
         insn_vaddr = qemu_plugin_insn_vaddr(insn);
         insn_opcode = *((uint32_t *)qemu_plugin_insn_data(insn));
         insn_disas = qemu_plugin_insn_disas(insn);
+
+        if (trace) {
+            uint64_t id = trace_insn(insn_vaddr, insn_opcode, insn_disas);
+
+            g_free(insn_disas);
+            qemu_plugin_register_vcpu_mem_cb(insn, vcpu_mem_bin,
+                                             QEMU_PLUGIN_CB_NO_REGS,
+                                             QEMU_PLUGIN_MEM_RW, NULL);
+            qemu_plugin_register_vcpu_insn_exec_cb(
+                insn, vcpu_insn_exec_bin,
+                reg_names->len ? QEMU_PLUGIN_CB_R_REGS : QEMU_PLUGIN_CB_NO_REGS,
+                (void *)(uintptr_t)id);
+            continue;
+        }
+
         char *output = g_strdup_printf("0x%"PRIx64", 0x%"PRIx32", \"%s\"",
                                        insn_vaddr, insn_opcode, insn_disas);
 
@@ -111,8 +303,10 @@ static void vcpu_tb_trans(qemu_plugin_id_t id, struct qemu_plugin_tb *tb)
                                          QEMU_PLUGIN_MEM_RW, NULL);
 
         /* Register callback on instruction */
-        qemu_plugin_register_vcpu_insn_exec_cb(insn, vcpu_insn_exec,
-                                               QEMU_PLUGIN_CB_NO_REGS, output);
+        qemu_plugin_register_vcpu_insn_exec_cb(
+            insn, vcpu_insn_exec,
+            reg_names->len ? QEMU_PLUGIN_CB_R_REGS : QEMU_PLUGIN_CB_NO_REGS,
+            output);
     }
 }
 
@@ -123,6 +317,13 @@ static void plugin_exit(qemu_plugin_id_t id, void *p)
 {
     guint i;
     GString *s;
+
+    if (trace) {
+        qemu_plugin_trace_close(trace);
+        trace = NULL;
+        return;
+    }
+
     for (i = 0; i < last_exec->len; i++) {
         s = g_array_index(last_exec, GString *, i);
         if (s->str) {
@@ -144,8 +345,49 @@ QEMU_PLUGIN_EXPORT int qemu_plugin_install(qemu_plugin_id_t id,
      * we don't know the size before emulation.
      */
     last_exec = g_array_new(FALSE, FALSE, sizeof(GString *));
+    reg_names = g_ptr_array_new();
+    vcpu_regs = g_ptr_array_new();
+
+    const char *binfile = NULL;
+    bool compress = false;
+
+    for (int i = 0; i < argc; i++) {
+        char *opt = argv[i];
+        g_autofree char **tokens = g_strsplit(opt, "=", 2);
+        if (g_strcmp0(tokens[0], "reg") == 0 && tokens[1]) {
+            g_ptr_array_add(reg_names, g_strdup(tokens[1]));
+        } else if (g_strcmp0(tokens[0], "binfile") == 0 && tokens[1]) {
+            binfile = opt + strlen("binfile=");
+        } else if (g_strcmp0(tokens[0], "compress") == 0) {
+            if (!qemu_plugin_bool_parse(tokens[0], tokens[1], &compress)) {
+                fprintf(stderr, "boolean argument parsing failed: %s\n", opt);
+                return -1;
+            }
+        } else {
+            fprintf(stderr, "option parsing failed: %s\n", opt);
+            return -1;
+        }
+    }
+
+    if (binfile) {
+        trace = qemu_plugin_trace_open(binfile, compress);
+        if (!trace) {
+            return -1;
+        }
+        for (guint i = 0; i < reg_names->len; i++) {
+            const char *name = g_ptr_array_index(reg_names, i);
+            write_record(EXECLOG_DEFS_STREAM, EXECLOG_REC_REGNAME, 0, i,
+                         name, strlen(name));
+        }
+    } else if (compress) {
+        fprintf(stderr, "compress requires binfile\n");
+        return -1;
+    }
 
     /* Register translation block and exit callbacks */
+    if (reg_names->len) {
+        qemu_plugin_register_vcpu_init_cb(id, vcpu_init);
+    }
     qemu_plugin_register_vcpu_tb_trans_cb(id, vcpu_tb_trans);
     qemu_plugin_register_atexit_cb(id, plugin_exit, NULL);
 
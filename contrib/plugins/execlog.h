@@ -0,0 +1,41 @@
+/*
+ * Binary trace records written by the execlog plugin and read back by
+ * execlog-decode.
+ *
+ * License: GNU GPL, version 2 or later.
+ *   See the COPYING file in the top-level directory.
+ */
+#ifndef EXECLOG_H
+#define EXECLOG_H
+
+#include <stdint.h>
+
+/*
+ * Instructions and register names are described once, in stream 0.
+ * Every vCPU then writes to stream cpu_index + 1, in execution order:
+ * an EXEC record per instruction, followed by the MEM records of the
+ * accesses it made. REG records carry the registers as the previous
+ * instruction left them, like the text log does.
+ */
+#define EXECLOG_DEFS_STREAM 0
+
+enum execlog_rec_type {
+    EXECLOG_REC_INSN,    /* data: opcode, payload: id, vaddr, disas */
+    EXECLOG_REC_REGNAME, /* data: reg index, payload: name */
+    EXECLOG_REC_EXEC,    /* payload: id */
+    EXECLOG_REC_MEM,     /* flags: store?, payload: vaddr[, paddr] */
+    EXECLOG_REC_REG,     /* data: reg index, payload: value */
+};
+
+#define EXECLOG_MEM_STORE (1 << 0)
+/* the access was to memory, paddr follows vaddr */
+#define EXECLOG_MEM_PHYS  (1 << 1)
+
+typedef struct {
+    uint8_t type;
+    uint8_t flags;
+    uint16_t len; /* bytes of payload following the header */
+    uint32_t data;
+} ExeclogRecord;
+
+#endif /* EXECLOG_H */
@@ -1,479 +1,338 @@
-
-#include <assert.h>
+/*
+ * Instruction fusion candidate analyzer for RISC-V
+ *
+ * Every translated block is classified once and gets an execution
+ * counter. At exit each run of two or three adjacent instructions is
+ * checked for register dependences: a run is a fusion candidate when
+ * every instruction after the first reads a result of an earlier one.
+ * Candidates are weighted by how often their block executed and ranked
+ * by the cycles a macro-op fusion would save, assuming each fused
+ * instruction saves one issue cycle.
+ *
+ * License: GNU GPL, version 2 or later.
+ *   See the COPYING file in the top-level directory.
+ */
+#include <inttypes.h>
 #include <stdlib.h>
 #include <string.h>
-#include <unistd.h>
 #include <stdio.h>
 #include <glib.h>
 
-
 #include <qemu-plugin.h>
 
-#include "riscv64insts.h"
+#include "riscv-classify.h"
 
 QEMU_PLUGIN_EXPORT int qemu_plugin_version = QEMU_PLUGIN_VERSION;
 
-#define ARRAY_SIZE(x) (sizeof(x) / sizeof((x)[0]))
-
-typedef gpointer InstInfoHash;
+/* longest sequence considered for fusion */
+#define MAX_SEQ 3
 
-static inline uint32_t bits(uint32_t val, uint8_t msb, uint8_t len)
+static bool do_inline;
+static int max_seq = MAX_SEQ;
+static guint64 limit = 50;
+
+/* Plugins need to take care of their own locking */
+static GMutex lock;
+static GHashTable *blocks;
+
+/* Blocks are keyed by their start address and number of instructions */
+typedef struct {
+    uint64_t start_addr;
+    size_t n_insns;
+    RISCVInsnInfo *insns;
+    struct qemu_plugin_scoreboard *exec_count;
+} BlockInfo;
+
+/*
+ * A fusion candidate: the class of each instruction (id * 2, plus one
+ * if compressed) and, for each source operand of each instruction, the
+ * position + 1 of the instruction of the sequence producing it, or 0.
+ */
+typedef struct {
+    uint16_t cls[MAX_SEQ];
+    uint8_t src[MAX_SEQ][3];
+    uint8_t len;
+} FusionKey;
+
+typedef struct {
+    FusionKey key;
+    uint64_t count;
+    /* executions where the last instruction overwrites every result */
+    uint64_t dead_count;
+} Fusion;
+
+static guint block_hash(gconstpointer v)
 {
-    return (val << (31 - msb)) >> (32 - len);
-}
+    const BlockInfo *bi = v;
 
-static inline uint32_t decode32Rd(uint32_t inst)
-{
-    return bits(inst, 11, 5);
+    return g_int64_hash(&bi->start_addr) * 31 + bi->n_insns;
 }
 
-static inline uint32_t decode32Rs1(uint32_t inst)
+static gboolean block_equal(gconstpointer a, gconstpointer b)
 {
-    return bits(inst, 19, 5);
-}
+    const BlockInfo *x = a, *y = b;
 
-static inline uint32_t decode32Rs2(uint32_t inst)
-{
-    return bits(inst, 24, 5);
+    return x->start_addr == y->start_addr && x->n_insns == y->n_insns;
 }
 
-static inline uint32_t decode32Shamt(uint32_t inst)
+static guint fusion_key_hash(gconstpointer v)
 {
-    return bits(inst, 25, 6);
-}
-
-typedef struct InstInfo {
-    InstPatternInfo* info;
-    uint8_t rd;
-    uint8_t rs1;
-    uint8_t rs2;
-    union {
-        uint8_t shamt;
-        uint8_t imm;
-    };
-    GHashTable* follow_insts_cnt;   // InstInfoHash -> counter;
-} InstInfo;
-
-static inline InstInfo* allocDefaultInstInfo(void)
-{
-    InstInfo* instInfo = g_new0(InstInfo, 1);
-    instInfo->info  = NULL;
-    instInfo->rd    = 0;
-    instInfo->rs1   = 0;
-    instInfo->rs2   = 0;
-    instInfo->shamt = 0;
-    return instInfo;
-}
+    const FusionKey *k = v;
+    guint h = k->len;
+    int i;
 
-static inline InstInfo* initInstInfo(InstInfo* instInfo, InstPatternInfo* patternInfo, uint32_t inst)
-{
-    instInfo->info  = patternInfo;
-    switch(instInfo->info->pattern_type) {
-        case PT_CLD:
-            instInfo->rd    = 0x8 | bits(inst, 4, 3);
-            instInfo->rs1   = 0x8 | bits(inst, 9, 3);
-            instInfo->rs2   = 0;
-            instInfo->shamt = 0;
-            break;
-        case PT_CST:
-            instInfo->rd    = 0;
-            instInfo->rs1   = 0x8 | bits(inst, 9, 3);
-            instInfo->rs2   = 0x8 | bits(inst, 4, 3);
-            instInfo->shamt = 0;
-            break;
-        case PT_CIRD5: // c.addi, c.addiw, c.li, c.addi16sp, c.lui
-            instInfo->rd    = bits(inst, 11, 5);
-            instInfo->rs1   = bits(inst, 11, 5);
-            instInfo->rs2   = 0;
-            instInfo->shamt = 0;            
-            break;
-        case PT_CIRD3: // c.andi
-            instInfo->rd    = 0x8 | bits(inst, 9, 3);
-            instInfo->rs1   = 0x8 | bits(inst, 9, 3);
-            instInfo->rs2   = 0;
-            instInfo->imm   = bits(inst, 12, 1) | bits(inst, 6, 5);
-            break;
-        case PT_CSHRD3: // c.srli, c.srai
-            instInfo->rd    = 0x8 | bits(inst, 9, 3);
-            instInfo->rs1   = 0x8 | bits(inst, 9, 3);
-            instInfo->rs2   = 0;
-            instInfo->shamt = (bits(inst, 12, 1) << 5) | bits(inst, 6, 5);
-            break;
-        case PT_CSHRD5: // c.slli
-            instInfo->rd    = bits(inst, 11, 5);
-            instInfo->rs1   = bits(inst, 11, 5);
-            instInfo->rs2   = 0;
-            instInfo->shamt = (bits(inst, 12, 1) << 5) | bits(inst, 6, 5);
-            break;
-        case PT_CSH64RD3: // c.srli64, c.srai64
-            instInfo->rd    = 0x8 | bits(inst, 9, 3);
-            instInfo->rs1   = 0x8 | bits(inst, 9, 3);
-            instInfo->rs2   = 0;
-            instInfo->shamt = 64;
-            break;
-        case PT_CSH64RD5: // c.slli64
-            instInfo->rd    = bits(inst, 11, 5);
-            instInfo->rs1   = bits(inst, 11, 5);
-            instInfo->rs2   = 0;
-            instInfo->shamt = 64;
-            break;
-        case PT_CB: // c.beqz, c.bnez
-            instInfo->rd    = 0;
-            instInfo->rs1   = 0x8 | bits(inst, 9, 3);
-            instInfo->rs2   = 0;
-            instInfo->shamt = 0;
-            break;
-        case PT_CLDSP: // c.ldsp, c.fldsp, c.lwsp
-            instInfo->rd    = bits(inst, 11, 5);
-            instInfo->rs1   = 2; // sp = 2
-            instInfo->rs2   = 0;
-            instInfo->shamt = 0;
-            break;
-        case PT_CSTSP: // c.sdsp, c.fsdsp, c.swsp
-            instInfo->rd    = 0;
-            instInfo->rs1   = 2; // sp = 2
-            instInfo->rs2   = bits(inst, 11, 5);
-            instInfo->shamt = 0;
-            break;
-        case PT_CADD: // c.add
-            instInfo->rd    = bits(inst, 11, 5);
-            instInfo->rs1   = bits(inst, 11, 5);
-            instInfo->rs2   = bits(inst, 6, 5);
-            instInfo->shamt = 0;
-            break;
-        case PT_CMV: // c.mv
-            instInfo->rd    = bits(inst, 11, 5);
-            instInfo->rs1   = 0;
-            instInfo->rs2   = bits(inst, 6, 5);
-            instInfo->shamt = 0;
-            break;
-        case PT_CJR: // c.jr
-            instInfo->rd    = 0;
-            instInfo->rs1   = bits(inst, 11, 5);
-            instInfo->rs2   = 0;
-            instInfo->shamt = 0;
-            break;
-        case PT_CJALR: // c.jalr
-            instInfo->rd    = 1; // x1 is target reg of c.jalr
-            instInfo->rs1   = bits(inst, 11, 5);
-            instInfo->rs2   = 0;
-            instInfo->shamt = 0;
-            break;
-        case PT_NONE: // Dont care insts
-            instInfo->rd    = 0;
-            instInfo->rs1   = 0;
-            instInfo->rs2   = 0;
-            instInfo->shamt = 0;
-            break;
-        default: // 32bits inst
-            instInfo->rd    = decode32Rd(inst);
-            instInfo->rs1   = decode32Rs1(inst);
-            instInfo->rs2   = decode32Rs2(inst);
-            instInfo->shamt = decode32Shamt(inst);
-            break;
+    for (i = 0; i < k->len; i++) {
+        h = h * 31 + k->cls[i];
+        h = h * 31 + (k->src[i][0] | k->src[i][1] << 2 | k->src[i][2] << 4);
     }
-    instInfo->follow_insts_cnt = NULL;
-    return instInfo;
+    return h;
 }
 
-static InstInfo* allocInstInfo(InstPatternInfo* patternInfo, uint32_t inst)
+static gboolean fusion_key_equal(gconstpointer a, gconstpointer b)
 {
-    InstInfo* instInfo = g_new0(InstInfo, 1);
-    initInstInfo(instInfo, patternInfo, inst);
-    return instInfo;
+    return memcmp(a, b, sizeof(FusionKey)) == 0;
 }
 
-
-static void freeInstInfo(InstInfo* instInfo)
+/*
+ * Return a number identifying register operand @op (0 for rd, then
+ * rs1..rs3) of @insn across register files, or -1 if there is no such
+ * operand. x0 never carries a dependence.
+ */
+static int reg_id(const RISCVInsnInfo *insn, int op)
 {
-    if (instInfo->follow_insts_cnt)
-        g_hash_table_destroy(instInfo->follow_insts_cnt);
-    g_free(instInfo);
-}
+    const int8_t regs[] = { insn->rd, insn->rs1, insn->rs2, insn->rs3 };
 
-static InstInfoHash instInfoHash(InstInfo* instInfo)
-{
-    uint64_t res = 0;
-    switch(instInfo->info->pattern_type) {
-        case PT_R:
-            res |= instInfo->rd;
-            res |= instInfo->rs1 << 8u;
-            res |= instInfo->rs2 << 16u;
-            break;
-        case PT_JAL:
-            res |= instInfo->rd;
-            break;
-        case PT_B:
-            res |= instInfo->rs1;
-            res |= instInfo->rs2 << 8u;
-            break;
-        case PT_I:
-            res |= instInfo->rd;
-            res |= instInfo->rs1 << 8u;
-            break;
-        case PT_LD:
-            res |= instInfo->rd;
-            res |= instInfo->rs1 << 8u;
-            break;
-        case PT_ST:
-            res |= instInfo->rs1;
-            res |= instInfo->rs2 << 8u;
-            break;
-        case PT_SH6:
-        case PT_SH5:
-            res |= instInfo->rd;
-            res |= instInfo->rs1 << 8u;
-            res |= instInfo->rs2 << 16u;
-            break;
-        case PT_SHI6:
-        case PT_SHI5:
-            res |= instInfo->rd;
-            res |= instInfo->rs1 << 8u;
-            res |= instInfo->shamt << 16u;
-            break;
-        case PT_CLD: // c.fld, c.lw, c.ld
-            res |= instInfo->rd;
-            break;
-        case PT_CST: // c.fsd, c.sw, c.sd
-            res |= instInfo->rs1;
-            break;
-        case PT_CIRD5: // c.addi, c.addiw, c.li, c.addi16sp, c.lui
-            res |= instInfo->rd;
-            break;
-        case PT_CIRD3: // c.andi
-            res |= instInfo->rd;
-            res |= instInfo->imm << 8u;
-            break;
-        case PT_CSHRD3: // c.srli, c.srai
-            res |= instInfo->rd;
-            res |= instInfo->shamt << 8u;
-            break;
-        case PT_CSHRD5: // c.slli
-            res |= instInfo->rd;
-            res |= instInfo->shamt << 8u;
-            break;
-        case PT_CB: // c.beqz, c.bnez
-            res |= instInfo->rs1;
-            break;
-        case PT_CLDSP: // c.ldsp, c.fldsp, c.lwsp
-        case PT_CSTSP: // c.sdsp, c.fsdsp, c.swsp
-            res |= instInfo->rd;
-            break;
-        case PT_CADD: // c.add
-        case PT_CMV:
-            res |= instInfo->rd;
-            res |= instInfo->rs2 << 8u;
-            break;
-        case PT_CJR: // c.jr
-        case PT_CJALR: // c.jalr
-            res |= instInfo->rs1;
-            break;
-        default: break;
+    if (regs[op] < 0) {
+        return -1;
+    }
+    if (insn->flags & (RISCV_RD_FP << op)) {
+        return 32 + regs[op];
+    }
+    if (insn->flags & (RISCV_RD_VEC << op)) {
+        return 64 + regs[op];
     }
-    res |= ((uint64_t)instInfo->info->idx) << 32u;
-    return (gpointer)res;
+    return regs[op] ? regs[op] : -1;
 }
 
+/*
+ * Fill @key for the @len instructions at @insns. Returns false if one
+ * of them does not depend on an earlier one, in which case fusing them
+ * would only save issue bandwidth.
+ */
+static bool build_key(const RISCVInsnInfo *insns, int len, FusionKey *key,
+                      bool *dead)
+{
+    int i, j, op;
+
+    memset(key, 0, sizeof(*key));
+    key->len = len;
+    for (i = 0; i < len; i++) {
+        bool fed = false;
+
+        key->cls[i] = insns[i].id * 2 + (insns[i].len == 2);
+        for (op = 1; op <= 3 && i; op++) {
+            int r = reg_id(&insns[i], op);
+
+            /* the closest earlier writer is the producer */
+            for (j = i - 1; r >= 0 && j >= 0; j--) {
+                if (reg_id(&insns[j], 0) == r) {
+                    key->src[i][op - 1] = j + 1;
+                    fed = true;
+                    break;
+                }
+            }
+        }
+        if (i && !fed) {
+            return false;
+        }
+    }
 
+    /* intermediate results that are overwritten need no write back */
+    *dead = true;
+    for (i = 0; i < len - 1; i++) {
+        int r = reg_id(&insns[i], 0);
 
-static uint32_t unclassed_inst;
-static GHashTable* instTable; // InstInfoHash -> InstInfo
-static bool do_inline;
-static InstInfo* lastInfo;
+        for (j = i + 1; r >= 0 && j < len; j++) {
+            if (reg_id(&insns[j], 0) == r) {
+                break;
+            }
+        }
+        if (r >= 0 && j == len) {
+            *dead = false;
+        }
+    }
+    return true;
+}
 
-static void plugin_init(void)
+static uint64_t fusion_savings(const Fusion *f)
 {
-    instTable = g_hash_table_new(NULL, g_direct_equal);
-    for (size_t i=0; i < ARRAY_SIZE(riscv64_insns); i++) {
-        riscv64_insns[i].idx = i;
-    }
+    return f->count * (f->key.len - 1);
 }
 
-static void vcpu_insn_exec_before(unsigned int cpu_index, void *udata)
+static gint cmp_savings(gconstpointer a, gconstpointer b)
 {
-    uint64_t *count = (uint64_t *) udata;
-    (*count)++;
+    uint64_t sa = fusion_savings(a), sb = fusion_savings(b);
+
+    return sa > sb ? -1 : sa < sb;
 }
 
-static uint64_t *find_counter(struct qemu_plugin_insn *insn)
+static void append_sequence(GString *s, const FusionKey *key)
 {
-    InstInfo* thisInfo = NULL;
-    InstInfoHash thisHash;
-    uint32_t masked_bits;
-    InstPatternInfo* entry;
-    uint64_t* counter = NULL;
-    /*
-     * We only match the first 32 bits of the instruction which is
-     * fine for most RISCs but a bit limiting for CISC architectures.
-     * They would probably benefit from a more tailored plugin.
-     * However we can fall back to individual instruction counting.
-     */
-    uint32_t inst = *((uint32_t *)qemu_plugin_insn_data(insn));
-
-    for (size_t i = 0; i < ARRAY_SIZE(riscv64_insns); i++) {
-        entry = &riscv64_insns[i];
-        masked_bits = inst & entry->mask;
-        if (masked_bits == entry->pattern){
-            break;
+    int i, op;
+
+    for (i = 0; i < key->len; i++) {
+        const char *sep = "(";
+
+        g_string_append_printf(s, "%s%s%s", i ? ", " : "",
+                               key->cls[i] & 1 ? "c_" : "",
+                               riscv_insn_name(key->cls[i] >> 1));
+        for (op = 0; op < 3; op++) {
+            if (key->src[i][op]) {
+                g_string_append_printf(s, "%srs%d<%d", sep, op + 1,
+                                       key->src[i][op]);
+                sep = " ";
+            }
+        }
+        if (*sep != '(') {
+            g_string_append_c(s, ')');
         }
     }
+}
 
-    if (entry->mask == 0) {
-        unclassed_inst = inst;
-    }
+static void plugin_exit(qemu_plugin_id_t id, void *p)
+{
+    g_autoptr(GString) report = g_string_new("");
+    GHashTable *fusions = g_hash_table_new_full(fusion_key_hash,
+                                                fusion_key_equal,
+                                                NULL, g_free);
+    GList *list, *it;
+    GHashTableIter iter;
+    BlockInfo *bi;
+    uint64_t total = 0;
+    int i;
 
-    // find new inst, if not exists, create it
-    thisInfo = allocInstInfo(entry, inst);
-    thisHash = instInfoHash(thisInfo);
-    InstInfo* tmpInfo = (InstInfo*) g_hash_table_lookup(instTable, thisHash);
-    if (tmpInfo == NULL) {
-        g_hash_table_insert(instTable, thisHash, thisInfo);
-    } else {
-        freeInstInfo(thisInfo);
-        thisInfo = tmpInfo;
-    }
+    g_mutex_lock(&lock);
+    g_hash_table_iter_init(&iter, blocks);
+    while (g_hash_table_iter_next(&iter, NULL, (gpointer *) &bi)) {
+        uint64_t count = qemu_plugin_u64_sum(
+            qemu_plugin_scoreboard_u64(bi->exec_count));
+        size_t pos;
+        int len;
 
-    // if this is the first inst, neednot fusion counter
-    // otherwise, find fusion counter
-    if (lastInfo != NULL) {
-        if (lastInfo->follow_insts_cnt != NULL) {
-            counter = (uint64_t*) g_hash_table_lookup(lastInfo->follow_insts_cnt, thisHash);
-        } else {
-            lastInfo->follow_insts_cnt = g_hash_table_new(NULL, g_direct_equal);
+        if (!count) {
+            continue;
+        }
+        total += count * bi->n_insns;
+        for (pos = 0; pos < bi->n_insns; pos++) {
+            for (len = 2; len <= max_seq && pos + len <= bi->n_insns; len++) {
+                FusionKey key;
+                Fusion *f;
+                bool dead;
+
+                if (!build_key(&bi->insns[pos], len, &key, &dead)) {
+                    /* a longer run would not be connected either */
+                    break;
+                }
+                f = g_hash_table_lookup(fusions, &key);
+                if (!f) {
+                    f = g_new0(Fusion, 1);
+                    f->key = key;
+                    g_hash_table_insert(fusions, &f->key, f);
+                }
+                f->count += count;
+                if (dead) {
+                    f->dead_count += count;
+                }
+            }
         }
-        if (counter == NULL) {
-            counter = g_new0(uint64_t, 1);
-            g_hash_table_insert(lastInfo->follow_insts_cnt, thisHash, (gpointer)counter);
+    }
+    g_mutex_unlock(&lock);
+
+    g_string_printf(report, "dynamic instructions: %" PRIu64 "\n", total);
+    g_string_append_printf(report, "%u fusion candidates\n",
+                           g_hash_table_size(fusions));
+
+    list = g_list_sort(g_hash_table_get_values(fusions), cmp_savings);
+    if (list) {
+        g_string_append(report, "rank, count, dead, savings, share, "
+                        "sequence (rsN<P: operand fed by instruction P)\n");
+        for (i = 0, it = list; i < limit && it; i++, it = it->next) {
+            Fusion *f = it->data;
+
+            g_string_append_printf(report,
+                                   "%d, %" PRIu64 ", %" PRIu64 ", %" PRIu64
+                                   ", %.2f%%, ",
+                                   i + 1, f->count, f->dead_count,
+                                   fusion_savings(f),
+                                   total ? 100.0 * fusion_savings(f) / total
+                                         : 0);
+            append_sequence(report, &f->key);
+            g_string_append_c(report, '\n');
         }
+        g_list_free(list);
     }
-    // static value hold this inst info as last inst info
-    lastInfo = thisInfo;
+    g_hash_table_destroy(fusions);
 
-    return counter;
+    qemu_plugin_outs(report->str);
 }
 
-static void vcpu_tb_trans(qemu_plugin_id_t id, struct qemu_plugin_tb* tb)
+static void plugin_init(void)
 {
-    size_t n = qemu_plugin_tb_n_insns(tb);
-    size_t i;
-    for (i = 0; i < n; i++) {
-        uint64_t *cnt;
-        struct qemu_plugin_insn *insn = qemu_plugin_tb_get_insn(tb, i);
-        cnt = find_counter(insn);
-        if (cnt) {
-            qemu_plugin_register_vcpu_insn_exec_cb(
-                insn, vcpu_insn_exec_before, QEMU_PLUGIN_CB_NO_REGS, cnt);
-        }
-    }
+    blocks = g_hash_table_new(block_hash, block_equal);
 }
 
-static void print_inst(InstInfo* info)
+static void vcpu_tb_exec(unsigned int cpu_index, void *udata)
 {
-    g_autoptr(GString) report = g_string_new("");
-    switch (info->info->pattern_type) {
-        case PT_R:
-        case PT_SH5:
-        case PT_SH6:
-        case PT_CADD: // c.add
-        case PT_CMV: // c.mv
-            g_string_append_printf(report, "%s$rd@%hhu,$rs1@%hhu,$rs2@%hhu",
-                info->info->name,
-                info->rd,
-                info->rs1,
-                info->rs2
-            );
-            break;
-        case PT_JAL:
-            g_string_append_printf(report, "%s$rd@%hhu",
-                info->info->name,
-                info->rd
-            );
-            break;
-        case PT_B:
-        case PT_CB: // c.beqz, c.bnez
-        case PT_ST:
-        case PT_CST:
-        case PT_CSTSP:
-            g_string_append_printf(report, "%s$rs1@%hhu,$rs2@%hhu",
-                info->info->name,
-                info->rs1,
-                info->rs2
-            );
-            break;
-        case PT_LD:
-        case PT_CLD:
-        case PT_CLDSP:
-        case PT_I:
-        case PT_CIRD5: // c.addi, c.addiw, c.li, c.addi16sp, c.lui
-        case PT_CJALR: // c.jalr
-            g_string_append_printf(report, "%s$rd@%hhu,$rs1@%hhu",
-                info->info->name,
-                info->rd,
-                info->rs1
-            );
-            break;
-        case PT_CIRD3:
-            g_string_append_printf(report, "%s$rd@%hhu,$rs1@%hhu,$imm@%hhu",
-                info->info->name,
-                info->rd,
-                info->rs1,
-                info->imm
-            );
-            break;
-        case PT_SHI6:
-        case PT_SHI5:
-        case PT_CSHRD3: // c.srli, c.srai
-        case PT_CSHRD5: // c.slli
-        case PT_CSH64RD3: // c.srli64, c.srai64
-        case PT_CSH64RD5: // c.slli64
-            g_string_append_printf(report, "%s$rd@%hhu,$rs1@%hhu,$sh@%hhu",
-                info->info->name,
-                info->rd,
-                info->rs1,
-                info->shamt
-            );
-            break;
-        case PT_CJR: // c.jr
-            g_string_append_printf(report, "%s$rs1@%hhu",
-                info->info->name,
-                info->rs1
-            );
-            break;
-        default:
-            g_string_append_printf(report, "%s",
-                info->info->name
-            );
-            break;
-    }
-    qemu_plugin_outs(report->str);
+    BlockInfo *bi = (BlockInfo *) udata;
+
+    qemu_plugin_u64_add(qemu_plugin_scoreboard_u64(bi->exec_count),
+                        cpu_index, 1);
 }
 
-static void plugin_exit(qemu_plugin_id_t id, void* p)
+/*
+ * Instructions are classified once per block; execution only bumps the
+ * block's counter, inline when do_inline, each vCPU in its own
+ * scoreboard entry.
+ */
+static void vcpu_tb_trans(qemu_plugin_id_t id, struct qemu_plugin_tb *tb)
 {
-    // g_autoptr(GString) report = g_string_new("plugin_exit...\n");
-    // g_string_append_printf(report, "size of instTable: %u\n", g_hash_table_size(instTable));
-
-    GList* inst_it = g_hash_table_get_values(instTable);
-
-    for (GList* it = inst_it; it; it = it->next) {
-        InstInfo* thisInfo = (InstInfo*) it->data;
-        // g_string_append_printf(report, "size of %s's follow_insts: %u\n", thisInfo->info->name, g_hash_table_size(thisInfo->follow_insts_cnt));
-        GList* nit = g_hash_table_get_keys(thisInfo->follow_insts_cnt);
-        for (; nit; nit = nit->next) {
-            InstInfoHash nextHash = nit->data;
-            InstInfo* nextInfo = (InstInfo*) g_hash_table_lookup(instTable, nextHash);
-            uint64_t nextCnt = *(uint64_t*) g_hash_table_lookup(thisInfo->follow_insts_cnt, nextHash);
-            print_inst(thisInfo);
-            fprintf(stderr, "-");
-            print_inst(nextInfo);
-            fprintf(stderr, ":%lu\n", nextCnt);
-
-            // g_string_append_printf(report, ":%lu\n", nextCnt);
+    BlockInfo *bi;
+    BlockInfo key = {
+        .start_addr = qemu_plugin_tb_vaddr(tb),
+        .n_insns = qemu_plugin_tb_n_insns(tb),
+    };
+    size_t n = key.n_insns;
+    size_t i;
+
+    g_mutex_lock(&lock);
+    bi = (BlockInfo *) g_hash_table_lookup(blocks, &key);
+    if (!bi) {
+        bi = g_new0(BlockInfo, 1);
+        bi->start_addr = key.start_addr;
+        bi->n_insns = n;
+        bi->insns = g_new0(RISCVInsnInfo, n);
+        for (i = 0; i < n; i++) {
+            struct qemu_plugin_insn *insn = qemu_plugin_tb_get_insn(tb, i);
+            uint32_t inst = 0;
+
+            memcpy(&inst, qemu_plugin_insn_data(insn),
+                   MIN(qemu_plugin_insn_size(insn), sizeof(inst)));
+            riscv_classify(inst, &bi->insns[i]);
         }
+        bi->exec_count = qemu_plugin_scoreboard_new(sizeof(uint64_t));
+        g_hash_table_add(blocks, bi);
     }
+    g_mutex_unlock(&lock);
 
-
-    // qemu_plugin_outs(report->str);
+    if (do_inline) {
+        qemu_plugin_register_vcpu_tb_exec_inline_per_vcpu(
+            tb, QEMU_PLUGIN_INLINE_ADD_U64,
+            qemu_plugin_scoreboard_u64(bi->exec_count), 1);
+    } else {
+        qemu_plugin_register_vcpu_tb_exec_cb(tb, vcpu_tb_exec,
+                                             QEMU_PLUGIN_CB_NO_REGS,
+                                             (void *)bi);
+    }
 }
 
 QEMU_PLUGIN_EXPORT int qemu_plugin_install(qemu_plugin_id_t id,
@@ -493,6 +352,14 @@ QEMU_PLUGIN_EXPORT int qemu_plugin_install(qemu_plugin_id_t id,
                 fprintf(stderr, "boolean argument parsing failed: %s\n", p);
                 return -1;
             }
+        } else if (g_strcmp0(tokens[0], "maxlen") == 0) {
+            max_seq = tokens[1] ? atoi(tokens[1]) : 0;
+            if (max_seq < 2 || max_seq > MAX_SEQ) {
+                fprintf(stderr, "maxlen must be 2 or %d: %s\n", MAX_SEQ, p);
+                return -1;
+            }
+        } else if (g_strcmp0(tokens[0], "top") == 0) {
+            limit = tokens[1] ? g_ascii_strtoull(tokens[1], NULL, 10) : 0;
         } else {
             fprintf(stderr, "option parsing failed: %s\n", p);
             return -1;
@@ -505,4 +372,3 @@ QEMU_PLUGIN_EXPORT int qemu_plugin_install(qemu_plugin_id_t id,
     qemu_plugin_register_atexit_cb(id, plugin_exit, NULL);
     return 0;
 }
-
@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+#
+# Generate the instruction table of the RISC-V classifier used by the
+# contrib plugins, from the decoders scripts/decodetree.py builds out of
+# target/riscv/insn32.decode and insn16.decode.
+#
+# Every pattern gets an id and a trans_ function that records the id and
+# the operand fields in the classifier's DisasContext, so the generated
+# decoders classify an instruction in a single tree walk.
+#
+# License: GNU GPL, version 2 or later.
+#   See the COPYING file in the top-level directory.
+#
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+import re
+import sys
+
+re_argset = re.compile(r'typedef struct \{\n((?:    int \w+;\n)*)\} arg_(\w+);')
+re_alias = re.compile(r'typedef arg_(\w+) arg_(\w+);')
+
+# Patterns that only exist for RV128. Their trans_ functions fail so that
+# the decoder falls through to the RV64 pattern of the same group.
+RV128_ONLY = {'lq', 'sq'}
+
+# Patterns that encode reserved or illegal instructions
+ILLEGAL = {'illegal', 'c64_illegal'}
+
+REGS = ['rd', 'rs1', 'rs2', 'rs3']
+
+
+def fp_regs(name):
+    """Return the operands of instruction @name that are FP registers"""
+    if not name.startswith('f') or name.startswith('fence'):
+        return set()
+    base = name.split('_')
+    if base[0] in ('flw', 'fld', 'flh', 'flq'):
+        return {'rd'}
+    if base[0] in ('fsw', 'fsd', 'fsh', 'fsq'):
+        return {'rs2'}
+    if base[0] in ('feq', 'flt', 'fle', 'fclass'):
+        return {'rs1', 'rs2'}
+    if base[0] in ('fcvt', 'fmv'):
+        # fcvt_<to>_<from> and fmv_<to>_<from>
+        ints = ('x',) if base[0] == 'fmv' else ('w', 'wu', 'l', 'lu')
+        if base[1] in ints:
+            return {'rs1'}
+        if base[2] in ints:
+            return {'rd'}
+    return set(REGS)
+
+
+def vec_regs(name):
+    """Return the operands of instruction @name that are vector registers"""
+    if not name.startswith('v') or name.startswith('vset'):
+        return set()
+    # Approximation: scalar operands of .vx and .vi forms, and the base
+    # address of loads and stores, are reported as vector registers too.
+    return set(REGS)
+
+
+def main(args):
+    if len(args) != 3:
+        sys.stderr.write('usage: riscv-classify-gen.py HEADER INC DECODERS\n')
+        return 1
+    header_file, inc_file = args[0], args[1]
+
+    argsets = {}
+    insns = {}
+    for decoder in args[2].split(','):
+        with open(decoder) as f:
+            text = f.read()
+        for m in re_argset.finditer(text):
+            argsets[m.group(2)] = re.findall(r'int (\w+);', m.group(1))
+        for m in re_alias.finditer(text):
+            insns[m.group(2)] = m.group(1)
+
+    names = sorted(n for n in insns if n not in ILLEGAL)
+
+    with open(header_file, 'w') as out:
+        out.write('/* This file is autogenerated by riscv-classify-gen.py. */\n\n')
+        out.write('#ifndef RISCV_INSNS_H\n#define RISCV_INSNS_H\n\n')
+        out.write('enum RISCVInsnId {\n    RISCV_INSN_UNKNOWN,\n')
+        for n in names:
+            out.write('    RISCV_INSN_%s,\n' % n.upper())
+        out.write('    RISCV_INSN_COUNT\n};\n\n#endif\n')
+
+    with open(inc_file, 'w') as out:
+        out.write('/* This file is autogenerated by riscv-classify-gen.py. */\n\n')
+        out.write('static const char *const riscv_insn_names[] = {\n')
+        out.write('    [RISCV_INSN_UNKNOWN] = "unknown",\n')
+        for n in names:
+            out.write('    [RISCV_INSN_%s] = "%s",\n' % (n.upper(), n))
+        out.write('};\n')
+
+        for n in sorted(insns):
+            fields = argsets.get(insns[n], [])
+            out.write('\nstatic bool trans_%s(DisasContext *ctx, arg_%s *a)\n'
+                      '{\n' % (n, n))
+            if n in RV128_ONLY:
+                out.write('    return false;\n}\n')
+                continue
+            if n in ILLEGAL:
+                out.write('    ctx->info->id = RISCV_INSN_UNKNOWN;\n'
+                          '    return true;\n}\n')
+                continue
+            out.write('    ctx->info->id = RISCV_INSN_%s;\n' % n.upper())
+            fp, vec = fp_regs(n), vec_regs(n)
+            for r in REGS:
+                if r in fields:
+                    out.write('    ctx->info->%s = a->%s;\n' % (r, r))
+                    if r in fp:
+                        out.write('    ctx->info->flags |= RISCV_%s_FP;\n'
+                                  % r.upper())
+                    elif r in vec:
+                        out.write('    ctx->info->flags |= RISCV_%s_VEC;\n'
+                                  % r.upper())
+            for imm in ('imm', 'shamt', 'csr', 'zimm'):
+                if imm in fields:
+                    out.write('    ctx->info->imm = a->%s;\n' % imm)
+                    out.write('    ctx->info->flags |= RISCV_HAS_IMM;\n')
+                    break
+            out.write('    return true;\n}\n')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,92 @@
+/*
+ * RISC-V instruction classifier for plugins
+ *
+ * License: GNU GPL, version 2 or later.
+ *   See the COPYING file in the top-level directory.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "riscv-classify.h"
+
+/* What the generated decoders expect from target/riscv/translate.c */
+typedef struct DisasContext {
+    RISCVInsnInfo *info;
+} DisasContext;
+
+static inline uint32_t extract32(uint32_t value, int start, int length)
+{
+    return (value >> start) & (~0U >> (32 - length));
+}
+
+static inline int32_t sextract32(uint32_t value, int start, int length)
+{
+    return ((int32_t)(value << (32 - length - start))) >> (32 - length);
+}
+
+static inline uint32_t deposit32(uint32_t value, int start, int length,
+                                 uint32_t fieldval)
+{
+    uint32_t mask = (~0U >> (32 - length)) << start;
+    return (value & ~mask) | ((fieldval << start) & mask);
+}
+
+static int ex_plus_1(DisasContext *ctx, int nf)
+{
+    return nf + 1;
+}
+
+#define EX_SH(amount) \
+    static int ex_shift_##amount(DisasContext *ctx, int imm) \
+    {                                         \
+        return imm << amount;                 \
+    }
+EX_SH(1)
+EX_SH(2)
+EX_SH(3)
+EX_SH(4)
+EX_SH(12)
+
+static int ex_rvc_register(DisasContext *ctx, int reg)
+{
+    return 8 + reg;
+}
+
+static int ex_rvc_shifti(DisasContext *ctx, int imm)
+{
+    /* For RV128 a shamt of 0 means a shift by 64. */
+    return imm ? imm : 64;
+}
+
+#include "decode-insn32.c.inc"
+#include "decode-insn16.c.inc"
+#include "riscv-trans.c.inc"
+
+bool riscv_classify(uint32_t insn, RISCVInsnInfo *info)
+{
+    DisasContext ctx = { .info = info };
+    bool ok;
+
+    memset(info, 0, sizeof(*info));
+    info->rd = info->rs1 = info->rs2 = info->rs3 = -1;
+
+    if ((insn & 3) != 3) {
+        info->len = 2;
+        ok = decode_insn16(&ctx, insn & 0xffff);
+    } else {
+        info->len = 4;
+        ok = decode_insn32(&ctx, insn);
+    }
+
+    if (!ok || info->id == RISCV_INSN_UNKNOWN) {
+        info->id = RISCV_INSN_UNKNOWN;
+        return false;
+    }
+    return true;
+}
+
+const char *riscv_insn_name(enum RISCVInsnId id)
+{
+    return id < RISCV_INSN_COUNT ? riscv_insn_names[id] : "unknown";
+}
@@ -0,0 +1,60 @@
+/*
+ * RISC-V instruction classifier for plugins
+ *
+ * Instructions are classified by decoders generated from the same
+ * decodetree descriptions TCG uses, so classification is a single walk
+ * of the decode tree and the operands are exactly those the translator
+ * sees. Compressed instructions are classified as the instruction they
+ * expand to. Decoding follows RV64.
+ *
+ * License: GNU GPL, version 2 or later.
+ *   See the COPYING file in the top-level directory.
+ */
+#ifndef RISCV_CLASSIFY_H
+#define RISCV_CLASSIFY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "riscv-insns.h"
+
+/* Register operands that are not integer registers */
+#define RISCV_RD_FP     (1 << 0)
+#define RISCV_RS1_FP    (1 << 1)
+#define RISCV_RS2_FP    (1 << 2)
+#define RISCV_RS3_FP    (1 << 3)
+#define RISCV_RD_VEC    (1 << 4)
+#define RISCV_RS1_VEC   (1 << 5)
+#define RISCV_RS2_VEC   (1 << 6)
+#define RISCV_RS3_VEC   (1 << 7)
+/* @imm holds the immediate, shift amount or CSR number */
+#define RISCV_HAS_IMM   (1 << 8)
+
+typedef struct RISCVInsnInfo {
+    enum RISCVInsnId id;
+    uint8_t len;        /* 2 for compressed instructions, else 4 */
+    /* register numbers, -1 when the instruction has no such operand */
+    int8_t rd;
+    int8_t rs1;
+    int8_t rs2;
+    int8_t rs3;
+    uint16_t flags;
+    int32_t imm;
+} RISCVInsnInfo;
+
+/**
+ * riscv_classify() - classify an instruction
+ * @insn: the instruction, only the low 16 bits are used if compressed
+ * @info: filled with the classification
+ *
+ * Returns: true if @insn is a valid instruction
+ */
+bool riscv_classify(uint32_t insn, RISCVInsnInfo *info);
+
+/**
+ * riscv_insn_name() - name of an instruction id, e.g. "addi"
+ * @id: an instruction id
+ */
+const char *riscv_insn_name(enum RISCVInsnId id);
+
+#endif /* RISCV_CLASSIFY_H */
@@ -1,1398 +0,0 @@
-enum RV64Inst {
-rv64_ecall,
-rv64_ebreak,
-rv64_uret,
-rv64_sret,
-rv64_mret,
-rv64_wfi,
-rv64_sfence_vma,
-rv64_sfence_vm,
-rv64_lui,
-rv64_auipc,
-rv64_jal,
-rv64_jalr,
-rv64_beq,
-rv64_bne,
-rv64_blt,
-rv64_bge,
-rv64_bltu,
-rv64_bgeu,
-rv64_lb,
-rv64_lh,
-rv64_lw,
-rv64_lbu,
-rv64_lhu,
-rv64_sb,
-rv64_sh,
-rv64_sw,
-rv64_addi,
-rv64_slti,
-rv64_sltiu,
-rv64_xori,
-rv64_ori,
-rv64_andi,
-rv64_slli,
-rv64_srli,
-rv64_srai,
-rv64_add,
-rv64_sub,
-rv64_sll,
-rv64_slt,
-rv64_sltu,
-rv64_xor,
-rv64_srl,
-rv64_sra,
-rv64_or,
-rv64_and,
-rv64_fence,
-rv64_fence_i,
-rv64_csrrw,
-rv64_csrrs,
-rv64_csrrc,
-rv64_csrrwi,
-rv64_csrrsi,
-rv64_csrrci,
-rv64_lwu,
-rv64_ld,
-rv64_sd,
-rv64_addiw,
-rv64_slliw,
-rv64_srliw,
-rv64_sraiw,
-rv64_addw,
-rv64_subw,
-rv64_sllw,
-rv64_srlw,
-rv64_sraw,
-rv64_ldu,
-rv64_lq,
-rv64_sq,
-rv64_addid,
-rv64_sllid,
-rv64_srlid,
-rv64_sraid,
-rv64_addd,
-rv64_subd,
-rv64_slld,
-rv64_srld,
-rv64_srad,
-rv64_mul,
-rv64_mulh,
-rv64_mulhsu,
-rv64_mulhu,
-rv64_div,
-rv64_divu,
-rv64_rem,
-rv64_remu,
-rv64_mulw,
-rv64_divw,
-rv64_divuw,
-rv64_remw,
-rv64_remuw,
-rv64_muld,
-rv64_divd,
-rv64_divud,
-rv64_remd,
-rv64_remud,
-rv64_lr_w,
-rv64_sc_w,
-rv64_amoswap_w,
-rv64_amoadd_w,
-rv64_amoxor_w,
-rv64_amoand_w,
-rv64_amoor_w,
-rv64_amomin_w,
-rv64_amomax_w,
-rv64_amominu_w,
-rv64_amomaxu_w,
-rv64_lr_d,
-rv64_sc_d,
-rv64_amoswap_d,
-rv64_amoadd_d,
-rv64_amoxor_d,
-rv64_amoand_d,
-rv64_amoor_d,
-rv64_amomin_d,
-rv64_amomax_d,
-rv64_amominu_d,
-rv64_amomaxu_d,
-rv64_flw,
-rv64_fsw,
-rv64_fmadd_s,
-rv64_fmsub_s,
-rv64_fnmsub_s,
-rv64_fnmadd_s,
-rv64_fadd_s,
-rv64_fsub_s,
-rv64_fmul_s,
-rv64_fdiv_s,
-rv64_fsqrt_s,
-rv64_fsgnj_s,
-rv64_fsgnjn_s,
-rv64_fsgnjx_s,
-rv64_fmin_s,
-rv64_fmax_s,
-rv64_fcvt_w_s,
-rv64_fcvt_wu_s,
-rv64_fmv_x_w,
-rv64_feq_s,
-rv64_flt_s,
-rv64_fle_s,
-rv64_fclass_s,
-rv64_fcvt_s_w,
-rv64_fcvt_s_wu,
-rv64_fmv_w_x,
-rv64_fcvt_l_s,
-rv64_fcvt_lu_s,
-rv64_fcvt_s_l,
-rv64_fcvt_s_lu,
-rv64_fld,
-rv64_fsd,
-rv64_fmadd_d,
-rv64_fmsub_d,
-rv64_fnmsub_d,
-rv64_fnmadd_d,
-rv64_fadd_d,
-rv64_fsub_d,
-rv64_fmul_d,
-rv64_fdiv_d,
-rv64_fsqrt_d,
-rv64_fsgnj_d,
-rv64_fsgnjn_d,
-rv64_fsgnjx_d,
-rv64_fmin_d,
-rv64_fmax_d,
-rv64_fcvt_s_d,
-rv64_fcvt_d_s,
-rv64_feq_d,
-rv64_flt_d,
-rv64_fle_d,
-rv64_fclass_d,
-rv64_fcvt_w_d,
-rv64_fcvt_wu_d,
-rv64_fcvt_d_w,
-rv64_fcvt_d_wu,
-rv64_fcvt_l_d,
-rv64_fcvt_lu_d,
-rv64_fmv_x_d,
-rv64_fcvt_d_l,
-rv64_fcvt_d_lu,
-rv64_fmv_d_x,
-rv64_hlv_b,
-rv64_hlv_bu,
-rv64_hlv_h,
-rv64_hlv_hu,
-rv64_hlvx_hu,
-rv64_hlv_w,
-rv64_hlvx_wu,
-rv64_hsv_b,
-rv64_hsv_h,
-rv64_hsv_w,
-rv64_hfence_gvma,
-rv64_hfence_vvma,
-rv64_hlv_wu,
-rv64_hlv_d,
-rv64_hsv_d,
-rv64_vle8_v,
-rv64_vle16_v,
-rv64_vle32_v,
-rv64_vle64_v,
-rv64_vse8_v,
-rv64_vse16_v,
-rv64_vse32_v,
-rv64_vse64_v,
-rv64_vlm_v,
-rv64_vsm_v,
-rv64_vlse8_v,
-rv64_vlse16_v,
-rv64_vlse32_v,
-rv64_vlse64_v,
-rv64_vsse8_v,
-rv64_vsse16_v,
-rv64_vsse32_v,
-rv64_vsse64_v,
-rv64_vlxei8_v,
-rv64_vlxei16_v,
-rv64_vlxei32_v,
-rv64_vlxei64_v,
-rv64_vsxei8_v,
-rv64_vsxei16_v,
-rv64_vsxei32_v,
-rv64_vsxei64_v,
-rv64_vle8ff_v,
-rv64_vle16ff_v,
-rv64_vle32ff_v,
-rv64_vle64ff_v,
-rv64_vl1re8_v,
-rv64_vl1re16_v,
-rv64_vl1re32_v,
-rv64_vl1re64_v,
-rv64_vl2re8_v,
-rv64_vl2re16_v,
-rv64_vl2re32_v,
-rv64_vl2re64_v,
-rv64_vl4re8_v,
-rv64_vl4re16_v,
-rv64_vl4re32_v,
-rv64_vl4re64_v,
-rv64_vl8re8_v,
-rv64_vl8re16_v,
-rv64_vl8re32_v,
-rv64_vl8re64_v,
-rv64_vs1r_v,
-rv64_vs2r_v,
-rv64_vs4r_v,
-rv64_vs8r_v,
-rv64_vadd_vv,
-rv64_vadd_vx,
-rv64_vadd_vi,
-rv64_vsub_vv,
-rv64_vsub_vx,
-rv64_vrsub_vx,
-rv64_vrsub_vi,
-rv64_vwaddu_vv,
-rv64_vwaddu_vx,
-rv64_vwadd_vv,
-rv64_vwadd_vx,
-rv64_vwsubu_vv,
-rv64_vwsubu_vx,
-rv64_vwsub_vv,
-rv64_vwsub_vx,
-rv64_vwaddu_wv,
-rv64_vwaddu_wx,
-rv64_vwadd_wv,
-rv64_vwadd_wx,
-rv64_vwsubu_wv,
-rv64_vwsubu_wx,
-rv64_vwsub_wv,
-rv64_vwsub_wx,
-rv64_vadc_vvm,
-rv64_vadc_vxm,
-rv64_vadc_vim,
-rv64_vmadc_vvm,
-rv64_vmadc_vxm,
-rv64_vmadc_vim,
-rv64_vsbc_vvm,
-rv64_vsbc_vxm,
-rv64_vmsbc_vvm,
-rv64_vmsbc_vxm,
-rv64_vand_vv,
-rv64_vand_vx,
-rv64_vand_vi,
-rv64_vor_vv,
-rv64_vor_vx,
-rv64_vor_vi,
-rv64_vxor_vv,
-rv64_vxor_vx,
-rv64_vxor_vi,
-rv64_vsll_vv,
-rv64_vsll_vx,
-rv64_vsll_vi,
-rv64_vsrl_vv,
-rv64_vsrl_vx,
-rv64_vsrl_vi,
-rv64_vsra_vv,
-rv64_vsra_vx,
-rv64_vsra_vi,
-rv64_vnsrl_wv,
-rv64_vnsrl_wx,
-rv64_vnsrl_wi,
-rv64_vnsra_wv,
-rv64_vnsra_wx,
-rv64_vnsra_wi,
-rv64_vmseq_vv,
-rv64_vmseq_vx,
-rv64_vmseq_vi,
-rv64_vmsne_vv,
-rv64_vmsne_vx,
-rv64_vmsne_vi,
-rv64_vmsltu_vv,
-rv64_vmsltu_vx,
-rv64_vmslt_vv,
-rv64_vmslt_vx,
-rv64_vmsleu_vv,
-rv64_vmsleu_vx,
-rv64_vmsleu_vi,
-rv64_vmsle_vv,
-rv64_vmsle_vx,
-rv64_vmsle_vi,
-rv64_vmsgtu_vx,
-rv64_vmsgtu_vi,
-rv64_vmsgt_vx,
-rv64_vmsgt_vi,
-rv64_vminu_vv,
-rv64_vminu_vx,
-rv64_vmin_vv,
-rv64_vmin_vx,
-rv64_vmaxu_vv,
-rv64_vmaxu_vx,
-rv64_vmax_vv,
-rv64_vmax_vx,
-rv64_vmul_vv,
-rv64_vmul_vx,
-rv64_vmulh_vv,
-rv64_vmulh_vx,
-rv64_vmulhu_vv,
-rv64_vmulhu_vx,
-rv64_vmulhsu_vv,
-rv64_vmulhsu_vx,
-rv64_vdivu_vv,
-rv64_vdivu_vx,
-rv64_vdiv_vv,
-rv64_vdiv_vx,
-rv64_vremu_vv,
-rv64_vremu_vx,
-rv64_vrem_vv,
-rv64_vrem_vx,
-rv64_vwmulu_vv,
-rv64_vwmulu_vx,
-rv64_vwmulsu_vv,
-rv64_vwmulsu_vx,
-rv64_vwmul_vv,
-rv64_vwmul_vx,
-rv64_vmacc_vv,
-rv64_vmacc_vx,
-rv64_vnmsac_vv,
-rv64_vnmsac_vx,
-rv64_vmadd_vv,
-rv64_vmadd_vx,
-rv64_vnmsub_vv,
-rv64_vnmsub_vx,
-rv64_vwmaccu_vv,
-rv64_vwmaccu_vx,
-rv64_vwmacc_vv,
-rv64_vwmacc_vx,
-rv64_vwmaccsu_vv,
-rv64_vwmaccsu_vx,
-rv64_vwmaccus_vx,
-rv64_vmv_v_v,
-rv64_vmv_v_x,
-rv64_vmv_v_i,
-rv64_vmerge_vvm,
-rv64_vmerge_vxm,
-rv64_vmerge_vim,
-rv64_vsaddu_vv,
-rv64_vsaddu_vx,
-rv64_vsaddu_vi,
-rv64_vsadd_vv,
-rv64_vsadd_vx,
-rv64_vsadd_vi,
-rv64_vssubu_vv,
-rv64_vssubu_vx,
-rv64_vssub_vv,
-rv64_vssub_vx,
-rv64_vaadd_vv,
-rv64_vaadd_vx,
-rv64_vaaddu_vv,
-rv64_vaaddu_vx,
-rv64_vasub_vv,
-rv64_vasub_vx,
-rv64_vasubu_vv,
-rv64_vasubu_vx,
-rv64_vsmul_vv,
-rv64_vsmul_vx,
-rv64_vssrl_vv,
-rv64_vssrl_vx,
-rv64_vssrl_vi,
-rv64_vssra_vv,
-rv64_vssra_vx,
-rv64_vssra_vi,
-rv64_vnclipu_wv,
-rv64_vnclipu_wx,
-rv64_vnclipu_wi,
-rv64_vnclip_wv,
-rv64_vnclip_wx,
-rv64_vnclip_wi,
-rv64_vfadd_vv,
-rv64_vfadd_vf,
-rv64_vfsub_vv,
-rv64_vfsub_vf,
-rv64_vfrsub_vf,
-rv64_vfwadd_vv,
-rv64_vfwadd_vf,
-rv64_vfwadd_wv,
-rv64_vfwadd_wf,
-rv64_vfwsub_vv,
-rv64_vfwsub_vf,
-rv64_vfwsub_wv,
-rv64_vfwsub_wf,
-rv64_vfmul_vv,
-rv64_vfmul_vf,
-rv64_vfdiv_vv,
-rv64_vfdiv_vf,
-rv64_vfrdiv_vf,
-rv64_vfwmul_vv,
-rv64_vfwmul_vf,
-rv64_vfmacc_vv,
-rv64_vfnmacc_vv,
-rv64_vfnmacc_vf,
-rv64_vfmacc_vf,
-rv64_vfmsac_vv,
-rv64_vfmsac_vf,
-rv64_vfnmsac_vv,
-rv64_vfnmsac_vf,
-rv64_vfmadd_vv,
-rv64_vfmadd_vf,
-rv64_vfnmadd_vv,
-rv64_vfnmadd_vf,
-rv64_vfmsub_vv,
-rv64_vfmsub_vf,
-rv64_vfnmsub_vv,
-rv64_vfnmsub_vf,
-rv64_vfwmacc_vv,
-rv64_vfwmacc_vf,
-rv64_vfwnmacc_vv,
-rv64_vfwnmacc_vf,
-rv64_vfwmsac_vv,
-rv64_vfwmsac_vf,
-rv64_vfwnmsac_vv,
-rv64_vfwnmsac_vf,
-rv64_vfsqrt_v,
-rv64_vfrsqrt7_v,
-rv64_vfrec7_v,
-rv64_vfmin_vv,
-rv64_vfmin_vf,
-rv64_vfmax_vv,
-rv64_vfmax_vf,
-rv64_vfsgnj_vv,
-rv64_vfsgnj_vf,
-rv64_vfsgnjn_vv,
-rv64_vfsgnjn_vf,
-rv64_vfsgnjx_vv,
-rv64_vfsgnjx_vf,
-rv64_vfslide1up_vf,
-rv64_vfslide1down_vf,
-rv64_vmfeq_vv,
-rv64_vmfeq_vf,
-rv64_vmfne_vv,
-rv64_vmfne_vf,
-rv64_vmflt_vv,
-rv64_vmflt_vf,
-rv64_vmfle_vv,
-rv64_vmfle_vf,
-rv64_vmfgt_vf,
-rv64_vmfge_vf,
-rv64_vfclass_v,
-rv64_vfmerge_vfm,
-rv64_vfmv_v_f,
-rv64_vfcvt_xu_f_v,
-rv64_vfcvt_x_f_v,
-rv64_vfcvt_f_xu_v,
-rv64_vfcvt_f_x_v,
-rv64_vfcvt_rtz_xu_f_v,
-rv64_vfcvt_rtz_x_f_v,
-rv64_vfwcvt_xu_f_v,
-rv64_vfwcvt_x_f_v,
-rv64_vfwcvt_f_xu_v,
-rv64_vfwcvt_f_x_v,
-rv64_vfwcvt_f_f_v,
-rv64_vfwcvt_rtz_xu_f_v,
-rv64_vfwcvt_rtz_x_f_v,
-rv64_vfncvt_xu_f_w,
-rv64_vfncvt_x_f_w,
-rv64_vfncvt_f_xu_w,
-rv64_vfncvt_f_x_w,
-rv64_vfncvt_f_f_w,
-rv64_vfncvt_rod_f_f_w,
-rv64_vfncvt_rtz_xu_f_w,
-rv64_vfncvt_rtz_x_f_w,
-rv64_vredsum_vs,
-rv64_vredand_vs,
-rv64_vredor_vs,
-rv64_vredxor_vs,
-rv64_vredminu_vs,
-rv64_vredmin_vs,
-rv64_vredmaxu_vs,
-rv64_vredmax_vs,
-rv64_vwredsumu_vs,
-rv64_vwredsum_vs,
-rv64_vfredsum_vs,
-rv64_vfredmin_vs,
-rv64_vfredmax_vs,
-rv64_vfwredsum_vs,
-rv64_vmand_mm,
-rv64_vmnand_mm,
-rv64_vmandn_mm,
-rv64_vmxor_mm,
-rv64_vmor_mm,
-rv64_vmnor_mm,
-rv64_vmorn_mm,
-rv64_vmxnor_mm,
-rv64_vcpop_m,
-rv64_vfirst_m,
-rv64_vmsbf_m,
-rv64_vmsif_m,
-rv64_vmsof_m,
-rv64_viota_m,
-rv64_vid_v,
-rv64_vmv_x_s,
-rv64_vmv_s_x,
-rv64_vfmv_f_s,
-rv64_vfmv_s_f,
-rv64_vslideup_vx,
-rv64_vslideup_vi,
-rv64_vslide1up_vx,
-rv64_vslidedown_vx,
-rv64_vslidedown_vi,
-rv64_vslide1down_vx,
-rv64_vrgather_vv,
-rv64_vrgatherei16_vv,
-rv64_vrgather_vx,
-rv64_vrgather_vi,
-rv64_vcompress_vm,
-rv64_vmv1r_v,
-rv64_vmv2r_v,
-rv64_vmv4r_v,
-rv64_vmv8r_v,
-rv64_vzext_vf2,
-rv64_vzext_vf4,
-rv64_vzext_vf8,
-rv64_vsext_vf2,
-rv64_vsext_vf4,
-rv64_vsext_vf8,
-rv64_vsetvli,
-rv64_vsetivli,
-rv64_vsetvl,
-rv64_sh1add,
-rv64_sh2add,
-rv64_sh3add,
-rv64_add_uw,
-rv64_sh1add_uw,
-rv64_sh2add_uw,
-rv64_sh3add_uw,
-rv64_slli_uw,
-rv64_andn,
-rv64_clz,
-rv64_cpop,
-rv64_ctz,
-rv64_max,
-rv64_maxu,
-rv64_min,
-rv64_minu,
-rv64_orc_b,
-rv64_orn,
-rv64_rev8_32,
-rv64_rol,
-rv64_ror,
-rv64_rori,
-rv64_sext_b,
-rv64_sext_h,
-rv64_xnor,
-rv64_zext_h_32,
-rv64_clzw,
-rv64_ctzw,
-rv64_cpopw,
-rv64_rev8_64,
-rv64_rolw,
-rv64_roriw,
-rv64_rorw,
-rv64_zext_h_64,
-rv64_clmul,
-rv64_clmulh,
-rv64_clmulr,
-rv64_bclr,
-rv64_bclri,
-rv64_bext,
-rv64_bexti,
-rv64_binv,
-rv64_binvi,
-rv64_bset,
-rv64_bseti,
-rv64_flh,
-rv64_fsh,
-rv64_fmadd_h,
-rv64_fmsub_h,
-rv64_fnmsub_h,
-rv64_fnmadd_h,
-rv64_fadd_h,
-rv64_fsub_h,
-rv64_fmul_h,
-rv64_fdiv_h,
-rv64_fsqrt_h,
-rv64_fsgnj_h,
-rv64_fsgnjn_h,
-rv64_fsgnjx_h,
-rv64_fmin_h,
-rv64_fmax_h,
-rv64_fcvt_h_s,
-rv64_fcvt_s_h,
-rv64_fcvt_h_d,
-rv64_fcvt_d_h,
-rv64_fcvt_w_h,
-rv64_fcvt_wu_h,
-rv64_fmv_x_h,
-rv64_feq_h,
-rv64_flt_h,
-rv64_fle_h,
-rv64_fclass_h,
-rv64_fcvt_h_w,
-rv64_fcvt_h_wu,
-rv64_fmv_h_x,
-rv64_fcvt_l_h,
-rv64_fcvt_lu_h,
-rv64_fcvt_h_l,
-rv64_fcvt_h_lu,
-rv64_c_addi4spn,
-rv64_c_fld,
-rv64_c_lw,
-rv64_c_ld,
-rv64_c_fsd,
-rv64_c_sw,
-rv64_c_sd,
-rv64_c_nop,
-rv64_c_addi,
-rv64_c_addiw,
-rv64_c_li,
-rv64_c_addi16sp,
-rv64_c_lui,
-rv64_c_srli64,
-rv64_c_srli,
-rv64_c_srai64,
-rv64_c_srai,
-rv64_c_andi,
-rv64_c_sub,
-rv64_c_xor,
-rv64_c_or,
-rv64_c_and,
-rv64_c_subw,
-rv64_c_addw,
-rv64_c_j,
-rv64_c_beqz,
-rv64_c_bnez,
-rv64_c_slli64,
-rv64_c_slli,
-rv64_c_fldsp,
-rv64_c_lwsp,
-rv64_c_ldsp,
-rv64_c_jr,
-rv64_c_mv,
-rv64_c_break,
-rv64_c_jalr,
-rv64_c_add,
-rv64_c_fdsp,
-rv64_c_swsp,
-rv64_c_sdsp,
-};
-
-typedef struct InstPatternInfo
-{
-    const char* type;
-    const char* name;
-    uint32_t mask;
-    uint32_t pattern;
-    uint8_t pattern_type;
-    uint16_t idx;
-    uint64_t cnt;
-    GHashTable *follow_insts;
-} InstPatternInfo;
-
-enum PatternType {
-    PT_NONE,
-    PT_R,
-    PT_JAL,
-    PT_B,
-    PT_I,
-    PT_LD,
-    PT_ST,
-    PT_SH6,
-    PT_SH5,
-    PT_SHI6,
-    PT_SHI5,
-    PT_CADDI4SPN,
-    PT_CIRD5,
-    PT_CIRD3,
-    PT_CR,
-    PT_CLD,
-    PT_CST,
-    PT_CB,
-    PT_CSHRD5,
-    PT_CSHRD3,
-    PT_CSH64RD5,
-    PT_CSH64RD3,
-    PT_CLDSP,
-    PT_CSTSP,
-    PT_CADD,
-    PT_CMV,
-    PT_CJR,
-    PT_CJALR
-};
-
-static InstPatternInfo riscv64_insns[] = {
-    {        "ecall",               "ecall", 0xffffffff, 0x00000073, PT_NONE},
-    {       "ebreak",              "ebreak", 0xffffffff, 0x00100073, PT_NONE},
-    {          "ret",                "uret", 0xffffffff, 0x00200073, PT_NONE},
-    {          "ret",                "sret", 0xffffffff, 0x10200073, PT_NONE},
-    {          "ret",                "mret", 0xffffffff, 0x30200073, PT_NONE},
-    {          "wfi",                 "wfi", 0xffffffff, 0x10500073, PT_NONE},
-    {   "sfence_vma",          "sfence_vma", 0xfe007fff, 0x12000073, PT_NONE},
-    {    "sfence_vm",           "sfence_vm", 0xfff07fff, 0x10400073, PT_NONE},
-    {    "data_move",                 "lui", 0x0000007f, 0x00000037, PT_I   },
-    {          "alu",               "auipc", 0x0000007f, 0x00000017, PT_NONE},
-    {            "j",                 "jal", 0x0000007f, 0x0000006f, PT_JAL },
-    {            "i",                "jalr", 0x0000707f, 0x00000067, PT_I   },
-    {            "b",                 "beq", 0x0000707f, 0x00000063, PT_B   },
-    {            "b",                 "bne", 0x0000707f, 0x00001063, PT_B   },
-    {            "b",                 "blt", 0x0000707f, 0x00004063, PT_B   },
-    {            "b",                 "bge", 0x0000707f, 0x00005063, PT_B   },
-    {            "b",                "bltu", 0x0000707f, 0x00006063, PT_B   },
-    {            "b",                "bgeu", 0x0000707f, 0x00007063, PT_B   },
-    {            "i",                  "lb", 0x0000707f, 0x00000003, PT_LD  },
-    {            "i",                  "lh", 0x0000707f, 0x00001003, PT_LD  },
-    {            "i",                  "lw", 0x0000707f, 0x00002003, PT_LD  },
-    {            "i",                 "lbu", 0x0000707f, 0x00004003, PT_LD  },
-    {            "i",                 "lhu", 0x0000707f, 0x00005003, PT_LD  },
-    {            "s",                  "sb", 0x0000707f, 0x00000023, PT_ST  },
-    {            "s",                  "sh", 0x0000707f, 0x00001023, PT_ST  },
-    {            "s",                  "sw", 0x0000707f, 0x00002023, PT_ST  },
-    {            "i",                "addi", 0x0000707f, 0x00000013, PT_I   },
-    {            "i",                "slti", 0x0000707f, 0x00002013, PT_I   },
-    {            "i",               "sltiu", 0x0000707f, 0x00003013, PT_I   },
-    {            "i",                "xori", 0x0000707f, 0x00004013, PT_I   },
-    {            "i",                 "ori", 0x0000707f, 0x00006013, PT_I   },
-    {            "i",                "andi", 0x0000707f, 0x00007013, PT_I   },
-    {           "sh",                "slli", 0xf800707f, 0x00001013, PT_SHI6},
-    {           "sh",                "srli", 0xf800707f, 0x00005013, PT_SHI6},
-    {           "sh",                "srai", 0xf800707f, 0x40005013, PT_SHI6},
-    {            "r",                 "add", 0xfe00707f, 0x00000033, PT_R   },
-    {            "r",                 "sub", 0xfe00707f, 0x40000033, PT_R   },
-    {            "r",                 "sll", 0xfe00707f, 0x00001033, PT_SH6 },
-    {            "r",                 "slt", 0xfe00707f, 0x00002033, PT_R   },
-    {            "r",                "sltu", 0xfe00707f, 0x00003033, PT_R   },
-    {            "r",                 "xor", 0xfe00707f, 0x00004033, PT_R   },
-    {            "r",                 "srl", 0xfe00707f, 0x00005033, PT_SH6 },
-    {            "r",                 "sra", 0xfe00707f, 0x40005033, PT_SH6 },
-    {            "r",                  "or", 0xfe00707f, 0x00006033, PT_R   },
-    {            "r",                 "and", 0xfe00707f, 0x00007033, PT_R   },
-    {"decode_Fmt_32",               "fence", 0x0000707f, 0x0000000f, PT_NONE},
-    {"decode_Fmt_31",             "fence_i", 0x0000707f, 0x0000100f, PT_NONE},
-    {          "csr",               "csrrw", 0x0000707f, 0x00001073, PT_NONE},
-    {          "csr",               "csrrs", 0x0000707f, 0x00002073, PT_NONE},
-    {          "csr",               "csrrc", 0x0000707f, 0x00003073, PT_NONE},
-    {          "csr",              "csrrwi", 0x0000707f, 0x00005073, PT_NONE},
-    {          "csr",              "csrrsi", 0x0000707f, 0x00006073, PT_NONE},
-    {          "csr",              "csrrci", 0x0000707f, 0x00007073, PT_NONE},
-    {            "i",                 "lwu", 0x0000707f, 0x00006003, PT_LD  },
-    {            "i",                  "ld", 0x0000707f, 0x00003003, PT_LD  },
-    {            "s",                  "sd", 0x0000707f, 0x00003023, PT_ST  },
-    {            "i",               "addiw", 0x0000707f, 0x0000001b, PT_I   },
-    {          "sh5",               "slliw", 0xfe00707f, 0x0000101b, PT_SHI5},
-    {          "sh5",               "srliw", 0xfe00707f, 0x0000501b, PT_SHI5},
-    {          "sh5",               "sraiw", 0xfe00707f, 0x4000501b, PT_SHI5},
-    {            "r",                "addw", 0xfe00707f, 0x0000003b, PT_R   },
-    {            "r",                "subw", 0xfe00707f, 0x4000003b, PT_R   },
-    {            "r",                "sllw", 0xfe00707f, 0x0000103b, PT_SH5 },
-    {            "r",                "srlw", 0xfe00707f, 0x0000503b, PT_SH5 },
-    {            "r",                "sraw", 0xfe00707f, 0x4000503b, PT_SH5 },
-    {            "i",                 "ldu", 0x0000707f, 0x00007003, PT_LD  },
-    {            "i",                  "lq", 0x0000707f, 0x0000200f, PT_LD  },
-    {            "s",                  "sq", 0x0000707f, 0x00004023, PT_ST  },
-    {            "i",               "addid", 0x0000707f, 0x0000005b, PT_NONE},
-    {          "sh6",               "sllid", 0xfc00707f, 0x0000105b, PT_NONE},
-    {          "sh6",               "srlid", 0xfc00707f, 0x0000505b, PT_NONE},
-    {          "sh6",               "sraid", 0xfc00707f, 0x4000505b, PT_NONE},
-    {            "r",                "addd", 0xfe00707f, 0x0000007b, PT_NONE},
-    {            "r",                "subd", 0xfe00707f, 0x4000007b, PT_NONE},
-    {            "r",                "slld", 0xfe00707f, 0x0000107b, PT_NONE},
-    {            "r",                "srld", 0xfe00707f, 0x0000507b, PT_NONE},
-    {            "r",                "srad", 0xfe00707f, 0x4000507b, PT_NONE},
-    {            "r",                 "mul", 0xfe00707f, 0x02000033, PT_R   },
-    {            "r",                "mulh", 0xfe00707f, 0x02001033, PT_R   },
-    {            "r",              "mulhsu", 0xfe00707f, 0x02002033, PT_R   },
-    {            "r",               "mulhu", 0xfe00707f, 0x02003033, PT_R   },
-    {            "r",                 "div", 0xfe00707f, 0x02004033, PT_R   },
-    {            "r",                "divu", 0xfe00707f, 0x02005033, PT_R   },
-    {            "r",                 "rem", 0xfe00707f, 0x02006033, PT_R   },
-    {            "r",                "remu", 0xfe00707f, 0x02007033, PT_R   },
-    {            "r",                "mulw", 0xfe00707f, 0x0200003b, PT_R   },
-    {            "r",                "divw", 0xfe00707f, 0x0200403b, PT_R   },
-    {            "r",               "divuw", 0xfe00707f, 0x0200503b, PT_R   },
-    {            "r",                "remw", 0xfe00707f, 0x0200603b, PT_R   },
-    {            "r",               "remuw", 0xfe00707f, 0x0200703b, PT_R   },
-    {            "r",                "muld", 0xfe00707f, 0x0200007b, PT_R   },
-    {            "r",                "divd", 0xfe00707f, 0x0200407b, PT_R   },
-    {            "r",               "divud", 0xfe00707f, 0x0200507b, PT_R   },
-    {            "r",                "remd", 0xfe00707f, 0x0200607b, PT_R   },
-    {            "r",               "remud", 0xfe00707f, 0x0200707b, PT_NONE},
-    {      "atom_ld",                "lr_w", 0xf9f0707f, 0x1000202f, PT_NONE},
-    {      "atom_st",                "sc_w", 0xf800707f, 0x1800202f, PT_NONE},
-    {      "atom_st",           "amoswap_w", 0xf800707f, 0x0800202f, PT_NONE},
-    {      "atom_st",            "amoadd_w", 0xf800707f, 0x0000202f, PT_NONE},
-    {      "atom_st",            "amoxor_w", 0xf800707f, 0x2000202f, PT_NONE},
-    {      "atom_st",            "amoand_w", 0xf800707f, 0x6000202f, PT_NONE},
-    {      "atom_st",             "amoor_w", 0xf800707f, 0x4000202f, PT_NONE},
-    {      "atom_st",            "amomin_w", 0xf800707f, 0x8000202f, PT_NONE},
-    {      "atom_st",            "amomax_w", 0xf800707f, 0xa000202f, PT_NONE},
-    {      "atom_st",           "amominu_w", 0xf800707f, 0xc000202f, PT_NONE},
-    {      "atom_st",           "amomaxu_w", 0xf800707f, 0xe000202f, PT_NONE},
-    {      "atom_ld",                "lr_d", 0xf9f0707f, 0x1000302f, PT_NONE},
-    {      "atom_st",                "sc_d", 0xf800707f, 0x1800302f, PT_NONE},
-    {      "atom_st",           "amoswap_d", 0xf800707f, 0x0800302f, PT_NONE},
-    {      "atom_st",            "amoadd_d", 0xf800707f, 0x0000302f, PT_NONE},
-    {      "atom_st",            "amoxor_d", 0xf800707f, 0x2000302f, PT_NONE},
-    {      "atom_st",            "amoand_d", 0xf800707f, 0x6000302f, PT_NONE},
-    {      "atom_st",             "amoor_d", 0xf800707f, 0x4000302f, PT_NONE},
-    {      "atom_st",            "amomin_d", 0xf800707f, 0x8000302f, PT_NONE},
-    {      "atom_st",            "amomax_d", 0xf800707f, 0xa000302f, PT_NONE},
-    {      "atom_st",           "amominu_d", 0xf800707f, 0xc000302f, PT_NONE},
-    {      "atom_st",           "amomaxu_d", 0xf800707f, 0xe000302f, PT_NONE},
-    {            "i",                 "flw", 0x0000707f, 0x00002007, PT_LD  },
-    {            "s",                 "fsw", 0x0000707f, 0x00002027, PT_ST  },
-    {        "r4_rm",             "fmadd_s", 0x0600007f, 0x00000043, PT_NONE},
-    {        "r4_rm",             "fmsub_s", 0x0600007f, 0x00000047, PT_NONE},
-    {        "r4_rm",            "fnmsub_s", 0x0600007f, 0x0000004b, PT_NONE},
-    {        "r4_rm",            "fnmadd_s", 0x0600007f, 0x0000004f, PT_NONE},
-    {         "r_rm",              "fadd_s", 0xfe00007f, 0x00000053, PT_NONE},
-    {         "r_rm",              "fsub_s", 0xfe00007f, 0x08000053, PT_NONE},
-    {         "r_rm",              "fmul_s", 0xfe00007f, 0x10000053, PT_NONE},
-    {         "r_rm",              "fdiv_s", 0xfe00007f, 0x18000053, PT_NONE},
-    {        "r2_rm",             "fsqrt_s", 0xfff0007f, 0x58000053, PT_NONE},
-    {            "r",             "fsgnj_s", 0xfe00707f, 0x20000053, PT_NONE},
-    {            "r",            "fsgnjn_s", 0xfe00707f, 0x20001053, PT_NONE},
-    {            "r",            "fsgnjx_s", 0xfe00707f, 0x20002053, PT_NONE},
-    {            "r",              "fmin_s", 0xfe00707f, 0x28000053, PT_NONE},
-    {            "r",              "fmax_s", 0xfe00707f, 0x28001053, PT_NONE},
-    {        "r2_rm",            "fcvt_w_s", 0xfff0007f, 0xc0000053, PT_NONE},
-    {        "r2_rm",           "fcvt_wu_s", 0xfff0007f, 0xc0100053, PT_NONE},
-    {           "r2",             "fmv_x_w", 0xfff0707f, 0xe0000053, PT_NONE},
-    {            "r",               "feq_s", 0xfe00707f, 0xa0002053, PT_NONE},
-    {            "r",               "flt_s", 0xfe00707f, 0xa0001053, PT_NONE},
-    {            "r",               "fle_s", 0xfe00707f, 0xa0000053, PT_NONE},
-    {           "r2",            "fclass_s", 0xfff0707f, 0xe0001053, PT_NONE},
-    {        "r2_rm",            "fcvt_s_w", 0xfff0007f, 0xd0000053, PT_NONE},
-    {        "r2_rm",           "fcvt_s_wu", 0xfff0007f, 0xd0100053, PT_NONE},
-    {           "r2",             "fmv_w_x", 0xfff0707f, 0xf0000053, PT_NONE},
-    {        "r2_rm",            "fcvt_l_s", 0xfff0007f, 0xc0200053, PT_NONE},
-    {        "r2_rm",           "fcvt_lu_s", 0xfff0007f, 0xc0300053, PT_NONE},
-    {        "r2_rm",            "fcvt_s_l", 0xfff0007f, 0xd0200053, PT_NONE},
-    {        "r2_rm",           "fcvt_s_lu", 0xfff0007f, 0xd0300053, PT_NONE},
-    {            "i",                 "fld", 0x0000707f, 0x00003007, PT_LD  },
-    {            "s",                 "fsd", 0x0000707f, 0x00003027, PT_ST  },
-    {        "r4_rm",             "fmadd_d", 0x0600007f, 0x02000043, PT_NONE},
-    {        "r4_rm",             "fmsub_d", 0x0600007f, 0x02000047, PT_NONE},
-    {        "r4_rm",            "fnmsub_d", 0x0600007f, 0x0200004b, PT_NONE},
-    {        "r4_rm",            "fnmadd_d", 0x0600007f, 0x0200004f, PT_NONE},
-    {         "r_rm",              "fadd_d", 0xfe00007f, 0x02000053, PT_NONE},
-    {         "r_rm",              "fsub_d", 0xfe00007f, 0x0a000053, PT_NONE},
-    {         "r_rm",              "fmul_d", 0xfe00007f, 0x12000053, PT_NONE},
-    {         "r_rm",              "fdiv_d", 0xfe00007f, 0x1a000053, PT_NONE},
-    {        "r2_rm",             "fsqrt_d", 0xfff0007f, 0x5a000053, PT_NONE},
-    {            "r",             "fsgnj_d", 0xfe00707f, 0x22000053, PT_NONE},
-    {            "r",            "fsgnjn_d", 0xfe00707f, 0x22001053, PT_NONE},
-    {            "r",            "fsgnjx_d", 0xfe00707f, 0x22002053, PT_NONE},
-    {            "r",              "fmin_d", 0xfe00707f, 0x2a000053, PT_NONE},
-    {            "r",              "fmax_d", 0xfe00707f, 0x2a001053, PT_NONE},
-    {        "r2_rm",            "fcvt_s_d", 0xfff0007f, 0x40100053, PT_NONE},
-    {        "r2_rm",            "fcvt_d_s", 0xfff0007f, 0x42000053, PT_NONE},
-    {            "r",               "feq_d", 0xfe00707f, 0xa2002053, PT_NONE},
-    {            "r",               "flt_d", 0xfe00707f, 0xa2001053, PT_NONE},
-    {            "r",               "fle_d", 0xfe00707f, 0xa2000053, PT_NONE},
-    {           "r2",            "fclass_d", 0xfff0707f, 0xe2001053, PT_NONE},
-    {        "r2_rm",            "fcvt_w_d", 0xfff0007f, 0xc2000053, PT_NONE},
-    {        "r2_rm",           "fcvt_wu_d", 0xfff0007f, 0xc2100053, PT_NONE},
-    {        "r2_rm",            "fcvt_d_w", 0xfff0007f, 0xd2000053, PT_NONE},
-    {        "r2_rm",           "fcvt_d_wu", 0xfff0007f, 0xd2100053, PT_NONE},
-    {        "r2_rm",            "fcvt_l_d", 0xfff0007f, 0xc2200053, PT_NONE},
-    {        "r2_rm",           "fcvt_lu_d", 0xfff0007f, 0xc2300053, PT_NONE},
-    {           "r2",             "fmv_x_d", 0xfff0707f, 0xe2000053, PT_NONE},
-    {        "r2_rm",            "fcvt_d_l", 0xfff0007f, 0xd2200053, PT_NONE},
-    {        "r2_rm",           "fcvt_d_lu", 0xfff0007f, 0xd2300053, PT_NONE},
-    {           "r2",             "fmv_d_x", 0xfff0707f, 0xf2000053, PT_NONE},
-    {           "r2",               "hlv_b", 0xfff0707f, 0x60004073, PT_NONE},
-    {           "r2",              "hlv_bu", 0xfff0707f, 0x60104073, PT_NONE},
-    {           "r2",               "hlv_h", 0xfff0707f, 0x64004073, PT_NONE},
-    {           "r2",              "hlv_hu", 0xfff0707f, 0x64104073, PT_NONE},
-    {           "r2",             "hlvx_hu", 0xfff0707f, 0x64304073, PT_NONE},
-    {           "r2",               "hlv_w", 0xfff0707f, 0x68004073, PT_NONE},
-    {           "r2",             "hlvx_wu", 0xfff0707f, 0x68304073, PT_NONE},
-    {         "r2_s",               "hsv_b", 0xfe007fff, 0x62004073, PT_NONE},
-    {         "r2_s",               "hsv_h", 0xfe007fff, 0x66004073, PT_NONE},
-    {         "r2_s",               "hsv_w", 0xfe007fff, 0x6a004073, PT_NONE},
-    {  "hfence_gvma",         "hfence_gvma", 0xfe007fff, 0x62000073, PT_NONE},
-    {  "hfence_vvma",         "hfence_vvma", 0xfe007fff, 0x22000073, PT_NONE},
-    {           "r2",              "hlv_wu", 0xfff0707f, 0x68104073, PT_NONE},
-    {           "r2",               "hlv_d", 0xfff0707f, 0x6c004073, PT_NONE},
-    {         "r2_s",               "hsv_d", 0xfe007fff, 0x6e004073, PT_NONE},
-    {      "r2_nfvm",              "vle8_v", 0x1df0707f, 0x00000007, PT_NONE},
-    {      "r2_nfvm",             "vle16_v", 0x1df0707f, 0x00005007, PT_NONE},
-    {      "r2_nfvm",             "vle32_v", 0x1df0707f, 0x00006007, PT_NONE},
-    {      "r2_nfvm",             "vle64_v", 0x1df0707f, 0x00007007, PT_NONE},
-    {      "r2_nfvm",              "vse8_v", 0x1df0707f, 0x00000027, PT_NONE},
-    {      "r2_nfvm",             "vse16_v", 0x1df0707f, 0x00005027, PT_NONE},
-    {      "r2_nfvm",             "vse32_v", 0x1df0707f, 0x00006027, PT_NONE},
-    {      "r2_nfvm",             "vse64_v", 0x1df0707f, 0x00007027, PT_NONE},
-    {           "r2",               "vlm_v", 0xfff0707f, 0x02b00007, PT_NONE},
-    {           "r2",               "vsm_v", 0xfff0707f, 0x02b00027, PT_NONE},
-    {       "r_nfvm",             "vlse8_v", 0x1c00707f, 0x08000007, PT_NONE},
-    {       "r_nfvm",            "vlse16_v", 0x1c00707f, 0x08005007, PT_NONE},
-    {       "r_nfvm",            "vlse32_v", 0x1c00707f, 0x08006007, PT_NONE},
-    {       "r_nfvm",            "vlse64_v", 0x1c00707f, 0x08007007, PT_NONE},
-    {       "r_nfvm",             "vsse8_v", 0x1c00707f, 0x08000027, PT_NONE},
-    {       "r_nfvm",            "vsse16_v", 0x1c00707f, 0x08005027, PT_NONE},
-    {       "r_nfvm",            "vsse32_v", 0x1c00707f, 0x08006027, PT_NONE},
-    {       "r_nfvm",            "vsse64_v", 0x1c00707f, 0x08007027, PT_NONE},
-    {       "r_nfvm",            "vlxei8_v", 0x1400707f, 0x04000007, PT_NONE},
-    {       "r_nfvm",           "vlxei16_v", 0x1400707f, 0x04005007, PT_NONE},
-    {       "r_nfvm",           "vlxei32_v", 0x1400707f, 0x04006007, PT_NONE},
-    {       "r_nfvm",           "vlxei64_v", 0x1400707f, 0x04007007, PT_NONE},
-    {       "r_nfvm",            "vsxei8_v", 0x1400707f, 0x04000027, PT_NONE},
-    {       "r_nfvm",           "vsxei16_v", 0x1400707f, 0x04005027, PT_NONE},
-    {       "r_nfvm",           "vsxei32_v", 0x1400707f, 0x04006027, PT_NONE},
-    {       "r_nfvm",           "vsxei64_v", 0x1400707f, 0x04007027, PT_NONE},
-    {      "r2_nfvm",            "vle8ff_v", 0x1df0707f, 0x01000007, PT_NONE},
-    {      "r2_nfvm",           "vle16ff_v", 0x1df0707f, 0x01005007, PT_NONE},
-    {      "r2_nfvm",           "vle32ff_v", 0x1df0707f, 0x01006007, PT_NONE},
-    {      "r2_nfvm",           "vle64ff_v", 0x1df0707f, 0x01007007, PT_NONE},
-    {           "r2",            "vl1re8_v", 0xfff0707f, 0x02800007, PT_NONE},
-    {           "r2",           "vl1re16_v", 0xfff0707f, 0x02805007, PT_NONE},
-    {           "r2",           "vl1re32_v", 0xfff0707f, 0x02806007, PT_NONE},
-    {           "r2",           "vl1re64_v", 0xfff0707f, 0x02807007, PT_NONE},
-    {           "r2",            "vl2re8_v", 0xfff0707f, 0x22800007, PT_NONE},
-    {           "r2",           "vl2re16_v", 0xfff0707f, 0x22805007, PT_NONE},
-    {           "r2",           "vl2re32_v", 0xfff0707f, 0x22806007, PT_NONE},
-    {           "r2",           "vl2re64_v", 0xfff0707f, 0x22807007, PT_NONE},
-    {           "r2",            "vl4re8_v", 0xfff0707f, 0x62800007, PT_NONE},
-    {           "r2",           "vl4re16_v", 0xfff0707f, 0x62805007, PT_NONE},
-    {           "r2",           "vl4re32_v", 0xfff0707f, 0x62806007, PT_NONE},
-    {           "r2",           "vl4re64_v", 0xfff0707f, 0x62807007, PT_NONE},
-    {           "r2",            "vl8re8_v", 0xfff0707f, 0xe2800007, PT_NONE},
-    {           "r2",           "vl8re16_v", 0xfff0707f, 0xe2805007, PT_NONE},
-    {           "r2",           "vl8re32_v", 0xfff0707f, 0xe2806007, PT_NONE},
-    {           "r2",           "vl8re64_v", 0xfff0707f, 0xe2807007, PT_NONE},
-    {           "r2",              "vs1r_v", 0xfff0707f, 0x02800027, PT_NONE},
-    {           "r2",              "vs2r_v", 0xfff0707f, 0x22800027, PT_NONE},
-    {           "r2",              "vs4r_v", 0xfff0707f, 0x62800027, PT_NONE},
-    {           "r2",              "vs8r_v", 0xfff0707f, 0xe2800027, PT_NONE},
-    {         "r_vm",             "vadd_vv", 0xfc00707f, 0x00000057, PT_NONE},
-    {         "r_vm",             "vadd_vx", 0xfc00707f, 0x00004057, PT_NONE},
-    {         "r_vm",             "vadd_vi", 0xfc00707f, 0x00003057, PT_NONE},
-    {         "r_vm",             "vsub_vv", 0xfc00707f, 0x08000057, PT_NONE},
-    {         "r_vm",             "vsub_vx", 0xfc00707f, 0x08004057, PT_NONE},
-    {         "r_vm",            "vrsub_vx", 0xfc00707f, 0x0c004057, PT_NONE},
-    {         "r_vm",            "vrsub_vi", 0xfc00707f, 0x0c003057, PT_NONE},
-    {         "r_vm",           "vwaddu_vv", 0xfc00707f, 0xc0002057, PT_NONE},
-    {         "r_vm",           "vwaddu_vx", 0xfc00707f, 0xc0006057, PT_NONE},
-    {         "r_vm",            "vwadd_vv", 0xfc00707f, 0xc4002057, PT_NONE},
-    {         "r_vm",            "vwadd_vx", 0xfc00707f, 0xc4006057, PT_NONE},
-    {         "r_vm",           "vwsubu_vv", 0xfc00707f, 0xc8002057, PT_NONE},
-    {         "r_vm",           "vwsubu_vx", 0xfc00707f, 0xc8006057, PT_NONE},
-    {         "r_vm",            "vwsub_vv", 0xfc00707f, 0xcc002057, PT_NONE},
-    {         "r_vm",            "vwsub_vx", 0xfc00707f, 0xcc006057, PT_NONE},
-    {         "r_vm",           "vwaddu_wv", 0xfc00707f, 0xd0002057, PT_NONE},
-    {         "r_vm",           "vwaddu_wx", 0xfc00707f, 0xd0006057, PT_NONE},
-    {         "r_vm",            "vwadd_wv", 0xfc00707f, 0xd4002057, PT_NONE},
-    {         "r_vm",            "vwadd_wx", 0xfc00707f, 0xd4006057, PT_NONE},
-    {         "r_vm",           "vwsubu_wv", 0xfc00707f, 0xd8002057, PT_NONE},
-    {         "r_vm",           "vwsubu_wx", 0xfc00707f, 0xd8006057, PT_NONE},
-    {         "r_vm",            "vwsub_wv", 0xfc00707f, 0xdc002057, PT_NONE},
-    {         "r_vm",            "vwsub_wx", 0xfc00707f, 0xdc006057, PT_NONE},
-    {       "r_vm_1",            "vadc_vvm", 0xfe00707f, 0x40000057, PT_NONE},
-    {       "r_vm_1",            "vadc_vxm", 0xfe00707f, 0x40004057, PT_NONE},
-    {       "r_vm_1",            "vadc_vim", 0xfe00707f, 0x40003057, PT_NONE},
-    {         "r_vm",           "vmadc_vvm", 0xfc00707f, 0x44000057, PT_NONE},
-    {         "r_vm",           "vmadc_vxm", 0xfc00707f, 0x44004057, PT_NONE},
-    {         "r_vm",           "vmadc_vim", 0xfc00707f, 0x44003057, PT_NONE},
-    {       "r_vm_1",            "vsbc_vvm", 0xfe00707f, 0x48000057, PT_NONE},
-    {       "r_vm_1",            "vsbc_vxm", 0xfe00707f, 0x48004057, PT_NONE},
-    {         "r_vm",           "vmsbc_vvm", 0xfc00707f, 0x4c000057, PT_NONE},
-    {         "r_vm",           "vmsbc_vxm", 0xfc00707f, 0x4c004057, PT_NONE},
-    {         "r_vm",             "vand_vv", 0xfc00707f, 0x24000057, PT_NONE},
-    {         "r_vm",             "vand_vx", 0xfc00707f, 0x24004057, PT_NONE},
-    {         "r_vm",             "vand_vi", 0xfc00707f, 0x24003057, PT_NONE},
-    {         "r_vm",              "vor_vv", 0xfc00707f, 0x28000057, PT_NONE},
-    {         "r_vm",              "vor_vx", 0xfc00707f, 0x28004057, PT_NONE},
-    {         "r_vm",              "vor_vi", 0xfc00707f, 0x28003057, PT_NONE},
-    {         "r_vm",             "vxor_vv", 0xfc00707f, 0x2c000057, PT_NONE},
-    {         "r_vm",             "vxor_vx", 0xfc00707f, 0x2c004057, PT_NONE},
-    {         "r_vm",             "vxor_vi", 0xfc00707f, 0x2c003057, PT_NONE},
-    {         "r_vm",             "vsll_vv", 0xfc00707f, 0x94000057, PT_NONE},
-    {         "r_vm",             "vsll_vx", 0xfc00707f, 0x94004057, PT_NONE},
-    {         "r_vm",             "vsll_vi", 0xfc00707f, 0x94003057, PT_NONE},
-    {         "r_vm",             "vsrl_vv", 0xfc00707f, 0xa0000057, PT_NONE},
-    {         "r_vm",             "vsrl_vx", 0xfc00707f, 0xa0004057, PT_NONE},
-    {         "r_vm",             "vsrl_vi", 0xfc00707f, 0xa0003057, PT_NONE},
-    {         "r_vm",             "vsra_vv", 0xfc00707f, 0xa4000057, PT_NONE},
-    {         "r_vm",             "vsra_vx", 0xfc00707f, 0xa4004057, PT_NONE},
-    {         "r_vm",             "vsra_vi", 0xfc00707f, 0xa4003057, PT_NONE},
-    {         "r_vm",            "vnsrl_wv", 0xfc00707f, 0xb0000057, PT_NONE},
-    {         "r_vm",            "vnsrl_wx", 0xfc00707f, 0xb0004057, PT_NONE},
-    {         "r_vm",            "vnsrl_wi", 0xfc00707f, 0xb0003057, PT_NONE},
-    {         "r_vm",            "vnsra_wv", 0xfc00707f, 0xb4000057, PT_NONE},
-    {         "r_vm",            "vnsra_wx", 0xfc00707f, 0xb4004057, PT_NONE},
-    {         "r_vm",            "vnsra_wi", 0xfc00707f, 0xb4003057, PT_NONE},
-    {         "r_vm",            "vmseq_vv", 0xfc00707f, 0x60000057, PT_NONE},
-    {         "r_vm",            "vmseq_vx", 0xfc00707f, 0x60004057, PT_NONE},
-    {         "r_vm",            "vmseq_vi", 0xfc00707f, 0x60003057, PT_NONE},
-    {         "r_vm",            "vmsne_vv", 0xfc00707f, 0x64000057, PT_NONE},
-    {         "r_vm",            "vmsne_vx", 0xfc00707f, 0x64004057, PT_NONE},
-    {         "r_vm",            "vmsne_vi", 0xfc00707f, 0x64003057, PT_NONE},
-    {         "r_vm",           "vmsltu_vv", 0xfc00707f, 0x68000057, PT_NONE},
-    {         "r_vm",           "vmsltu_vx", 0xfc00707f, 0x68004057, PT_NONE},
-    {         "r_vm",            "vmslt_vv", 0xfc00707f, 0x6c000057, PT_NONE},
-    {         "r_vm",            "vmslt_vx", 0xfc00707f, 0x6c004057, PT_NONE},
-    {         "r_vm",           "vmsleu_vv", 0xfc00707f, 0x70000057, PT_NONE},
-    {         "r_vm",           "vmsleu_vx", 0xfc00707f, 0x70004057, PT_NONE},
-    {         "r_vm",           "vmsleu_vi", 0xfc00707f, 0x70003057, PT_NONE},
-    {         "r_vm",            "vmsle_vv", 0xfc00707f, 0x74000057, PT_NONE},
-    {         "r_vm",            "vmsle_vx", 0xfc00707f, 0x74004057, PT_NONE},
-    {         "r_vm",            "vmsle_vi", 0xfc00707f, 0x74003057, PT_NONE},
-    {         "r_vm",           "vmsgtu_vx", 0xfc00707f, 0x78004057, PT_NONE},
-    {         "r_vm",           "vmsgtu_vi", 0xfc00707f, 0x78003057, PT_NONE},
-    {         "r_vm",            "vmsgt_vx", 0xfc00707f, 0x7c004057, PT_NONE},
-    {         "r_vm",            "vmsgt_vi", 0xfc00707f, 0x7c003057, PT_NONE},
-    {         "r_vm",            "vminu_vv", 0xfc00707f, 0x10000057, PT_NONE},
-    {         "r_vm",            "vminu_vx", 0xfc00707f, 0x10004057, PT_NONE},
-    {         "r_vm",             "vmin_vv", 0xfc00707f, 0x14000057, PT_NONE},
-    {         "r_vm",             "vmin_vx", 0xfc00707f, 0x14004057, PT_NONE},
-    {         "r_vm",            "vmaxu_vv", 0xfc00707f, 0x18000057, PT_NONE},
-    {         "r_vm",            "vmaxu_vx", 0xfc00707f, 0x18004057, PT_NONE},
-    {         "r_vm",             "vmax_vv", 0xfc00707f, 0x1c000057, PT_NONE},
-    {         "r_vm",             "vmax_vx", 0xfc00707f, 0x1c004057, PT_NONE},
-    {         "r_vm",             "vmul_vv", 0xfc00707f, 0x94002057, PT_NONE},
-    {         "r_vm",             "vmul_vx", 0xfc00707f, 0x94006057, PT_NONE},
-    {         "r_vm",            "vmulh_vv", 0xfc00707f, 0x9c002057, PT_NONE},
-    {         "r_vm",            "vmulh_vx", 0xfc00707f, 0x9c006057, PT_NONE},
-    {         "r_vm",           "vmulhu_vv", 0xfc00707f, 0x90002057, PT_NONE},
-    {         "r_vm",           "vmulhu_vx", 0xfc00707f, 0x90006057, PT_NONE},
-    {         "r_vm",          "vmulhsu_vv", 0xfc00707f, 0x98002057, PT_NONE},
-    {         "r_vm",          "vmulhsu_vx", 0xfc00707f, 0x98006057, PT_NONE},
-    {         "r_vm",            "vdivu_vv", 0xfc00707f, 0x80002057, PT_NONE},
-    {         "r_vm",            "vdivu_vx", 0xfc00707f, 0x80006057, PT_NONE},
-    {         "r_vm",             "vdiv_vv", 0xfc00707f, 0x84002057, PT_NONE},
-    {         "r_vm",             "vdiv_vx", 0xfc00707f, 0x84006057, PT_NONE},
-    {         "r_vm",            "vremu_vv", 0xfc00707f, 0x88002057, PT_NONE},
-    {         "r_vm",            "vremu_vx", 0xfc00707f, 0x88006057, PT_NONE},
-    {         "r_vm",             "vrem_vv", 0xfc00707f, 0x8c002057, PT_NONE},
-    {         "r_vm",             "vrem_vx", 0xfc00707f, 0x8c006057, PT_NONE},
-    {         "r_vm",           "vwmulu_vv", 0xfc00707f, 0xe0002057, PT_NONE},
-    {         "r_vm",           "vwmulu_vx", 0xfc00707f, 0xe0006057, PT_NONE},
-    {         "r_vm",          "vwmulsu_vv", 0xfc00707f, 0xe8002057, PT_NONE},
-    {         "r_vm",          "vwmulsu_vx", 0xfc00707f, 0xe8006057, PT_NONE},
-    {         "r_vm",            "vwmul_vv", 0xfc00707f, 0xec002057, PT_NONE},
-    {         "r_vm",            "vwmul_vx", 0xfc00707f, 0xec006057, PT_NONE},
-    {         "r_vm",            "vmacc_vv", 0xfc00707f, 0xb4002057, PT_NONE},
-    {         "r_vm",            "vmacc_vx", 0xfc00707f, 0xb4006057, PT_NONE},
-    {         "r_vm",           "vnmsac_vv", 0xfc00707f, 0xbc002057, PT_NONE},
-    {         "r_vm",           "vnmsac_vx", 0xfc00707f, 0xbc006057, PT_NONE},
-    {         "r_vm",            "vmadd_vv", 0xfc00707f, 0xa4002057, PT_NONE},
-    {         "r_vm",            "vmadd_vx", 0xfc00707f, 0xa4006057, PT_NONE},
-    {         "r_vm",           "vnmsub_vv", 0xfc00707f, 0xac002057, PT_NONE},
-    {         "r_vm",           "vnmsub_vx", 0xfc00707f, 0xac006057, PT_NONE},
-    {         "r_vm",          "vwmaccu_vv", 0xfc00707f, 0xf0002057, PT_NONE},
-    {         "r_vm",          "vwmaccu_vx", 0xfc00707f, 0xf0006057, PT_NONE},
-    {         "r_vm",           "vwmacc_vv", 0xfc00707f, 0xf4002057, PT_NONE},
-    {         "r_vm",           "vwmacc_vx", 0xfc00707f, 0xf4006057, PT_NONE},
-    {         "r_vm",         "vwmaccsu_vv", 0xfc00707f, 0xfc002057, PT_NONE},
-    {         "r_vm",         "vwmaccsu_vx", 0xfc00707f, 0xfc006057, PT_NONE},
-    {         "r_vm",         "vwmaccus_vx", 0xfc00707f, 0xf8006057, PT_NONE},
-    {           "r2",             "vmv_v_v", 0xfff0707f, 0x5e000057, PT_NONE},
-    {           "r2",             "vmv_v_x", 0xfff0707f, 0x5e004057, PT_NONE},
-    {           "r2",             "vmv_v_i", 0xfff0707f, 0x5e003057, PT_NONE},
-    {       "r_vm_0",          "vmerge_vvm", 0xfe00707f, 0x5c000057, PT_NONE},
-    {       "r_vm_0",          "vmerge_vxm", 0xfe00707f, 0x5c004057, PT_NONE},
-    {       "r_vm_0",          "vmerge_vim", 0xfe00707f, 0x5c003057, PT_NONE},
-    {         "r_vm",           "vsaddu_vv", 0xfc00707f, 0x80000057, PT_NONE},
-    {         "r_vm",           "vsaddu_vx", 0xfc00707f, 0x80004057, PT_NONE},
-    {         "r_vm",           "vsaddu_vi", 0xfc00707f, 0x80003057, PT_NONE},
-    {         "r_vm",            "vsadd_vv", 0xfc00707f, 0x84000057, PT_NONE},
-    {         "r_vm",            "vsadd_vx", 0xfc00707f, 0x84004057, PT_NONE},
-    {         "r_vm",            "vsadd_vi", 0xfc00707f, 0x84003057, PT_NONE},
-    {         "r_vm",           "vssubu_vv", 0xfc00707f, 0x88000057, PT_NONE},
-    {         "r_vm",           "vssubu_vx", 0xfc00707f, 0x88004057, PT_NONE},
-    {         "r_vm",            "vssub_vv", 0xfc00707f, 0x8c000057, PT_NONE},
-    {         "r_vm",            "vssub_vx", 0xfc00707f, 0x8c004057, PT_NONE},
-    {         "r_vm",            "vaadd_vv", 0xfc00707f, 0x24002057, PT_NONE},
-    {         "r_vm",            "vaadd_vx", 0xfc00707f, 0x24006057, PT_NONE},
-    {         "r_vm",           "vaaddu_vv", 0xfc00707f, 0x20002057, PT_NONE},
-    {         "r_vm",           "vaaddu_vx", 0xfc00707f, 0x20006057, PT_NONE},
-    {         "r_vm",            "vasub_vv", 0xfc00707f, 0x2c002057, PT_NONE},
-    {         "r_vm",            "vasub_vx", 0xfc00707f, 0x2c006057, PT_NONE},
-    {         "r_vm",           "vasubu_vv", 0xfc00707f, 0x28002057, PT_NONE},
-    {         "r_vm",           "vasubu_vx", 0xfc00707f, 0x28006057, PT_NONE},
-    {         "r_vm",            "vsmul_vv", 0xfc00707f, 0x9c000057, PT_NONE},
-    {         "r_vm",            "vsmul_vx", 0xfc00707f, 0x9c004057, PT_NONE},
-    {         "r_vm",            "vssrl_vv", 0xfc00707f, 0xa8000057, PT_NONE},
-    {         "r_vm",            "vssrl_vx", 0xfc00707f, 0xa8004057, PT_NONE},
-    {         "r_vm",            "vssrl_vi", 0xfc00707f, 0xa8003057, PT_NONE},
-    {         "r_vm",            "vssra_vv", 0xfc00707f, 0xac000057, PT_NONE},
-    {         "r_vm",            "vssra_vx", 0xfc00707f, 0xac004057, PT_NONE},
-    {         "r_vm",            "vssra_vi", 0xfc00707f, 0xac003057, PT_NONE},
-    {         "r_vm",          "vnclipu_wv", 0xfc00707f, 0xb8000057, PT_NONE},
-    {         "r_vm",          "vnclipu_wx", 0xfc00707f, 0xb8004057, PT_NONE},
-    {         "r_vm",          "vnclipu_wi", 0xfc00707f, 0xb8003057, PT_NONE},
-    {         "r_vm",           "vnclip_wv", 0xfc00707f, 0xbc000057, PT_NONE},
-    {         "r_vm",           "vnclip_wx", 0xfc00707f, 0xbc004057, PT_NONE},
-    {         "r_vm",           "vnclip_wi", 0xfc00707f, 0xbc003057, PT_NONE},
-    {         "r_vm",            "vfadd_vv", 0xfc00707f, 0x00001057, PT_NONE},
-    {         "r_vm",            "vfadd_vf", 0xfc00707f, 0x00005057, PT_NONE},
-    {         "r_vm",            "vfsub_vv", 0xfc00707f, 0x08001057, PT_NONE},
-    {         "r_vm",            "vfsub_vf", 0xfc00707f, 0x08005057, PT_NONE},
-    {         "r_vm",           "vfrsub_vf", 0xfc00707f, 0x9c005057, PT_NONE},
-    {         "r_vm",           "vfwadd_vv", 0xfc00707f, 0xc0001057, PT_NONE},
-    {         "r_vm",           "vfwadd_vf", 0xfc00707f, 0xc0005057, PT_NONE},
-    {         "r_vm",           "vfwadd_wv", 0xfc00707f, 0xd0001057, PT_NONE},
-    {         "r_vm",           "vfwadd_wf", 0xfc00707f, 0xd0005057, PT_NONE},
-    {         "r_vm",           "vfwsub_vv", 0xfc00707f, 0xc8001057, PT_NONE},
-    {         "r_vm",           "vfwsub_vf", 0xfc00707f, 0xc8005057, PT_NONE},
-    {         "r_vm",           "vfwsub_wv", 0xfc00707f, 0xd8001057, PT_NONE},
-    {         "r_vm",           "vfwsub_wf", 0xfc00707f, 0xd8005057, PT_NONE},
-    {         "r_vm",            "vfmul_vv", 0xfc00707f, 0x90001057, PT_NONE},
-    {         "r_vm",            "vfmul_vf", 0xfc00707f, 0x90005057, PT_NONE},
-    {         "r_vm",            "vfdiv_vv", 0xfc00707f, 0x80001057, PT_NONE},
-    {         "r_vm",            "vfdiv_vf", 0xfc00707f, 0x80005057, PT_NONE},
-    {         "r_vm",           "vfrdiv_vf", 0xfc00707f, 0x84005057, PT_NONE},
-    {         "r_vm",           "vfwmul_vv", 0xfc00707f, 0xe0001057, PT_NONE},
-    {         "r_vm",           "vfwmul_vf", 0xfc00707f, 0xe0005057, PT_NONE},
-    {         "r_vm",           "vfmacc_vv", 0xfc00707f, 0xb0001057, PT_NONE},
-    {         "r_vm",          "vfnmacc_vv", 0xfc00707f, 0xb4001057, PT_NONE},
-    {         "r_vm",          "vfnmacc_vf", 0xfc00707f, 0xb4005057, PT_NONE},
-    {         "r_vm",           "vfmacc_vf", 0xfc00707f, 0xb0005057, PT_NONE},
-    {         "r_vm",           "vfmsac_vv", 0xfc00707f, 0xb8001057, PT_NONE},
-    {         "r_vm",           "vfmsac_vf", 0xfc00707f, 0xb8005057, PT_NONE},
-    {         "r_vm",          "vfnmsac_vv", 0xfc00707f, 0xbc001057, PT_NONE},
-    {         "r_vm",          "vfnmsac_vf", 0xfc00707f, 0xbc005057, PT_NONE},
-    {         "r_vm",           "vfmadd_vv", 0xfc00707f, 0xa0001057, PT_NONE},
-    {         "r_vm",           "vfmadd_vf", 0xfc00707f, 0xa0005057, PT_NONE},
-    {         "r_vm",          "vfnmadd_vv", 0xfc00707f, 0xa4001057, PT_NONE},
-    {         "r_vm",          "vfnmadd_vf", 0xfc00707f, 0xa4005057, PT_NONE},
-    {         "r_vm",           "vfmsub_vv", 0xfc00707f, 0xa8001057, PT_NONE},
-    {         "r_vm",           "vfmsub_vf", 0xfc00707f, 0xa8005057, PT_NONE},
-    {         "r_vm",          "vfnmsub_vv", 0xfc00707f, 0xac001057, PT_NONE},
-    {         "r_vm",          "vfnmsub_vf", 0xfc00707f, 0xac005057, PT_NONE},
-    {         "r_vm",          "vfwmacc_vv", 0xfc00707f, 0xf0001057, PT_NONE},
-    {         "r_vm",          "vfwmacc_vf", 0xfc00707f, 0xf0005057, PT_NONE},
-    {         "r_vm",         "vfwnmacc_vv", 0xfc00707f, 0xf4001057, PT_NONE},
-    {         "r_vm",         "vfwnmacc_vf", 0xfc00707f, 0xf4005057, PT_NONE},
-    {         "r_vm",          "vfwmsac_vv", 0xfc00707f, 0xf8001057, PT_NONE},
-    {         "r_vm",          "vfwmsac_vf", 0xfc00707f, 0xf8005057, PT_NONE},
-    {         "r_vm",         "vfwnmsac_vv", 0xfc00707f, 0xfc001057, PT_NONE},
-    {         "r_vm",         "vfwnmsac_vf", 0xfc00707f, 0xfc005057, PT_NONE},
-    {        "r2_vm",            "vfsqrt_v", 0xfc0ff07f, 0x4c001057, PT_NONE},
-    {        "r2_vm",          "vfrsqrt7_v", 0xfc0ff07f, 0x4c021057, PT_NONE},
-    {        "r2_vm",            "vfrec7_v", 0xfc0ff07f, 0x4c029057, PT_NONE},
-    {         "r_vm",            "vfmin_vv", 0xfc00707f, 0x10001057, PT_NONE},
-    {         "r_vm",            "vfmin_vf", 0xfc00707f, 0x10005057, PT_NONE},
-    {         "r_vm",            "vfmax_vv", 0xfc00707f, 0x18001057, PT_NONE},
-    {         "r_vm",            "vfmax_vf", 0xfc00707f, 0x18005057, PT_NONE},
-    {         "r_vm",           "vfsgnj_vv", 0xfc00707f, 0x20001057, PT_NONE},
-    {         "r_vm",           "vfsgnj_vf", 0xfc00707f, 0x20005057, PT_NONE},
-    {         "r_vm",          "vfsgnjn_vv", 0xfc00707f, 0x24001057, PT_NONE},
-    {         "r_vm",          "vfsgnjn_vf", 0xfc00707f, 0x24005057, PT_NONE},
-    {         "r_vm",          "vfsgnjx_vv", 0xfc00707f, 0x28001057, PT_NONE},
-    {         "r_vm",          "vfsgnjx_vf", 0xfc00707f, 0x28005057, PT_NONE},
-    {         "r_vm",       "vfslide1up_vf", 0xfc00707f, 0x38005057, PT_NONE},
-    {         "r_vm",     "vfslide1down_vf", 0xfc00707f, 0x3c005057, PT_NONE},
-    {         "r_vm",            "vmfeq_vv", 0xfc00707f, 0x60001057, PT_NONE},
-    {         "r_vm",            "vmfeq_vf", 0xfc00707f, 0x60005057, PT_NONE},
-    {         "r_vm",            "vmfne_vv", 0xfc00707f, 0x70001057, PT_NONE},
-    {         "r_vm",            "vmfne_vf", 0xfc00707f, 0x70005057, PT_NONE},
-    {         "r_vm",            "vmflt_vv", 0xfc00707f, 0x6c001057, PT_NONE},
-    {         "r_vm",            "vmflt_vf", 0xfc00707f, 0x6c005057, PT_NONE},
-    {         "r_vm",            "vmfle_vv", 0xfc00707f, 0x64001057, PT_NONE},
-    {         "r_vm",            "vmfle_vf", 0xfc00707f, 0x64005057, PT_NONE},
-    {         "r_vm",            "vmfgt_vf", 0xfc00707f, 0x74005057, PT_NONE},
-    {         "r_vm",            "vmfge_vf", 0xfc00707f, 0x7c005057, PT_NONE},
-    {        "r2_vm",           "vfclass_v", 0xfc0ff07f, 0x4c081057, PT_NONE},
-    {       "r_vm_0",         "vfmerge_vfm", 0xfe00707f, 0x5c005057, PT_NONE},
-    {           "r2",            "vfmv_v_f", 0xfff0707f, 0x5e005057, PT_NONE},
-    {        "r2_vm",        "vfcvt_xu_f_v", 0xfc0ff07f, 0x48001057, PT_NONE},
-    {        "r2_vm",         "vfcvt_x_f_v", 0xfc0ff07f, 0x48009057, PT_NONE},
-    {        "r2_vm",        "vfcvt_f_xu_v", 0xfc0ff07f, 0x48011057, PT_NONE},
-    {        "r2_vm",         "vfcvt_f_x_v", 0xfc0ff07f, 0x48019057, PT_NONE},
-    {        "r2_vm",    "vfcvt_rtz_xu_f_v", 0xfc0ff07f, 0x48031057, PT_NONE},
-    {        "r2_vm",     "vfcvt_rtz_x_f_v", 0xfc0ff07f, 0x48039057, PT_NONE},
-    {        "r2_vm",       "vfwcvt_xu_f_v", 0xfc0ff07f, 0x48041057, PT_NONE},
-    {        "r2_vm",        "vfwcvt_x_f_v", 0xfc0ff07f, 0x48049057, PT_NONE},
-    {        "r2_vm",       "vfwcvt_f_xu_v", 0xfc0ff07f, 0x48051057, PT_NONE},
-    {        "r2_vm",        "vfwcvt_f_x_v", 0xfc0ff07f, 0x48059057, PT_NONE},
-    {        "r2_vm",        "vfwcvt_f_f_v", 0xfc0ff07f, 0x48061057, PT_NONE},
-    {        "r2_vm",   "vfwcvt_rtz_xu_f_v", 0xfc0ff07f, 0x48071057, PT_NONE},
-    {        "r2_vm",    "vfwcvt_rtz_x_f_v", 0xfc0ff07f, 0x48079057, PT_NONE},
-    {        "r2_vm",       "vfncvt_xu_f_w", 0xfc0ff07f, 0x48081057, PT_NONE},
-    {        "r2_vm",        "vfncvt_x_f_w", 0xfc0ff07f, 0x48089057, PT_NONE},
-    {        "r2_vm",       "vfncvt_f_xu_w", 0xfc0ff07f, 0x48091057, PT_NONE},
-    {        "r2_vm",        "vfncvt_f_x_w", 0xfc0ff07f, 0x48099057, PT_NONE},
-    {        "r2_vm",        "vfncvt_f_f_w", 0xfc0ff07f, 0x480a1057, PT_NONE},
-    {        "r2_vm",    "vfncvt_rod_f_f_w", 0xfc0ff07f, 0x480a9057, PT_NONE},
-    {        "r2_vm",   "vfncvt_rtz_xu_f_w", 0xfc0ff07f, 0x480b1057, PT_NONE},
-    {        "r2_vm",    "vfncvt_rtz_x_f_w", 0xfc0ff07f, 0x480b9057, PT_NONE},
-    {         "r_vm",          "vredsum_vs", 0xfc00707f, 0x00002057, PT_NONE},
-    {         "r_vm",          "vredand_vs", 0xfc00707f, 0x04002057, PT_NONE},
-    {         "r_vm",           "vredor_vs", 0xfc00707f, 0x08002057, PT_NONE},
-    {         "r_vm",          "vredxor_vs", 0xfc00707f, 0x0c002057, PT_NONE},
-    {         "r_vm",         "vredminu_vs", 0xfc00707f, 0x10002057, PT_NONE},
-    {         "r_vm",          "vredmin_vs", 0xfc00707f, 0x14002057, PT_NONE},
-    {         "r_vm",         "vredmaxu_vs", 0xfc00707f, 0x18002057, PT_NONE},
-    {         "r_vm",          "vredmax_vs", 0xfc00707f, 0x1c002057, PT_NONE},
-    {         "r_vm",        "vwredsumu_vs", 0xfc00707f, 0xc0000057, PT_NONE},
-    {         "r_vm",         "vwredsum_vs", 0xfc00707f, 0xc4000057, PT_NONE},
-    {         "r_vm",         "vfredsum_vs", 0xf400707f, 0x04001057, PT_NONE},
-    {         "r_vm",         "vfredmin_vs", 0xfc00707f, 0x14001057, PT_NONE},
-    {         "r_vm",         "vfredmax_vs", 0xfc00707f, 0x1c001057, PT_NONE},
-    {         "r_vm",        "vfwredsum_vs", 0xf400707f, 0xc4001057, PT_NONE},
-    {            "r",            "vmand_mm", 0xfc00707f, 0x64002057, PT_NONE},
-    {            "r",           "vmnand_mm", 0xfc00707f, 0x74002057, PT_NONE},
-    {            "r",           "vmandn_mm", 0xfc00707f, 0x60002057, PT_NONE},
-    {            "r",            "vmxor_mm", 0xfc00707f, 0x6c002057, PT_NONE},
-    {            "r",             "vmor_mm", 0xfc00707f, 0x68002057, PT_NONE},
-    {            "r",            "vmnor_mm", 0xfc00707f, 0x78002057, PT_NONE},
-    {            "r",            "vmorn_mm", 0xfc00707f, 0x70002057, PT_NONE},
-    {            "r",           "vmxnor_mm", 0xfc00707f, 0x7c002057, PT_NONE},
-    {        "r2_vm",             "vcpop_m", 0xfc0ff07f, 0x40082057, PT_NONE},
-    {        "r2_vm",            "vfirst_m", 0xfc0ff07f, 0x4008a057, PT_NONE},
-    {        "r2_vm",             "vmsbf_m", 0xfc0ff07f, 0x5000a057, PT_NONE},
-    {        "r2_vm",             "vmsif_m", 0xfc0ff07f, 0x5001a057, PT_NONE},
-    {        "r2_vm",             "vmsof_m", 0xfc0ff07f, 0x50012057, PT_NONE},
-    {        "r2_vm",             "viota_m", 0xfc0ff07f, 0x50082057, PT_NONE},
-    {        "r1_vm",               "vid_v", 0xfdfff07f, 0x5008a057, PT_NONE},
-    {         "r2rd",             "vmv_x_s", 0xfe0ff07f, 0x42002057, PT_NONE},
-    {           "r2",             "vmv_s_x", 0xfff0707f, 0x42006057, PT_NONE},
-    {         "r2rd",            "vfmv_f_s", 0xfe0ff07f, 0x42001057, PT_NONE},
-    {           "r2",            "vfmv_s_f", 0xfff0707f, 0x42005057, PT_NONE},
-    {         "r_vm",         "vslideup_vx", 0xfc00707f, 0x38004057, PT_NONE},
-    {         "r_vm",         "vslideup_vi", 0xfc00707f, 0x38003057, PT_NONE},
-    {         "r_vm",        "vslide1up_vx", 0xfc00707f, 0x38006057, PT_NONE},
-    {         "r_vm",       "vslidedown_vx", 0xfc00707f, 0x3c004057, PT_NONE},
-    {         "r_vm",       "vslidedown_vi", 0xfc00707f, 0x3c003057, PT_NONE},
-    {         "r_vm",      "vslide1down_vx", 0xfc00707f, 0x3c006057, PT_NONE},
-    {         "r_vm",         "vrgather_vv", 0xfc00707f, 0x30000057, PT_NONE},
-    {         "r_vm",     "vrgatherei16_vv", 0xfc00707f, 0x38000057, PT_NONE},
-    {         "r_vm",         "vrgather_vx", 0xfc00707f, 0x30004057, PT_NONE},
-    {         "r_vm",         "vrgather_vi", 0xfc00707f, 0x30003057, PT_NONE},
-    {            "r",        "vcompress_vm", 0xfc00707f, 0x5c002057, PT_NONE},
-    {         "r2rd",             "vmv1r_v", 0xfe0ff07f, 0x9e003057, PT_NONE},
-    {         "r2rd",             "vmv2r_v", 0xfe0ff07f, 0x9e00b057, PT_NONE},
-    {         "r2rd",             "vmv4r_v", 0xfe0ff07f, 0x9e01b057, PT_NONE},
-    {         "r2rd",             "vmv8r_v", 0xfe0ff07f, 0x9e03b057, PT_NONE},
-    {        "r2_vm",           "vzext_vf2", 0xfc0ff07f, 0x48032057, PT_NONE},
-    {        "r2_vm",           "vzext_vf4", 0xfc0ff07f, 0x48022057, PT_NONE},
-    {        "r2_vm",           "vzext_vf8", 0xfc0ff07f, 0x48012057, PT_NONE},
-    {        "r2_vm",           "vsext_vf2", 0xfc0ff07f, 0x4803a057, PT_NONE},
-    {        "r2_vm",           "vsext_vf4", 0xfc0ff07f, 0x4802a057, PT_NONE},
-    {        "r2_vm",           "vsext_vf8", 0xfc0ff07f, 0x4801a057, PT_NONE},
-    {    "r2_zimm11",             "vsetvli", 0x8000707f, 0x00007057, PT_NONE},
-    {    "r2_zimm10",            "vsetivli", 0xc000707f, 0xc0007057, PT_NONE},
-    {            "r",              "vsetvl", 0xfe00707f, 0x80007057, PT_NONE},
-    {            "r",              "sh1add", 0xfe00707f, 0x20002033, PT_NONE},
-    {            "r",              "sh2add", 0xfe00707f, 0x20004033, PT_NONE},
-    {            "r",              "sh3add", 0xfe00707f, 0x20006033, PT_NONE},
-    {            "r",              "add_uw", 0xfe00707f, 0x0800003b, PT_NONE},
-    {            "r",           "sh1add_uw", 0xfe00707f, 0x2000203b, PT_NONE},
-    {            "r",           "sh2add_uw", 0xfe00707f, 0x2000403b, PT_NONE},
-    {            "r",           "sh3add_uw", 0xfe00707f, 0x2000603b, PT_NONE},
-    {           "sh",             "slli_uw", 0xf800707f, 0x0800101b, PT_NONE},
-    {            "r",                "andn", 0xfe00707f, 0x40007033, PT_NONE},
-    {           "r2",                 "clz", 0xfff0707f, 0x60001013, PT_NONE},
-    {           "r2",                "cpop", 0xfff0707f, 0x60201013, PT_NONE},
-    {           "r2",                 "ctz", 0xfff0707f, 0x60101013, PT_NONE},
-    {            "r",                 "max", 0xfe00707f, 0x0a006033, PT_NONE},
-    {            "r",                "maxu", 0xfe00707f, 0x0a007033, PT_NONE},
-    {            "r",                 "min", 0xfe00707f, 0x0a004033, PT_NONE},
-    {            "r",                "minu", 0xfe00707f, 0x0a005033, PT_NONE},
-    {           "r2",               "orc_b", 0xfff0707f, 0x28705013, PT_NONE},
-    {            "r",                 "orn", 0xfe00707f, 0x40006033, PT_NONE},
-    {           "r2",             "rev8_32", 0xfff0707f, 0x69805013, PT_NONE},
-    {            "r",                 "rol", 0xfe00707f, 0x60001033, PT_NONE},
-    {            "r",                 "ror", 0xfe00707f, 0x60005033, PT_NONE},
-    {           "sh",                "rori", 0xf800707f, 0x60005013, PT_NONE},
-    {           "r2",              "sext_b", 0xfff0707f, 0x60401013, PT_NONE},
-    {           "r2",              "sext_h", 0xfff0707f, 0x60501013, PT_NONE},
-    {            "r",                "xnor", 0xfe00707f, 0x40004033, PT_NONE},
-    {           "r2",           "zext_h_32", 0xfff0707f, 0x08004033, PT_NONE},
-    {           "r2",                "clzw", 0xfff0707f, 0x6000101b, PT_NONE},
-    {           "r2",                "ctzw", 0xfff0707f, 0x6010101b, PT_NONE},
-    {           "r2",               "cpopw", 0xfff0707f, 0x6020101b, PT_NONE},
-    {           "r2",             "rev8_64", 0xfff0707f, 0x6b805013, PT_NONE},
-    {            "r",                "rolw", 0xfe00707f, 0x6000103b, PT_NONE},
-    {          "sh5",               "roriw", 0xfe00707f, 0x6000501b, PT_NONE},
-    {            "r",                "rorw", 0xfe00707f, 0x6000503b, PT_NONE},
-    {           "r2",           "zext_h_64", 0xfff0707f, 0x0800403b, PT_NONE},
-    {            "r",               "clmul", 0xfe00707f, 0x0a001033, PT_NONE},
-    {            "r",              "clmulh", 0xfe00707f, 0x0a003033, PT_NONE},
-    {            "r",              "clmulr", 0xfe00707f, 0x0a002033, PT_NONE},
-    {            "r",                "bclr", 0xfe00707f, 0x48001033, PT_NONE},
-    {           "sh",               "bclri", 0xf800707f, 0x48001013, PT_NONE},
-    {            "r",                "bext", 0xfe00707f, 0x48005033, PT_NONE},
-    {           "sh",               "bexti", 0xf800707f, 0x48005013, PT_NONE},
-    {            "r",                "binv", 0xfe00707f, 0x68001033, PT_NONE},
-    {           "sh",               "binvi", 0xf800707f, 0x68001013, PT_NONE},
-    {            "r",                "bset", 0xfe00707f, 0x28001033, PT_NONE},
-    {           "sh",               "bseti", 0xf800707f, 0x28001013, PT_NONE},
-    {            "i",                 "flh", 0x0000707f, 0x00001007, PT_LD  },
-    {            "s",                 "fsh", 0x0000707f, 0x00001027, PT_ST  },
-    {        "r4_rm",             "fmadd_h", 0x0600007f, 0x04000043, PT_NONE},
-    {        "r4_rm",             "fmsub_h", 0x0600007f, 0x04000047, PT_NONE},
-    {        "r4_rm",            "fnmsub_h", 0x0600007f, 0x0400004b, PT_NONE},
-    {        "r4_rm",            "fnmadd_h", 0x0600007f, 0x0400004f, PT_NONE},
-    {         "r_rm",              "fadd_h", 0xfe00007f, 0x04000053, PT_NONE},
-    {         "r_rm",              "fsub_h", 0xfe00007f, 0x0c000053, PT_NONE},
-    {         "r_rm",              "fmul_h", 0xfe00007f, 0x14000053, PT_NONE},
-    {         "r_rm",              "fdiv_h", 0xfe00007f, 0x1c000053, PT_NONE},
-    {        "r2_rm",             "fsqrt_h", 0xfff0007f, 0x5c000053, PT_NONE},
-    {            "r",             "fsgnj_h", 0xfe00707f, 0x24000053, PT_NONE},
-    {            "r",            "fsgnjn_h", 0xfe00707f, 0x24001053, PT_NONE},
-    {            "r",            "fsgnjx_h", 0xfe00707f, 0x24002053, PT_NONE},
-    {            "r",              "fmin_h", 0xfe00707f, 0x2c000053, PT_NONE},
-    {            "r",              "fmax_h", 0xfe00707f, 0x2c001053, PT_NONE},
-    {        "r2_rm",            "fcvt_h_s", 0xfff0007f, 0x44000053, PT_NONE},
-    {        "r2_rm",            "fcvt_s_h", 0xfff0007f, 0x40200053, PT_NONE},
-    {        "r2_rm",            "fcvt_h_d", 0xfff0007f, 0x44100053, PT_NONE},
-    {        "r2_rm",            "fcvt_d_h", 0xfff0007f, 0x42200053, PT_NONE},
-    {        "r2_rm",            "fcvt_w_h", 0xfff0007f, 0xc4000053, PT_NONE},
-    {        "r2_rm",           "fcvt_wu_h", 0xfff0007f, 0xc4100053, PT_NONE},
-    {           "r2",             "fmv_x_h", 0xfff0707f, 0xe4000053, PT_NONE},
-    {            "r",               "feq_h", 0xfe00707f, 0xa4002053, PT_NONE},
-    {            "r",               "flt_h", 0xfe00707f, 0xa4001053, PT_NONE},
-    {            "r",               "fle_h", 0xfe00707f, 0xa4000053, PT_NONE},
-    {           "r2",            "fclass_h", 0xfff0707f, 0xe4001053, PT_NONE},
-    {        "r2_rm",            "fcvt_h_w", 0xfff0007f, 0xd4000053, PT_NONE},
-    {        "r2_rm",           "fcvt_h_wu", 0xfff0007f, 0xd4100053, PT_NONE},
-    {           "r2",             "fmv_h_x", 0xfff0707f, 0xf4000053, PT_NONE},
-    {        "r2_rm",            "fcvt_l_h", 0xfff0007f, 0xc4200053, PT_NONE},
-    {        "r2_rm",           "fcvt_lu_h", 0xfff0007f, 0xc4300053, PT_NONE},
-    {        "r2_rm",            "fcvt_h_l", 0xfff0007f, 0xd4200053, PT_NONE},
-    {        "r2_rm",           "fcvt_h_lu", 0xfff0007f, 0xd4300053, PT_NONE},
-    /* Quadrant 0 */
-    {           "c",           "c_addi4spn", 0xe003, 0x0000, PT_CADDI4SPN},
-    {           "c",                "c_fld", 0xe003, 0x2000, PT_CLD  },
-    {           "c",                 "c_lw", 0xe003, 0x4000, PT_CLD  },
-    {           "c",                 "c_ld", 0xe003, 0x6000, PT_CLD  },
-    {           "c",                "c_fsd", 0xe003, 0xa000, PT_CST  },
-    {           "c",                 "c_sw", 0xe003, 0xc000, PT_CST  },
-    {           "c",                 "c_sd", 0xe003, 0xe000, PT_CST  },
-    /* Quadrant 1 */
-    {           "c",           "c_nop", 0xffff, 0x0001, PT_NONE},
-    {           "c",          "c_addi", 0xe003, 0x0001, PT_CIRD5},
-    {           "c",         "c_addiw", 0xe003, 0x2001, PT_CIRD5},
-    {           "c",            "c_li", 0xe003, 0x4001, PT_CIRD5},
-    {           "c",      "c_addi16sp", 0xef83, 0x6101, PT_CIRD5},
-    {           "c",           "c_lui", 0xe003, 0x6001, PT_CIRD5},
-    {           "cr",       "c_srli64", 0xfc7f, 0x8001, PT_CSH64RD3},
-    {           "c",          "c_srli", 0xec03, 0x8001, PT_CSHRD3},
-    {           "cr",       "c_srai64", 0xfc7f, 0x8401, PT_CSH64RD3},
-    {           "c",          "c_srai", 0xec03, 0x8401, PT_CSHRD3},
-    {           "c",          "c_andi", 0xec03, 0x8801, PT_CIRD3},
-    {           "cr",          "c_sub", 0xfc63, 0x8c01, PT_CR},
-    {           "cr",          "c_xor", 0xfc63, 0x8c21, PT_CR},
-    {           "cr",           "c_or", 0xfc63, 0x8c41, PT_CR},
-    {           "cr",          "c_and", 0xfc63, 0x8c61, PT_CR},
-    {           "cr",         "c_subw", 0xfc63, 0x9c01, PT_CR},
-    {           "cr",         "c_addw", 0xfc63, 0x9c21, PT_CR},
-    {           "c",             "c_j", 0xe003, 0xa001, PT_NONE},
-    {           "cr",         "c_beqz", 0xe003, 0xc001, PT_CB},
-    {           "cr",         "c_bnez", 0xe003, 0xe001, PT_CB},
-    /* Quadrant 2 */
-    {           "c",        "c_slli64", 0xf07f, 0x0002, PT_CSH64RD5},
-    {           "c",          "c_slli", 0xe003, 0x0002, PT_CSHRD5},
-    {           "cl",        "c_fldsp", 0xe003, 0x2002, PT_CLDSP},
-    {           "cl",         "c_lwsp", 0xe003, 0x4002, PT_CLDSP},
-    {           "cl",         "c_ldsp", 0xe003, 0x6002, PT_CLDSP},
-    {           "c",            "c_jr", 0xf07f, 0x8002, PT_CJR},
-    {           "c",            "c_mv", 0xf003, 0x8002, PT_CMV},
-    {           "c",         "c_break", 0xffff, 0x9002, PT_NONE},
-    {           "c",          "c_jalr", 0xf07f, 0x9002, PT_CJALR},
-    {           "c",           "c_add", 0xf003, 0x9002, PT_CADD},
-    {           "c",          "c_fdsp", 0xe003, 0xa002, PT_CSTSP},
-    {           "c",          "c_swsp", 0xe003, 0xc002, PT_CSTSP},
-    {           "c",          "c_sdsp", 0xe003, 0xe002, PT_CSTSP},
-    { "Unclassified",   "unclas",   0x00000000, 0x00000000, PT_NONE },
-};
@@ -871,12 +871,50 @@ static CPUState *gdb_get_cpu(uint32_t pid, uint32_t tid)
     }
 }
 
+/* Find the XML description of feature @p (@len chars) for @cpu */
+static const char *lookup_feature_xml(CPUState *cpu, const char *p,
+                                      size_t len)
+{
+    CPUClass *cc = CPU_GET_CLASS(cpu);
+    const char *name;
+    int i;
+
+    if (cc->gdb_get_dynamic_xml) {
+        char *xmlname = g_strndup(p, len);
+        const char *xml = cc->gdb_get_dynamic_xml(cpu, xmlname);
+
+        g_free(xmlname);
+        if (xml) {
+            return xml;
+        }
+    }
+    for (i = 0; ; i++) {
+        name = xml_builtin[i][0];
+        if (!name || (strncmp(name, p, len) == 0 && strlen(name) == len))
+            break;
+    }
+    return name ? xml_builtin[i][1] : NULL;
+}
+
+/* Return the value of attribute @attr of the XML tag in [@p, @end) */
+static char *xml_attr(const char *p, const char *end, const char *attr)
+{
+    g_autofree char *key = g_strdup_printf(" %s=\"", attr);
+    const char *val = g_strstr_len(p, end - p, key);
+    const char *val_end;
+
+    if (!val) {
+        return NULL;
+    }
+    val += strlen(key);
+    val_end = memchr(val, '"', end - val);
+    return val_end ? g_strndup(val, val_end - val) : NULL;
+}
+
 static const char *get_feature_xml(const char *p, const char **newp,
                                    GDBProcess *process)
 {
     size_t len;
-    int i;
-    const char *name;
     CPUState *cpu = get_first_cpu_in_process(process);
     CPUClass *cc = CPU_GET_CLASS(cpu);
 
@@ -885,7 +923,6 @@ static const char *get_feature_xml(const char *p, const char **newp,
         len++;
     *newp = p + len;
 
-    name = NULL;
     if (strncmp(p, "target.xml", len) == 0) {
         char *buf = process->target_xml;
         const size_t buf_sz = sizeof(process->target_xml);
@@ -917,24 +954,81 @@ static const char *get_feature_xml(const char *p, const char **newp,
         }
         return buf;
     }
-    if (cc->gdb_get_dynamic_xml) {
-        char *xmlname = g_strndup(p, len);
-        const char *xml = cc->gdb_get_dynamic_xml(cpu, xmlname);
+    return lookup_feature_xml(cpu, p, len);
+}
 
-        g_free(xmlname);
-        if (xml) {
-            return xml;
-        }
+/*
+ * Collect the registers described by the feature @xml. Registers are
+ * numbered consecutively from @base_reg unless the description pins
+ * a number with a regnum attribute.
+ */
+static void gdb_collect_feature_regs(GArray *regs, const char *xml,
+                                     int base_reg)
+{
+    const char *feature = NULL;
+    const char *p, *end;
+    int regnum = base_reg;
+
+    p = strstr(xml, "<feature ");
+    if (p) {
+        g_autofree char *fname = NULL;
+
+        end = strchr(p, '>');
+        fname = end ? xml_attr(p, end, "name") : NULL;
+        feature = fname ? g_intern_string(fname) : NULL;
     }
-    for (i = 0; ; i++) {
-        name = xml_builtin[i][0];
-        if (!name || (strncmp(name, p, len) == 0 && strlen(name) == len))
+
+    for (p = strstr(xml, "<reg "); p; p = strstr(end, "<reg ")) {
+        g_autofree char *name = NULL;
+        g_autofree char *num = NULL;
+
+        end = strchr(p, '>');
+        if (!end) {
             break;
+        }
+        name = xml_attr(p, end, "name");
+        num = xml_attr(p, end, "regnum");
+        if (num) {
+            regnum = atoi(num);
+        }
+        if (name) {
+            GDBRegDesc desc = {
+                .gdb_reg = regnum,
+                .name = g_intern_string(name),
+                .feature_name = feature,
+            };
+            g_array_append_val(regs, desc);
+        }
+        regnum++;
     }
-    return name ? xml_builtin[i][1] : NULL;
 }
 
-static int gdb_read_register(CPUState *cpu, GByteArray *buf, int reg)
+GArray *gdb_get_register_list(CPUState *cpu)
+{
+    CPUClass *cc = CPU_GET_CLASS(cpu);
+    GArray *regs = g_array_new(false, false, sizeof(GDBRegDesc));
+    GDBRegisterState *r;
+    const char *xml;
+
+    if (!cc->gdb_core_xml_file) {
+        return regs;
+    }
+
+    xml = lookup_feature_xml(cpu, cc->gdb_core_xml_file,
+                             strlen(cc->gdb_core_xml_file));
+    if (xml) {
+        gdb_collect_feature_regs(regs, xml, 0);
+    }
+    for (r = cpu->gdb_regs; r; r = r->next) {
+        xml = lookup_feature_xml(cpu, r->xml, strlen(r->xml));
+        if (xml) {
+            gdb_collect_feature_regs(regs, xml, r->base_reg);
+        }
+    }
+    return regs;
+}
+
+int gdb_read_register(CPUState *cpu, GByteArray *buf, int reg)
 {
     CPUClass *cc = CPU_GET_CLASS(cpu);
     CPUArchState *env = cpu->env_ptr;
@@ -211,6 +211,9 @@ struct AioContext {
      */
     struct LuringState *linux_io_uring;
 
+    /* Same, for an IORING_SETUP_IOPOLL ring */
+    struct LuringState *linux_io_uring_poll;
+
     /* State for file descriptor monitoring using Linux io_uring */
     struct io_uring fdmon_io_uring;
     AioHandlerSList submit_list;
@@ -235,6 +238,11 @@ struct AioContext {
     /* AIO engine parameters */
     int64_t aio_max_batch;  /* maximum number of requests in a batch */
 
+    /* io_uring engine parameters, used when the ring is set up */
+    bool io_uring_sqpoll;         /* kernel thread polls the SQ */
+    bool io_uring_fixed_files;    /* register image files */
+    bool io_uring_fixed_buffers;  /* register guest RAM */
+
     /*
      * List of handlers participating in userspace polling.  Protected by
      * ctx->list_lock.  Iterated and modified mostly by the event loop thread
@@ -522,6 +530,16 @@ struct LuringState *aio_setup_linux_io_uring(AioContext *ctx, Error **errp);
 
 /* Return the LuringState bound to this AioContext */
 struct LuringState *aio_get_linux_io_uring(AioContext *ctx);
+
+/*
+ * Setup the LuringState bound to this AioContext whose ring polls for
+ * completions, for O_DIRECT reads and writes only
+ */
+struct LuringState *aio_setup_linux_io_uring_poll(AioContext *ctx,
+                                                  Error **errp);
+
+/* Return the polling LuringState bound to this AioContext */
+struct LuringState *aio_get_linux_io_uring_poll(AioContext *ctx);
 /**
  * aio_timer_new_with_attrs:
  * @ctx: the aio context
@@ -769,4 +787,19 @@ void aio_context_set_poll_params(AioContext *ctx, int64_t max_ns,
 void aio_context_set_aio_params(AioContext *ctx, int64_t max_batch,
                                 Error **errp);
 
+/**
+ * aio_context_set_io_uring_params:
+ * @ctx: the aio context
+ * @sqpoll: let a kernel thread poll the submission queue
+ * @fixed_files: register the files of the requests with the ring
+ * @fixed_buffers: register guest RAM backed by memfd or hugepages with
+ *                 the ring
+ *
+ * The parameters take effect when the io_uring ring of @ctx is set up,
+ * that is when the first io_uring block node is opened in @ctx.
+ */
+void aio_context_set_io_uring_params(AioContext *ctx, bool sqpoll,
+                                     bool fixed_files, bool fixed_buffers,
+                                     Error **errp);
+
 #endif
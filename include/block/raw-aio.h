@@ -62,8 +62,15 @@ void laio_io_unplug(BlockDriverState *bs, LinuxAioState *s,
 /* io_uring.c - Linux io_uring implementation */
 #ifdef CONFIG_LINUX_IO_URING
 typedef struct LuringState LuringState;
-LuringState *luring_init(Error **errp);
+/* luring_init() flags */
+#define LURING_SQPOLL           (1 << 0)
+#define LURING_FIXED_FILES      (1 << 1)
+#define LURING_FIXED_BUFFERS    (1 << 2)
+#define LURING_IOPOLL           (1 << 3)
+LuringState *luring_init(unsigned int flags, Error **errp);
 void luring_cleanup(LuringState *s);
+void luring_register_fd(LuringState *s, int fd);
+void luring_unregister_fd(LuringState *s, int fd);
 int coroutine_fn luring_co_submit(BlockDriverState *bs, LuringState *s, int fd,
                                 uint64_t offset, QEMUIOVector *qiov, int type);
 void luring_detach_aio_context(LuringState *s, AioContext *old_context);
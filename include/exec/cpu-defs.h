@@ -76,8 +76,17 @@ typedef uint64_t target_ulong;
 
 #if !defined(CONFIG_USER_ONLY) && defined(CONFIG_TCG)
 
-/* use a fully associative victim tlb of 8 entries */
-#define CPU_VTLB_SIZE 8
+/*
+ * The victim tlb is set associative, with CPU_VTLB_WAYS entries per set.
+ * It is sized after the tlb it backs, with one entry for CPU_VTLB_RATIO
+ * entries of that tlb, within CPU_VTLB_MIN_SIZE..CPU_VTLB_MAX_SIZE.
+ */
+#define CPU_VTLB_WAYS 4
+#define CPU_VTLB_RATIO 16
+#define CPU_VTLB_MIN_SIZE 8
+#define CPU_VTLB_MAX_SIZE 1024
+/* Number of large page regions tracked per MMU mode */
+#define CPU_TLB_LARGE_PAGES 4
 
 #if HOST_LONG_BITS == 32 && TARGET_LONG_BITS == 32
 #define CPU_TLB_ENTRY_BITS 4
@@ -150,31 +159,44 @@ typedef struct CPUIOTLBEntry {
     MemTxAttrs attrs;
 } CPUIOTLBEntry;
 
+/*
+ * A region covering some of the large pages allocated into the tlb.
+ * When any page within this region is flushed, we must flush all of
+ * the region.  The region is matched if (page & mask) == addr.  A
+ * free slot has addr == mask == -1.
+ */
+typedef struct CPUTLBLargePage {
+    target_ulong addr;
+    target_ulong mask;
+} CPUTLBLargePage;
+
 /*
  * Data elements that are per MMU mode, minus the bits accessed by
  * the TCG fast path.
  */
 typedef struct CPUTLBDesc {
-    /*
-     * Describe a region covering all of the large pages allocated
-     * into the tlb.  When any page within this region is flushed,
-     * we must flush the entire tlb.  The region is matched if
-     * (addr & large_page_mask) == large_page_addr.
-     */
-    target_ulong large_page_addr;
-    target_ulong large_page_mask;
+    /* Regions covering all of the large pages allocated into the tlb. */
+    CPUTLBLargePage large_page[CPU_TLB_LARGE_PAGES];
     /* host time (in ns) at the beginning of the time window */
     int64_t window_begin_ns;
     /* maximum number of entries observed in the window */
     size_t window_max_entries;
     size_t n_used_entries;
-    /* The next index to use in the tlb victim table.  */
+    /* The next way to replace in a set of the tlb victim table.  */
     size_t vindex;
+    /* The number of sets in the tlb victim table, a power of 2.  */
+    size_t vtlb_sets;
     /* The tlb victim table, in two parts.  */
-    CPUTLBEntry vtable[CPU_VTLB_SIZE];
-    CPUIOTLBEntry viotlb[CPU_VTLB_SIZE];
+    CPUTLBEntry *vtable;
+    CPUIOTLBEntry *viotlb;
     /* The iotlb.  */
     CPUIOTLBEntry *iotlb;
+    /*
+     * Statistics, read and written atomically like those of CPUTLBCommon:
+     * lookups that missed the fast path, and those the victim tlb served.
+     */
+    size_t miss_count;
+    size_t vtlb_hit_count;
 } CPUTLBDesc;
 
 /*
@@ -188,6 +210,29 @@ typedef struct CPUTLBDescFast {
     CPUTLBEntry *table;
 } CPUTLBDescFast QEMU_ALIGNED(2 * sizeof(void *));
 
+/*
+ * Page and range flushes that other cpus can leave pending on a cpu,
+ * before they degrade to flushing the mmu_idx entirely.
+ */
+#define CPU_TLB_PENDING_FLUSHES 16
+
+/* Number of page table entries cached, see tlb_walk_cache_lookup(). */
+#define CPU_TLB_WALK_CACHE_SIZE 64
+
+/* A page table entry @pte read from guest physical address @addr */
+typedef struct CPUTLBWalkCacheEntry {
+    hwaddr addr;
+    uint64_t pte;
+} CPUTLBWalkCacheEntry;
+
+/* A flush of the @len bytes at @addr, see tlb_flush_range_by_mmuidx(). */
+typedef struct CPUTLBPendingFlush {
+    target_ulong addr;
+    target_ulong len;
+    uint16_t idxmap;
+    uint16_t bits;
+} CPUTLBPendingFlush;
+
 /*
  * Data elements that are shared between all MMU modes.
  */
@@ -200,6 +245,23 @@ typedef struct CPUTLBCommon {
      * Protected by tlb_c.lock.
      */
     uint16_t dirty;
+    /*
+     * Flushes requested by other cpus, coalesced until this cpu runs
+     * them all from a single work item: the mmu_idx to flush entirely,
+     * and the pages and ranges of the others.  pending_queued is set
+     * while that work item is queued.  Protected by tlb_c.lock.
+     */
+    uint16_t pending_full;
+    uint16_t n_pending;
+    bool pending_queued;
+    CPUTLBPendingFlush pending[CPU_TLB_PENDING_FLUSHES];
+    /*
+     * Non-leaf page table entries read by the page table walker of the
+     * target, emptied by any flush.  Only accessed by the cpu itself.
+     * walk_cache_used is set while some entry is valid.
+     */
+    bool walk_cache_used;
+    CPUTLBWalkCacheEntry walk_cache[CPU_TLB_WALK_CACHE_SIZE];
     /*
      * Statistics.  These are not lock protected, but are read and
      * written atomically.  This allows the monitor to print a snapshot
@@ -208,6 +270,10 @@ typedef struct CPUTLBCommon {
     size_t full_flush_count;
     size_t part_flush_count;
     size_t elide_flush_count;
+    /* large page region flushes, each of which avoided a full flush */
+    size_t large_flush_count;
+    /* flush requests merged into ones already pending */
+    size_t coalesced_flush_count;
 } CPUTLBCommon;
 
 /*
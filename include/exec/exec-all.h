@@ -320,6 +320,34 @@ void tlb_set_page_with_attrs(CPUState *cpu, target_ulong vaddr,
 void tlb_set_page(CPUState *cpu, target_ulong vaddr,
                   hwaddr paddr, int prot,
                   int mmu_idx, target_ulong size);
+
+/**
+ * tlb_walk_cache_lookup:
+ * @cpu: CPU walking its page tables
+ * @addr: physical address of the page table entry
+ * @pte: set to the cached value of the entry
+ *
+ * Look up a page table entry stored with tlb_walk_cache_insert().  The
+ * cache is emptied whenever any part of the TLB of @cpu is flushed, so
+ * the page table walker of a target can use it for the non-leaf entries
+ * that the architecture lets the TLB cache until the next flush, and
+ * skip reading them from memory on most TLB refills.  Must be called
+ * from the thread of @cpu, i.e. not for debug accesses.
+ *
+ * Returns true if @pte was found.
+ */
+bool tlb_walk_cache_lookup(CPUState *cpu, hwaddr addr, uint64_t *pte);
+
+/**
+ * tlb_walk_cache_insert:
+ * @cpu: CPU walking its page tables
+ * @addr: physical address of the page table entry
+ * @pte: value of the entry
+ *
+ * Remember the valid, non-leaf page table entry @pte at @addr, for
+ * tlb_walk_cache_lookup().  Must be called from the thread of @cpu.
+ */
+void tlb_walk_cache_insert(CPUState *cpu, hwaddr addr, uint64_t pte);
 #else
 static inline void tlb_init(CPUState *cpu)
 {
@@ -408,6 +436,15 @@ static inline void tlb_flush_range_by_mmuidx_all_cpus_synced(CPUState *cpu,
                                                              unsigned bits)
 {
 }
+static inline bool tlb_walk_cache_lookup(CPUState *cpu, hwaddr addr,
+                                         uint64_t *pte)
+{
+    return false;
+}
+static inline void tlb_walk_cache_insert(CPUState *cpu, hwaddr addr,
+                                         uint64_t pte)
+{
+}
 #endif
 /**
  * probe_access:
@@ -560,6 +597,26 @@ struct TranslationBlock {
     uintptr_t jmp_list_head;
     uintptr_t jmp_list_next[2];
     uintptr_t jmp_dest[2];
+
+    /*
+     * Tiered translation (see tcg_tier_threshold): tier 1 TBs count down
+     * their executions in tier_count, and are retranslated as a tier 2
+     * superblock when it hits zero. TBs that are not counted are tier 0.
+     */
+    uint32_t tier_count;
+    uint8_t tier;
+
+    /*
+     * Chained liveness (see tcg_chain_liveness): jump n does not sync the
+     * globals in jmp_nosync[n], one bit per global, so it may only be
+     * linked to the chain_offset entry of a TB whose dead_in has them all,
+     * i.e. that overwrites them before reading them; when it meets any
+     * other TB, this TB is invalidated instead. A chain_offset of 0 means
+     * that the TB has no such entry.
+     */
+    uint64_t dead_in;
+    uint64_t jmp_nosync[2];
+    uint16_t chain_offset;
 };
 
 /* Hide the qatomic_read to make code a little easier on the eyes */
@@ -628,6 +685,7 @@ struct MemoryRegionSection *iotlb_to_section(CPUState *cpu,
 
 #if defined(CONFIG_USER_ONLY)
 void mmap_lock(void);
+bool mmap_trylock(void);
 void mmap_unlock(void);
 bool have_mmap_lock(void);
 
@@ -715,6 +773,70 @@ void QEMU_NORETURN cpu_loop_exit_sigbus(CPUState *cpu, target_ulong addr,
                                         MMUAccessType access_type,
                                         uintptr_t ra);
 
+/**
+ * tb_cache_open:
+ * @dir: directory of the persistent translation cache
+ * @execfd: file descriptor of the guest executable
+ * @cpu_model: the -cpu option
+ *
+ * Enable the persistent translation cache, which keeps the code
+ * translated for the guest executable across runs, and read its file
+ * for the executable if there is one. Must be called before the
+ * accelerator is initialized.
+ */
+void tb_cache_open(const char *dir, int execfd, const char *cpu_model);
+
+/**
+ * tb_cache_load:
+ *
+ * Load the code read by tb_cache_open() into the code buffer, if it can
+ * be reused. Must be called after tcg_prologue_init().
+ */
+void tb_cache_load(void);
+
+/**
+ * tb_cache_map:
+ * @start: guest address of the new mapping
+ * @len: length of the new mapping
+ * @prot: its protection
+ * @fd: file descriptor of the mapped file, or -1 for anonymous memory
+ * @offset: offset of the mapping in the file
+ *
+ * Record a new mapping, and make the cached TBs translated from the same
+ * code reachable. Called with mmap_lock held.
+ */
+void tb_cache_map(target_ulong start, target_ulong len, int prot,
+                  int fd, target_ulong offset);
+
+/**
+ * tb_cache_unmap:
+ * @start: guest address of the range
+ * @len: length of the range
+ *
+ * Forget the file mappings in a range that is being unmapped or moved.
+ * Called with mmap_lock held.
+ */
+void tb_cache_unmap(target_ulong start, target_ulong len);
+
+/**
+ * tb_cache_save:
+ *
+ * Write the translated code to the persistent translation cache. Called
+ * when the process exits.
+ */
+void tb_cache_save(void);
+
+/**
+ * translate_pool_init:
+ * @n_threads: number of translator threads, 0 to translate on vCPUs only
+ *
+ * Start the threads that translate direct jump destinations ahead of
+ * time and retranslate hot TBs in the background.
+ */
+void translate_pool_init(unsigned int n_threads);
+void translate_pool_fork_start(void);
+void translate_pool_fork_end(int child);
+
 #else
 static inline void mmap_lock(void) {}
 static inline void mmap_unlock(void) {}
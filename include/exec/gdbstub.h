@@ -167,6 +167,38 @@ static inline uint8_t * gdb_get_reg_ptr(GByteArray *buf, int len)
 
 #endif
 
+/**
+ * typedef GDBRegDesc - a register as described to gdb
+ * @gdb_reg: register number used with gdb_read_register()
+ * @name: register name, interned
+ * @feature_name: name of the XML feature the register belongs to, interned
+ */
+typedef struct GDBRegDesc {
+    int gdb_reg;
+    const char *name;
+    const char *feature_name;
+} GDBRegDesc;
+
+/**
+ * gdb_get_register_list: list the registers of a CPU
+ * @cpu: CPU to query
+ *
+ * Build the list of registers from the core and coprocessor XML
+ * descriptions of @cpu. The caller owns the returned array of
+ * #GDBRegDesc.
+ */
+GArray *gdb_get_register_list(CPUState *cpu);
+
+/**
+ * gdb_read_register: read a register of a CPU
+ * @cpu: CPU to read from
+ * @buf: array the value is appended to, in target byte order
+ * @reg: gdb register number
+ *
+ * Returns the size of the register, or 0 if @reg does not exist.
+ */
+int gdb_read_register(CPUState *cpu, GByteArray *buf, int reg);
+
 /**
  * gdbserver_start: start the gdb server
  * @port_or_device: connection spec for gdb
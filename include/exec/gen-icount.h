@@ -55,6 +55,40 @@ static inline void gen_tb_start(const TranslationBlock *tb)
         tcg_gen_brcondi_i32(TCG_COND_LT, count, 0, tcg_ctx->exitreq_label);
     }
 
+    /*
+     * Jumps that do not sync all globals enter here, past the check: the
+     * TB they come from checks for exit requests itself, as leaving from
+     * here would expose the globals it did not sync.
+     */
+    tcg_ctx->chain_label = NULL;
+    if (tcg_chain_liveness && TCG_TARGET_HAS_goto_tb_exitreq &&
+        !(tb_cflags(tb) & (CF_USE_ICOUNT | CF_NOIRQ))) {
+        tcg_ctx->chain_label = gen_new_label();
+        /* referenced by the jumps of other TBs */
+        tcg_ctx->chain_label->refs++;
+        gen_set_label(tcg_ctx->chain_label);
+    }
+
+    /*
+     * Count down the executions of a tier 1 TB, and leave it to be
+     * retranslated once the count hits zero. Tier 1 TBs never use icount,
+     * so nothing has been accounted for yet.
+     */
+    if (tb->tier == 1) {
+        TCGv_ptr ptr = tcg_const_ptr(&tb->tier_count);
+        TCGv_i32 left = tcg_temp_new_i32();
+
+        tcg_ctx->tier_label = gen_new_label();
+        tcg_gen_ld_i32(left, ptr, 0);
+        tcg_gen_subi_i32(left, left, 1);
+        tcg_gen_st_i32(left, ptr, 0);
+        tcg_gen_brcondi_i32(TCG_COND_EQ, left, 0, tcg_ctx->tier_label);
+        tcg_temp_free_i32(left);
+        tcg_temp_free_ptr(ptr);
+    } else {
+        tcg_ctx->tier_label = NULL;
+    }
+
     if (tb_cflags(tb) & CF_USE_ICOUNT) {
         tcg_gen_st16_i32(count, cpu_env,
                          offsetof(ArchCPU, neg.icount_decr.u16.low) -
@@ -89,6 +123,11 @@ static inline void gen_tb_end(const TranslationBlock *tb, int num_insns)
         gen_set_label(tcg_ctx->exitreq_label);
         tcg_gen_exit_tb(tb, TB_EXIT_REQUESTED);
     }
+
+    if (tcg_ctx->tier_label) {
+        gen_set_label(tcg_ctx->tier_label);
+        tcg_gen_exit_tb(tb, TB_EXIT_HOT);
+    }
 }
 
 #endif
@@ -152,10 +152,24 @@ void translator_loop_temp_check(DisasContextBase *db);
  * @dest: target pc of the goto
  *
  * Return true if goto_tb is allowed between the current TB
- * and the destination PC.
+ * and the destination PC. In system emulation the destination
+ * must be on the same page as the start of the TB; user-mode
+ * emulation can chain across pages.
  */
 bool translator_use_goto_tb(DisasContextBase *db, target_ulong dest);
 
+/**
+ * translator_follow_jump
+ * @db: Disassembly context
+ * @dest: target pc of a jump, or fall-through pc of a branch
+ *
+ * Return true if translation should go on at @dest instead of leaving
+ * the TB, which is how tier 2 TBs are made superblocks. @dest must be
+ * ahead of the current instruction, on the page the TB starts on, so
+ * that the TB still covers a single range of guest code.
+ */
+bool translator_follow_jump(DisasContextBase *db, target_ulong dest);
+
 /*
  * Translator Load Functions
  *
@@ -226,6 +226,58 @@ struct hvf_vcpu_state;
 #define TB_JMP_CACHE_BITS 12
 #define TB_JMP_CACHE_SIZE (1 << TB_JMP_CACHE_BITS)
 
+/*
+ * Indirect branch target cache, probed inline by the code
+ * tcg_gen_lookup_and_goto_ptr_cached() emits. Each branch site hashes
+ * to a set of TB_IBTC_WAYS entries, tagged with the TB containing the
+ * site and the guest pc of the target.
+ */
+#define TB_IBTC_BITS 6
+#define TB_IBTC_SIZE (1 << TB_IBTC_BITS)
+#define TB_IBTC_WAYS 2
+
+typedef struct TBIndirectCacheEntry {
+    const void *site;
+    uint64_t pc;
+    const void *tc_ptr;
+} TBIndirectCacheEntry;
+
+typedef struct TBIndirectCacheSet {
+    TBIndirectCacheEntry entry[TB_IBTC_WAYS];
+    unsigned int next; /* way the next fill replaces */
+} TBIndirectCacheSet;
+
+/*
+ * Shadow return stack, see tcg_gen_ras_push() and tcg_gen_ras_return().
+ * Calls push their return address along with the code of the TB at that
+ * address, as cached in the continuation cell of the call site.
+ */
+#define TB_RAS_SIZE 16
+#define TB_RAS_CONT_BITS 8
+#define TB_RAS_CONT_SIZE (1 << TB_RAS_CONT_BITS)
+
+typedef struct TBReturnCont {
+    const void *site; /* the TB of the call */
+    uint64_t pc;
+    const void *tc_ptr;
+    uint32_t flags;   /* of the TB at pc */
+} TBReturnCont;
+
+typedef struct TBReturnStackEntry {
+    uint64_t pc;
+    const void *site;      /* the TB of the call */
+    const void *cont_site; /* site of the continuation cell when pushed */
+    const void *tc_ptr;
+    uint32_t flags;
+    uint32_t cell;         /* continuation cell of the call */
+} TBReturnStackEntry;
+
+typedef struct TBReturnStack {
+    TBReturnStackEntry entry[TB_RAS_SIZE];
+    uint32_t top;
+    TBReturnCont cont[TB_RAS_CONT_SIZE];
+} TBReturnStack;
+
 /* work queue */
 
 /* The union type allows passing of 64 bit target pointers on 32 bit
@@ -356,6 +408,13 @@ struct CPUState {
 
     /* Accessed in parallel; all accesses must be atomic */
     TranslationBlock *tb_jmp_cache[TB_JMP_CACHE_SIZE];
+    /*
+     * Only filled by this vCPU; others may clear the site of an entry,
+     * which must be done atomically.
+     */
+    TBIndirectCacheSet tb_ibtc[TB_IBTC_SIZE];
+    /* Same rules as tb_ibtc, others only clear site and cont_site */
+    TBReturnStack tb_ras;
 
     struct GDBRegisterState *gdb_regs;
     int gdb_num_regs;
@@ -435,6 +494,23 @@ extern CPUTailQ cpus;
 
 extern __thread CPUState *current_cpu;
 
+static inline void cpu_tb_ibtc_clear(CPUState *cpu)
+{
+    unsigned int i, j;
+
+    for (i = 0; i < TB_IBTC_SIZE; i++) {
+        for (j = 0; j < TB_IBTC_WAYS; j++) {
+            qatomic_set(&cpu->tb_ibtc[i].entry[j].site, NULL);
+        }
+    }
+    for (i = 0; i < TB_RAS_SIZE; i++) {
+        qatomic_set(&cpu->tb_ras.entry[i].cont_site, NULL);
+    }
+    for (i = 0; i < TB_RAS_CONT_SIZE; i++) {
+        qatomic_set(&cpu->tb_ras.cont[i].site, NULL);
+    }
+}
+
 static inline void cpu_tb_jmp_cache_clear(CPUState *cpu)
 {
     unsigned int i;
@@ -442,6 +518,7 @@ static inline void cpu_tb_jmp_cache_clear(CPUState *cpu)
     for (i = 0; i < TB_JMP_CACHE_SIZE; i++) {
         qatomic_set(&cpu->tb_jmp_cache[i], NULL);
     }
+    cpu_tb_ibtc_clear(cpu);
 }
 
 /**
@@ -88,6 +88,7 @@ enum plugin_dyn_cb_type {
 enum plugin_dyn_cb_subtype {
     PLUGIN_CB_REGULAR,
     PLUGIN_CB_INLINE,
+    PLUGIN_CB_COND,
     PLUGIN_N_CB_SUBTYPES,
 };
 
@@ -102,12 +103,27 @@ struct qemu_plugin_dyn_cb {
     enum plugin_dyn_cb_subtype type;
     /* @rw applies to mem callbacks only (both regular and inline) */
     enum qemu_plugin_mem_rw rw;
+    /* @flags applies to udata callbacks only */
+    enum qemu_plugin_cb_flags flags;
     /* fields specific to each dyn_cb type go here */
     union {
         struct {
             enum qemu_plugin_op op;
             uint64_t imm;
+            /*
+             * Distance between the copies of the target of two consecutive
+             * vCPUs; userp points to the copy of vCPU 0. Zero when all
+             * vCPUs share a single location.
+             */
+            size_t stride;
         } inline_insn;
+        /* @f and @userp describe the callback, called if *ptr @cond @imm */
+        struct {
+            void *ptr;
+            size_t stride;
+            enum qemu_plugin_cond cond;
+            uint64_t imm;
+        } cond;
     };
 };
 
@@ -212,6 +228,8 @@ void qemu_plugin_atexit_cb(void);
 
 void qemu_plugin_add_dyn_cb_arr(GArray *arr);
 
+bool qemu_plugin_have_cond_cbs(void);
+
 void qemu_plugin_disable_mem_helpers(CPUState *cpu);
 
 /**
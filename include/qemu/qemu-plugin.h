@@ -50,7 +50,7 @@ typedef uint64_t qemu_plugin_id_t;
 
 extern QEMU_PLUGIN_EXPORT int qemu_plugin_version;
 
-#define QEMU_PLUGIN_VERSION 1
+#define QEMU_PLUGIN_VERSION 2
 
 /**
  * struct qemu_info_t - system information for plugins
@@ -209,6 +209,19 @@ void qemu_plugin_register_vcpu_resume_cb(qemu_plugin_id_t id,
 struct qemu_plugin_tb;
 /** struct qemu_plugin_insn - Opaque handle for a translated instruction */
 struct qemu_plugin_insn;
+/** struct qemu_plugin_scoreboard - Opaque handle for a scoreboard */
+struct qemu_plugin_scoreboard;
+
+/**
+ * typedef qemu_plugin_u64 - uint64_t member of an entry in a scoreboard
+ *
+ * This field allows to access a specific uint64_t member in one given entry,
+ * located at a specified offset. Inline operations expect this as entry.
+ */
+typedef struct {
+    struct qemu_plugin_scoreboard *score;
+    size_t offset;
+} qemu_plugin_u64;
 
 /**
  * enum qemu_plugin_cb_flags - type of callback
@@ -217,8 +230,10 @@ struct qemu_plugin_insn;
  * @QEMU_PLUGIN_CB_R_REGS: callback reads the CPU's regs
  * @QEMU_PLUGIN_CB_RW_REGS: callback reads and writes the CPU's regs
  *
- * Note: currently unused, plugins cannot read or change system
- * register state.
+ * Instruction and block callbacks registered with R_REGS or RW_REGS
+ * may call qemu_plugin_read_register(); the register state is synced
+ * before they are called. Plugins cannot change register state so
+ * RW_REGS behaves as R_REGS.
  */
 enum qemu_plugin_cb_flags {
     QEMU_PLUGIN_CB_NO_REGS,
@@ -281,6 +296,60 @@ enum qemu_plugin_op {
     QEMU_PLUGIN_INLINE_ADD_U64,
 };
 
+/**
+ * enum qemu_plugin_cond - condition to enable callback
+ *
+ * @QEMU_PLUGIN_COND_NEVER: false
+ * @QEMU_PLUGIN_COND_ALWAYS: true
+ * @QEMU_PLUGIN_COND_EQ: is equal?
+ * @QEMU_PLUGIN_COND_NE: is not equal?
+ * @QEMU_PLUGIN_COND_LT: is less than?
+ * @QEMU_PLUGIN_COND_LE: is less than or equal?
+ * @QEMU_PLUGIN_COND_GT: is greater than?
+ * @QEMU_PLUGIN_COND_GE: is greater than or equal?
+ *
+ * Comparisons are unsigned.
+ */
+enum qemu_plugin_cond {
+    QEMU_PLUGIN_COND_NEVER,
+    QEMU_PLUGIN_COND_ALWAYS,
+    QEMU_PLUGIN_COND_EQ,
+    QEMU_PLUGIN_COND_NE,
+    QEMU_PLUGIN_COND_LT,
+    QEMU_PLUGIN_COND_LE,
+    QEMU_PLUGIN_COND_GT,
+    QEMU_PLUGIN_COND_GE,
+};
+
+/**
+ * qemu_plugin_register_vcpu_tb_exec_cond_cb() - register conditional callback
+ * @tb: the opaque qemu_plugin_tb handle for the translation
+ * @cb: callback function
+ * @flags: does the plugin read or write the CPU's registers?
+ * @cond: condition to enable callback
+ * @entry: first operand for condition
+ * @imm: second operand for condition
+ * @userdata: any plugin data to pass to the @cb?
+ *
+ * The @cb function is called when a translated unit executes if
+ * @entry @cond @imm is true, as evaluated for the executing vCPU. The
+ * test is inlined, so the cost of a callback is only paid when the
+ * condition holds. Combined with an inline add on @entry this allows
+ * sampling one execution every N: the callback resets the counter with
+ * qemu_plugin_u64_set().
+ * If condition is QEMU_PLUGIN_COND_ALWAYS, condition is never interpreted and
+ * this function is equivalent to qemu_plugin_register_vcpu_tb_exec_cb.
+ * If condition QEMU_PLUGIN_COND_NEVER, condition is never interpreted and
+ * callback is never installed.
+ */
+void qemu_plugin_register_vcpu_tb_exec_cond_cb(struct qemu_plugin_tb *tb,
+                                               qemu_plugin_vcpu_udata_cb_t cb,
+                                               enum qemu_plugin_cb_flags flags,
+                                               enum qemu_plugin_cond cond,
+                                               qemu_plugin_u64 entry,
+                                               uint64_t imm,
+                                               void *userdata);
+
 /**
  * qemu_plugin_register_vcpu_tb_exec_inline() - execution inline op
  * @tb: the opaque qemu_plugin_tb handle for the translation
@@ -299,6 +368,24 @@ void qemu_plugin_register_vcpu_tb_exec_inline(struct qemu_plugin_tb *tb,
                                               enum qemu_plugin_op op,
                                               void *ptr, uint64_t imm);
 
+/**
+ * qemu_plugin_register_vcpu_tb_exec_inline_per_vcpu() - per-vCPU inline op
+ * @tb: the opaque qemu_plugin_tb handle for the translation
+ * @op: the type of qemu_plugin_op (e.g. ADD_U64)
+ * @entry: entry of a scoreboard to update
+ * @imm: the op data (e.g. 1)
+ *
+ * Like qemu_plugin_register_vcpu_tb_exec_inline() but the op is applied
+ * to the copy of @entry belonging to the vCPU executing the block.
+ * Different vCPUs never touch the same cache line so the update is
+ * exact and scales under MTTCG.
+ */
+void qemu_plugin_register_vcpu_tb_exec_inline_per_vcpu(
+    struct qemu_plugin_tb *tb,
+    enum qemu_plugin_op op,
+    qemu_plugin_u64 entry,
+    uint64_t imm);
+
 /**
  * qemu_plugin_register_vcpu_insn_exec_cb() - register insn execution cb
  * @insn: the opaque qemu_plugin_insn handle for an instruction
@@ -313,6 +400,29 @@ void qemu_plugin_register_vcpu_insn_exec_cb(struct qemu_plugin_insn *insn,
                                             enum qemu_plugin_cb_flags flags,
                                             void *userdata);
 
+/**
+ * qemu_plugin_register_vcpu_insn_exec_cond_cb() - conditional insn execution cb
+ * @insn: the opaque qemu_plugin_insn handle for an instruction
+ * @cb: callback function
+ * @flags: does the plugin read or write the CPU's registers?
+ * @cond: condition to enable callback
+ * @entry: first operand for condition
+ * @imm: second operand for condition
+ * @userdata: any plugin data to pass to the @cb?
+ *
+ * The @cb function is called when an instruction executes if
+ * @entry @cond @imm is true. See
+ * qemu_plugin_register_vcpu_tb_exec_cond_cb() for details.
+ */
+void qemu_plugin_register_vcpu_insn_exec_cond_cb(
+    struct qemu_plugin_insn *insn,
+    qemu_plugin_vcpu_udata_cb_t cb,
+    enum qemu_plugin_cb_flags flags,
+    enum qemu_plugin_cond cond,
+    qemu_plugin_u64 entry,
+    uint64_t imm,
+    void *userdata);
+
 /**
  * qemu_plugin_register_vcpu_insn_exec_inline() - insn execution inline op
  * @insn: the opaque qemu_plugin_insn handle for an instruction
@@ -327,6 +437,21 @@ void qemu_plugin_register_vcpu_insn_exec_inline(struct qemu_plugin_insn *insn,
                                                 enum qemu_plugin_op op,
                                                 void *ptr, uint64_t imm);
 
+/**
+ * qemu_plugin_register_vcpu_insn_exec_inline_per_vcpu() - per-vCPU inline op
+ * @insn: the opaque qemu_plugin_insn handle for an instruction
+ * @op: the type of qemu_plugin_op (e.g. ADD_U64)
+ * @entry: entry of a scoreboard to update
+ * @imm: the op data (e.g. 1)
+ *
+ * Per-vCPU variant of qemu_plugin_register_vcpu_insn_exec_inline().
+ */
+void qemu_plugin_register_vcpu_insn_exec_inline_per_vcpu(
+    struct qemu_plugin_insn *insn,
+    enum qemu_plugin_op op,
+    qemu_plugin_u64 entry,
+    uint64_t imm);
+
 /**
  * qemu_plugin_tb_n_insns() - query helper for number of insns in TB
  * @tb: opaque handle to TB passed to callback
@@ -496,6 +621,23 @@ void qemu_plugin_register_vcpu_mem_inline(struct qemu_plugin_insn *insn,
                                           enum qemu_plugin_op op, void *ptr,
                                           uint64_t imm);
 
+/**
+ * qemu_plugin_register_vcpu_mem_inline_per_vcpu() - per-vCPU inline op
+ * @insn: handle for instruction to instrument
+ * @rw: apply to reads, writes or both
+ * @op: the op, of type qemu_plugin_op
+ * @entry: entry of a scoreboard to update
+ * @imm: immediate data for @op
+ *
+ * Per-vCPU variant of qemu_plugin_register_vcpu_mem_inline().
+ */
+void qemu_plugin_register_vcpu_mem_inline_per_vcpu(
+    struct qemu_plugin_insn *insn,
+    enum qemu_plugin_mem_rw rw,
+    enum qemu_plugin_op op,
+    qemu_plugin_u64 entry,
+    uint64_t imm);
+
 
 
 typedef void
@@ -571,12 +713,204 @@ int qemu_plugin_n_vcpus(void);
 /* returns -1 in user-mode */
 int qemu_plugin_n_max_vcpus(void);
 
+/**
+ * qemu_plugin_scoreboard_new() - alloc a new scoreboard
+ * @element_size: size (in bytes) for one entry
+ *
+ * A scoreboard is an array of values, indexed by vcpu_index. Each vCPU
+ * gets its own cache-line aligned entry, so that vCPUs updating their
+ * own entry do not contend with each other. Entries are zeroed on
+ * allocation and the scoreboard grows automatically as vCPUs are
+ * created.
+ *
+ * Returns: a new scoreboard. It must be freed using
+ * qemu_plugin_scoreboard_free.
+ */
+struct qemu_plugin_scoreboard *qemu_plugin_scoreboard_new(size_t element_size);
+
+/**
+ * qemu_plugin_scoreboard_free() - free a scoreboard
+ * @score: scoreboard to free
+ */
+void qemu_plugin_scoreboard_free(struct qemu_plugin_scoreboard *score);
+
+/**
+ * qemu_plugin_scoreboard_find() - get pointer to an entry of a scoreboard
+ * @score: scoreboard to query
+ * @vcpu_index: entry index
+ *
+ * Returns: address of the entry of @vcpu_index. The address is only
+ * valid until the next vCPU is created, which may move the scoreboard.
+ */
+void *qemu_plugin_scoreboard_find(struct qemu_plugin_scoreboard *score,
+                                  unsigned int vcpu_index);
+
+/* Macros to define a qemu_plugin_u64 */
+#define qemu_plugin_scoreboard_u64(score) \
+    (qemu_plugin_u64) {score, 0}
+#define qemu_plugin_scoreboard_u64_in_struct(score, type, member) \
+    (qemu_plugin_u64) {score, offsetof(type, member)}
+
+/**
+ * qemu_plugin_u64_add() - add a value to a qemu_plugin_u64 for a given vcpu
+ * @entry: entry to query
+ * @vcpu_index: entry index
+ * @added: value to add
+ */
+void qemu_plugin_u64_add(qemu_plugin_u64 entry, unsigned int vcpu_index,
+                         uint64_t added);
+
+/**
+ * qemu_plugin_u64_get() - get value of a qemu_plugin_u64 for a given vcpu
+ * @entry: entry to query
+ * @vcpu_index: entry index
+ */
+uint64_t qemu_plugin_u64_get(qemu_plugin_u64 entry, unsigned int vcpu_index);
+
+/**
+ * qemu_plugin_u64_set() - set value of a qemu_plugin_u64 for a given vcpu
+ * @entry: entry to query
+ * @vcpu_index: entry index
+ * @val: new value
+ */
+void qemu_plugin_u64_set(qemu_plugin_u64 entry, unsigned int vcpu_index,
+                         uint64_t val);
+
+/**
+ * qemu_plugin_u64_sum() - return sum of all vcpu entries in a scoreboard
+ * @entry: entry to sum
+ */
+uint64_t qemu_plugin_u64_sum(qemu_plugin_u64 entry);
+
+/** struct qemu_plugin_register - Opaque handle for register access */
+struct qemu_plugin_register;
+
+/**
+ * typedef qemu_plugin_reg_descriptor - register descriptions
+ *
+ * @handle: opaque handle for retrieving value with qemu_plugin_read_register
+ * @name: register name
+ * @feature: optional feature descriptor, can be NULL
+ */
+typedef struct {
+    struct qemu_plugin_register *handle;
+    const char *name;
+    const char *feature;
+} qemu_plugin_reg_descriptor;
+
+/**
+ * qemu_plugin_get_registers() - return register list for current vCPU
+ * @n_regs: set to the number of registers returned
+ *
+ * Returns an array of register descriptors for the vCPU the calling
+ * callback runs on, taken from the descriptions the gdbstub uses. It
+ * must be called from a vCPU callback (e.g. the vCPU init callback).
+ * The array must be freed by the caller with g_free(); the handles and
+ * strings in it are valid for the lifetime of the plugin.
+ *
+ * Returns: array of @n_regs descriptors
+ */
+qemu_plugin_reg_descriptor *qemu_plugin_get_registers(size_t *n_regs);
+
+/**
+ * qemu_plugin_read_register() - read register of current vCPU
+ * @handle: a @qemu_plugin_reg_descriptor handle
+ * @buf: buffer the value is copied to
+ * @len: size of @buf
+ *
+ * Copies the value of a register of the vCPU the calling callback runs
+ * on into @buf, in target byte order, truncated to @len bytes. The
+ * callback must have been registered with QEMU_PLUGIN_CB_R_REGS.
+ *
+ * The program counter is only updated at the end of each block, use
+ * qemu_plugin_insn_vaddr() to know which instruction is executing.
+ *
+ * Returns: size of the register in bytes, 0 if it cannot be read, or -1
+ * if @handle is NULL
+ */
+int qemu_plugin_read_register(struct qemu_plugin_register *handle,
+                              void *buf, size_t len);
+
 /**
  * qemu_plugin_outs() - output string via QEMU's logging system
  * @string: a string
  */
 void qemu_plugin_outs(const char *string);
 
+/**
+ * DOC: binary traces
+ *
+ * Formatting text for every executed instruction is slow. Plugins that
+ * produce large traces can instead hand binary records to a trace
+ * writer, which buffers them per stream and writes them to a file from
+ * a background thread.
+ *
+ * The file starts with a &qemu_plugin_trace_header, after which the
+ * rest of the file is optionally a single zstd frame. The content is a
+ * sequence of chunks, each a &qemu_plugin_trace_chunk followed by
+ * @len bytes of records written to the same stream, in the order they
+ * were written. Chunks never split a record. All fields are in host
+ * byte order.
+ */
+
+#define QEMU_PLUGIN_TRACE_MAGIC "QPLTRACE"
+#define QEMU_PLUGIN_TRACE_VERSION 1
+
+/* the body of the file is zstd compressed */
+#define QEMU_PLUGIN_TRACE_ZSTD (1 << 0)
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+} qemu_plugin_trace_header;
+
+typedef struct {
+    uint32_t stream;
+    uint32_t len;
+} qemu_plugin_trace_chunk;
+
+struct qemu_plugin_trace;
+
+/**
+ * qemu_plugin_trace_open() - create a binary trace file
+ * @path: file to write the trace to
+ * @compress: compress the trace with zstd
+ *
+ * Starts the background thread writing the trace.
+ *
+ * Returns: a trace handle, or NULL if the file cannot be created or
+ * compression was asked for but QEMU was built without zstd
+ */
+struct qemu_plugin_trace *qemu_plugin_trace_open(const char *path,
+                                                 bool compress);
+
+/**
+ * qemu_plugin_trace_write() - append a record to a trace stream
+ * @trace: trace handle
+ * @stream: stream to append to, usually the vCPU index
+ * @data: record
+ * @len: size of @data
+ *
+ * Each stream has a single writer: only one thread at a time may write
+ * to a given stream, which lets records be queued without locking.
+ * The call only blocks if the stream's buffer is full.
+ *
+ * Returns: true on success, false if @len is too large for a record
+ */
+bool qemu_plugin_trace_write(struct qemu_plugin_trace *trace,
+                             unsigned int stream,
+                             const void *data, size_t len);
+
+/**
+ * qemu_plugin_trace_close() - flush and close a trace
+ * @trace: trace handle
+ *
+ * No more records may be written to @trace, typically this is called
+ * from the atexit callback.
+ */
+void qemu_plugin_trace_close(struct qemu_plugin_trace *trace);
+
 /**
  * qemu_plugin_bool_parse() - parses a boolean argument in the form of
  * "<argname>=[on|yes|true|off|no|false]"
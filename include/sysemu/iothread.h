@@ -40,6 +40,11 @@ struct IOThread {
 
     /* AioContext AIO engine parameters */
     int64_t aio_max_batch;
+
+    /* AioContext io_uring parameters */
+    bool io_uring_sqpoll;
+    bool io_uring_fixed_files;
+    bool io_uring_fixed_buffers;
 };
 typedef struct IOThread IOThread;
 
@@ -830,6 +830,47 @@ void tcg_gen_goto_tb(unsigned idx);
  */
 void tcg_gen_lookup_and_goto_ptr(void);
 
+/**
+ * tcg_gen_lookup_and_goto_ptr_cached() - indirect branch through a cache
+ * @tb: the TB being translated
+ * @dest: guest address of the target TB, already stored in the CPU state
+ *
+ * Like tcg_gen_lookup_and_goto_ptr(), but first compares @dest with the
+ * last TB_IBTC_WAYS targets of this branch, and jumps straight to the
+ * matching one. Only on a miss is the lookup helper called.
+ *
+ * The TB state of the target other than its pc is assumed to be that
+ * of @tb, possibly changed by @tb in the same way on every execution.
+ * Branches that can switch modes must use tcg_gen_lookup_and_goto_ptr().
+ */
+void tcg_gen_lookup_and_goto_ptr_cached(const TranslationBlock *tb,
+                                        TCGv dest);
+
+/**
+ * tcg_gen_ras_push() - push a return address on the shadow return stack
+ * @tb: the TB being translated
+ * @ret_addr: guest address the call returns to
+ *
+ * Emitted by calls when the return stack is enabled, before the jump to
+ * the callee. The code of the TB at @ret_addr last seen returning from
+ * this call is pushed along with @ret_addr.
+ */
+void tcg_gen_ras_push(const TranslationBlock *tb, target_ulong ret_addr);
+
+/**
+ * tcg_gen_ras_return() - return through the shadow return stack
+ * @tb: the TB being translated
+ * @dest: guest address of the target TB, already stored in the CPU state
+ * @flags: the TB flags of the CPU state at the return
+ *
+ * Pops the top of the return stack and, if it holds @dest and code
+ * translated for @flags, jumps straight to that code. Otherwise, or if
+ * the return stack is disabled, this is
+ * tcg_gen_lookup_and_goto_ptr_cached(); the same restrictions apply.
+ */
+void tcg_gen_ras_return(const TranslationBlock *tb, TCGv dest,
+                        uint32_t flags);
+
 static inline void tcg_gen_plugin_cb_start(unsigned from, unsigned type,
                                            unsigned wr)
 {
@@ -844,6 +885,7 @@ static inline void tcg_gen_plugin_cb_end(void)
 #if TARGET_LONG_BITS == 32
 #define tcg_temp_new() tcg_temp_new_i32()
 #define tcg_global_mem_new tcg_global_mem_new_i32
+#define tcg_global_flag_new tcg_global_flag_new_i32
 #define tcg_temp_local_new() tcg_temp_local_new_i32()
 #define tcg_temp_free tcg_temp_free_i32
 #define tcg_gen_qemu_ld_tl tcg_gen_qemu_ld_i32
@@ -851,6 +893,7 @@ static inline void tcg_gen_plugin_cb_end(void)
 #else
 #define tcg_temp_new() tcg_temp_new_i64()
 #define tcg_global_mem_new tcg_global_mem_new_i64
+#define tcg_global_flag_new tcg_global_flag_new_i64
 #define tcg_temp_local_new() tcg_temp_local_new_i64()
 #define tcg_temp_free tcg_temp_free_i64
 #define tcg_gen_qemu_ld_tl tcg_gen_qemu_ld_i64
@@ -1282,6 +1325,12 @@ static inline void tcg_gen_addi_ptr(TCGv_ptr r, TCGv_ptr a, intptr_t b)
     glue(tcg_gen_addi_,PTR)((NAT)r, (NAT)a, b);
 }
 
+static inline void tcg_gen_brcond_ptr(TCGCond cond, TCGv_ptr a,
+                                      TCGv_ptr b, TCGLabel *label)
+{
+    glue(tcg_gen_brcond_,PTR)(cond, (NAT)a, (NAT)b, label);
+}
+
 static inline void tcg_gen_brcondi_ptr(TCGCond cond, TCGv_ptr a,
                                        intptr_t b, TCGLabel *label)
 {
@@ -206,6 +206,10 @@ typedef uint64_t TCGRegSet;
 #ifndef TCG_TARGET_HAS_v256
 #define TCG_TARGET_HAS_v256             0
 #endif
+/* goto_tb can check for exit requests, needed by tcg_chain_liveness */
+#ifndef TCG_TARGET_HAS_goto_tb_exitreq
+#define TCG_TARGET_HAS_goto_tb_exitreq  0
+#endif
 
 #ifndef TARGET_INSN_START_EXTRA_WORDS
 # define TARGET_INSN_START_WORDS 1
@@ -260,6 +264,8 @@ struct TCGLabel {
     unsigned has_value : 1;
     unsigned id : 14;
     unsigned refs : 16;
+    /* Flags overwritten after the label, see tcg_global_flag_new_i32() */
+    uint16_t dead_flags;
     union {
         uintptr_t value;
         const tcg_insn_unit *value_ptr;
@@ -278,6 +284,7 @@ typedef struct TCGPool {
 
 #define TCG_MAX_TEMPS 512
 #define TCG_MAX_INSNS 512
+#define TCG_MAX_FLAGS 16
 
 /* when the size of the arguments of a called function is smaller than
    this value, they are statically allocated in the TB stack frame */
@@ -539,6 +546,10 @@ struct TCGContext {
     int nb_indirects;
     int nb_ops;
 
+    /* Indexes of the condition flag globals */
+    int nb_flags;
+    uint16_t flags[TCG_MAX_FLAGS];
+
     /* goto_tb support */
     tcg_insn_unit *code_buf;
     uint16_t *tb_jmp_reset_offset; /* tb->jmp_reset_offset */
@@ -588,6 +599,9 @@ struct TCGContext {
 #endif
 
     TCGLabel *exitreq_label;
+    TCGLabel *tier_label;
+    /* Entry of the jumps that skip syncing globals, see tcg_chain_liveness */
+    TCGLabel *chain_label;
 
 #ifdef CONFIG_PLUGIN
     /*
@@ -617,6 +631,25 @@ struct TCGContext {
     uint16_t gen_insn_end_off[TCG_MAX_INSNS];
     target_ulong gen_insn_data[TCG_MAX_INSNS][TARGET_INSN_START_WORDS];
 
+    /* Direct jump destinations of the TB, see translator_use_goto_tb() */
+    target_ulong goto_tb_dest[2];
+    int nb_goto_tb_dest;
+    /* Index in goto_tb_dest[] of the destination of each goto_tb, or -1 */
+    int goto_tb_slot[2];
+    /* Indirect branch sites of the TB so far, see tb_site_hash() */
+    int nb_branch_sites;
+
+    /*
+     * Chained liveness, see tcg_chain_liveness. Bit i stands for global i.
+     * goto_tb_carry[] are the globals the TB following each goto_tb
+     * overwrites before reading them (all ones if it is the TB being
+     * translated), goto_tb_nosync[] those each goto_tb does not sync, and
+     * chain_dead_in those this TB overwrites after chain_label.
+     */
+    uint64_t goto_tb_carry[2];
+    uint64_t goto_tb_nosync[2];
+    uint64_t chain_dead_in;
+
     /* Exit to translator on overflow. */
     sigjmp_buf jmp_trans;
 };
@@ -630,8 +663,19 @@ extern __thread TCGContext *tcg_ctx;
 extern const void *tcg_code_gen_epilogue;
 extern uintptr_t tcg_splitwx_diff;
 extern TCGv_env cpu_env;
+/* Emit shadow return stack code, see tcg_gen_ras_push() */
+extern bool tcg_return_stack;
+/* Make room by evicting the oldest regions, see tcg_region_evict() */
+extern bool tcg_tb_evict;
+/* Executions after which a TB is retranslated as a superblock, or 0 */
+extern unsigned int tcg_tier_threshold;
+/* Let direct jumps skip syncing globals the next TB overwrites */
+extern bool tcg_chain_liveness;
+/* Preferred address of the code buffer, or NULL, see tb_cache_open() */
+extern void *tcg_code_gen_hint;
 
 bool in_code_gen_buffer(const void *p);
+void tcg_host_features(char *buf, size_t len);
 
 #ifdef CONFIG_DEBUG_TCG
 const void *tcg_splitwx_to_rx(void *rw);
@@ -801,6 +845,7 @@ void tcg_pool_reset(TCGContext *s);
 TranslationBlock *tcg_tb_alloc(TCGContext *s);
 
 void tcg_region_reset_all(void);
+size_t tcg_region_evict(GTraverseFunc func, gpointer user_data);
 
 size_t tcg_code_size(void);
 size_t tcg_code_capacity(void);
@@ -841,6 +886,7 @@ void tcg_set_frame(TCGContext *s, TCGReg reg, intptr_t start, intptr_t size);
 
 TCGTemp *tcg_global_mem_new_internal(TCGType, TCGv_ptr,
                                      intptr_t, const char *);
+void tcg_global_set_flag(TCGTemp *);
 TCGTemp *tcg_temp_new_internal(TCGType, bool);
 void tcg_temp_free_internal(TCGTemp *);
 TCGv_vec tcg_temp_new_vec(TCGType type);
@@ -873,6 +919,27 @@ static inline TCGv_i32 tcg_global_mem_new_i32(TCGv_ptr reg, intptr_t offset,
     return temp_tcgv_i32(t);
 }
 
+/**
+ * tcg_global_flag_new_i32:
+ * @reg: base of the global, usually cpu_env
+ * @offset: offset of the global from @reg
+ * @name: name of the global
+ *
+ * Like tcg_global_mem_new_i32(), for a global holding guest condition
+ * flags, or what they are computed from. Liveness analysis follows flags
+ * across the branches of a TB, so that a flag computation is dropped
+ * when every path overwrites it before reading it or leaving the TB.
+ * Only the first TCG_MAX_FLAGS globals are followed, later ones behave
+ * like those of tcg_global_mem_new_i32().
+ */
+static inline TCGv_i32 tcg_global_flag_new_i32(TCGv_ptr reg, intptr_t offset,
+                                               const char *name)
+{
+    TCGTemp *t = tcg_global_mem_new_internal(TCG_TYPE_I32, reg, offset, name);
+    tcg_global_set_flag(t);
+    return temp_tcgv_i32(t);
+}
+
 static inline TCGv_i32 tcg_temp_new_i32(void)
 {
     TCGTemp *t = tcg_temp_new_internal(TCG_TYPE_I32, false);
@@ -892,6 +959,15 @@ static inline TCGv_i64 tcg_global_mem_new_i64(TCGv_ptr reg, intptr_t offset,
     return temp_tcgv_i64(t);
 }
 
+/* See tcg_global_flag_new_i32() */
+static inline TCGv_i64 tcg_global_flag_new_i64(TCGv_ptr reg, intptr_t offset,
+                                               const char *name)
+{
+    TCGTemp *t = tcg_global_mem_new_internal(TCG_TYPE_I64, reg, offset, name);
+    tcg_global_set_flag(t);
+    return temp_tcgv_i64(t);
+}
+
 static inline TCGv_i64 tcg_temp_new_i64(void)
 {
     TCGTemp *t = tcg_temp_new_internal(TCG_TYPE_I64, false);
@@ -1000,6 +1076,7 @@ do {\
 bool tcg_op_supported(TCGOpcode op);
 
 void tcg_gen_callN(void *func, TCGTemp *ret, int nargs, TCGTemp **args);
+const struct TCGHelperInfo *tcg_helper_info_lookup(void *func);
 
 TCGOp *tcg_emit_op(TCGOpcode opc);
 void tcg_op_remove(TCGContext *s, TCGOp *op);
@@ -1163,11 +1240,9 @@ static inline size_t tcg_current_code_size(TCGContext *s)
  *        TB index (0 or 1). That is, we left the TB via (the equivalent
  *        of) "goto_tb <index>". The main loop uses this to determine
  *        how to link the TB just executed to the next.
- *  2:    we are using instruction counting code generation, and we
- *        did not start executing this TB because the instruction counter
- *        would hit zero midway through it. In this case the pointer
- *        returned is the TB we were about to execute, and the caller must
- *        arrange to execute the remaining count of instructions.
+ *  2:    the execution counter of this tier 1 TB hit zero, and the TB
+ *        should be retranslated as a superblock before it is run. The
+ *        pointer returned is the TB we were about to execute.
  *  3:    we stopped because the CPU's exit_request flag was set
  *        (usually meaning that there is an interrupt that needs to be
  *        handled). The pointer returned is the TB we were about to execute
@@ -1190,6 +1265,7 @@ static inline size_t tcg_current_code_size(TCGContext *s)
 #define TB_EXIT_IDX0      0
 #define TB_EXIT_IDX1      1
 #define TB_EXIT_IDXMAX    1
+#define TB_EXIT_HOT       2
 #define TB_EXIT_REQUESTED 3
 
 #ifdef CONFIG_TCG_INTERPRETER
@@ -168,6 +168,15 @@ static void iothread_set_aio_context_params(IOThread *iothread, Error **errp)
     aio_context_set_aio_params(iothread->ctx,
                                iothread->aio_max_batch,
                                errp);
+    if (*errp) {
+        return;
+    }
+
+    aio_context_set_io_uring_params(iothread->ctx,
+                                    iothread->io_uring_sqpoll,
+                                    iothread->io_uring_fixed_files,
+                                    iothread->io_uring_fixed_buffers,
+                                    errp);
 }
 
 static void iothread_complete(UserCreatable *obj, Error **errp)
@@ -313,6 +322,45 @@ static void iothread_set_aio_param(Object *obj, Visitor *v,
     }
 }
 
+static bool *iothread_io_uring_param(IOThread *iothread, const char *name)
+{
+    if (!strcmp(name, "io-uring-sqpoll")) {
+        return &iothread->io_uring_sqpoll;
+    } else if (!strcmp(name, "io-uring-fixed-files")) {
+        return &iothread->io_uring_fixed_files;
+    }
+    return &iothread->io_uring_fixed_buffers;
+}
+
+static void iothread_get_io_uring_param(Object *obj, Visitor *v,
+        const char *name, void *opaque, Error **errp)
+{
+    IOThread *iothread = IOTHREAD(obj);
+
+    visit_type_bool(v, name, iothread_io_uring_param(iothread, name), errp);
+}
+
+static void iothread_set_io_uring_param(Object *obj, Visitor *v,
+        const char *name, void *opaque, Error **errp)
+{
+    IOThread *iothread = IOTHREAD(obj);
+    bool value;
+
+    if (!visit_type_bool(v, name, &value, errp)) {
+        return;
+    }
+
+    *iothread_io_uring_param(iothread, name) = value;
+
+    if (iothread->ctx) {
+        aio_context_set_io_uring_params(iothread->ctx,
+                                        iothread->io_uring_sqpoll,
+                                        iothread->io_uring_fixed_files,
+                                        iothread->io_uring_fixed_buffers,
+                                        errp);
+    }
+}
+
 static void iothread_class_init(ObjectClass *klass, void *class_data)
 {
     UserCreatableClass *ucc = USER_CREATABLE_CLASS(klass);
@@ -334,6 +382,18 @@ static void iothread_class_init(ObjectClass *klass, void *class_data)
                               iothread_get_aio_param,
                               iothread_set_aio_param,
                               NULL, &aio_max_batch_info);
+    object_class_property_add(klass, "io-uring-sqpoll", "bool",
+                              iothread_get_io_uring_param,
+                              iothread_set_io_uring_param,
+                              NULL, NULL);
+    object_class_property_add(klass, "io-uring-fixed-files", "bool",
+                              iothread_get_io_uring_param,
+                              iothread_set_io_uring_param,
+                              NULL, NULL);
+    object_class_property_add(klass, "io-uring-fixed-buffers", "bool",
+                              iothread_get_io_uring_param,
+                              iothread_set_io_uring_param,
+                              NULL, NULL);
 }
 
 static const TypeInfo iothread_info = {
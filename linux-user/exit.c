@@ -37,5 +37,6 @@ void preexit_cleanup(CPUArchState *env, int code)
         __gcov_dump();
 #endif
         gdb_exit(code);
+        tb_cache_save();
         qemu_plugin_user_exit();
 }
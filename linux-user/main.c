@@ -133,11 +133,13 @@ void fork_start(void)
 {
     start_exclusive();
     mmap_fork_start();
+    translate_pool_fork_start();
     cpu_list_lock();
 }
 
 void fork_end(int child)
 {
+    translate_pool_fork_end(child);
     mmap_fork_end(child);
     if (child) {
         CPUState *cpu, *next_cpu;
@@ -375,6 +377,58 @@ static void handle_arg_singlestep(const char *arg)
     singlestep = 1;
 }
 
+static bool chain_liveness;
+
+static void handle_arg_chain_liveness(const char *arg)
+{
+    chain_liveness = true;
+}
+
+static bool return_stack;
+
+static void handle_arg_return_stack(const char *arg)
+{
+    return_stack = true;
+}
+
+static bool tb_evict;
+
+static void handle_arg_tb_evict(const char *arg)
+{
+    tb_evict = true;
+}
+
+static uint32_t tier_threshold;
+
+static void handle_arg_tier_threshold(const char *arg)
+{
+    char *p;
+
+    tier_threshold = strtoul(arg, &p, 0);
+    if (*p) {
+        usage(EXIT_FAILURE);
+    }
+}
+
+static unsigned int translate_threads;
+
+static void handle_arg_translate_threads(const char *arg)
+{
+    char *p;
+
+    translate_threads = strtoul(arg, &p, 0);
+    if (*p) {
+        usage(EXIT_FAILURE);
+    }
+}
+
+static const char *tb_cache_dir;
+
+static void handle_arg_tb_cache(const char *arg)
+{
+    tb_cache_dir = arg;
+}
+
 static void handle_arg_strace(const char *arg)
 {
     enable_strace = true;
@@ -453,6 +507,20 @@ static const struct qemu_argument arg_table[] = {
      "pagesize",   "set the host page size to 'pagesize'"},
     {"singlestep", "QEMU_SINGLESTEP",  false, handle_arg_singlestep,
      "",           "run in singlestep mode"},
+    {"chain-liveness", "QEMU_CHAIN_LIVENESS", false,
+     handle_arg_chain_liveness,
+     "",           "skip register stores the next chained block overwrites"},
+    {"return-stack", "QEMU_RETURN_STACK", false, handle_arg_return_stack,
+     "",           "predict returns with a shadow return stack"},
+    {"tb-evict",   "QEMU_TB_EVICT",    false, handle_arg_tb_evict,
+     "",           "evict the oldest translations when the cache is full"},
+    {"tier-threshold", "QEMU_TIER_THRESHOLD", true, handle_arg_tier_threshold,
+     "count",      "retranslate blocks run 'count' times as superblocks"},
+    {"translate-threads", "QEMU_TRANSLATE_THREADS", true,
+     handle_arg_translate_threads,
+     "count",      "translate ahead of the guest in 'count' threads"},
+    {"tb-cache",   "QEMU_TB_CACHE",    true,  handle_arg_tb_cache,
+     "dir",        "keep translated code in 'dir' across runs"},
     {"strace",     "QEMU_STRACE",      false, handle_arg_strace,
      "",           "log system calls"},
     {"seed",       "QEMU_RAND_SEED",   true,  handle_arg_seed,
@@ -673,6 +741,11 @@ int main(int argc, char **argv, char **envp)
         exit(1);
     }
     trace_init_file();
+    if (tb_cache_dir && !QTAILQ_EMPTY(&plugins)) {
+        /* instrumented code points to the plugins' data */
+        error_report("-tb-cache is ignored with plugins");
+        tb_cache_dir = NULL;
+    }
     qemu_plugin_load_list(&plugins, &error_fatal);
 
     /* Zero out regs */
@@ -718,11 +791,22 @@ int main(int argc, char **argv, char **envp)
         cpu_model = cpu_get_model(get_elf_eflags(execfd));
     }
     cpu_type = parse_cpu_option(cpu_model);
+    if (tb_cache_dir) {
+        tb_cache_open(tb_cache_dir, execfd, cpu_model);
+    }
 
     /* init tcg before creating CPUs and to get qemu_host_page_size */
     {
         AccelClass *ac = ACCEL_GET_CLASS(current_accel());
 
+        object_property_set_bool(OBJECT(current_accel()), "chain-liveness",
+                                 chain_liveness, &error_abort);
+        object_property_set_bool(OBJECT(current_accel()), "return-stack",
+                                 return_stack, &error_abort);
+        object_property_set_bool(OBJECT(current_accel()), "tb-evict",
+                                 tb_evict, &error_abort);
+        object_property_set_uint(OBJECT(current_accel()), "tier-threshold",
+                                 tier_threshold, &error_abort);
         accel_init_interfaces(ac);
         ac->init_machine(NULL);
     }
@@ -869,6 +953,8 @@ int main(int argc, char **argv, char **envp)
        generating the prologue until now so that the prologue can take
        the real value of GUEST_BASE into account.  */
     tcg_prologue_init(tcg_ctx);
+    tb_cache_load();
+    translate_pool_init(translate_threads);
 
     target_cpu_copy_regs(env, regs);
 
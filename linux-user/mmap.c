@@ -33,6 +33,16 @@ void mmap_lock(void)
     }
 }
 
+/* Like mmap_lock, but fail instead of waiting for another thread */
+bool mmap_trylock(void)
+{
+    if (mmap_lock_count == 0 && pthread_mutex_trylock(&mmap_mutex) != 0) {
+        return false;
+    }
+    mmap_lock_count++;
+    return true;
+}
+
 void mmap_unlock(void)
 {
     if (--mmap_lock_count == 0) {
@@ -633,6 +643,8 @@ abi_long target_mmap(abi_ulong start, abi_ulong len, int target_prot,
         log_page_dump(__func__);
     }
     tb_invalidate_phys_range(start, start + len);
+    tb_cache_map(start, len, target_prot,
+                 flags & MAP_ANONYMOUS ? -1 : fd, offset);
     mmap_unlock();
     return start;
 fail:
@@ -737,6 +749,7 @@ int target_munmap(abi_ulong start, abi_ulong len)
     if (ret == 0) {
         page_set_flags(start, start + len, 0);
         tb_invalidate_phys_range(start, start + len);
+        tb_cache_unmap(start, len);
     }
     mmap_unlock();
     return ret;
@@ -822,6 +835,8 @@ abi_long target_mremap(abi_ulong old_addr, abi_ulong old_size,
     } else {
         new_addr = h2g(host_addr);
         prot = page_get_flags(old_addr);
+        tb_cache_unmap(old_addr, old_size);
+        tb_cache_unmap(new_addr, new_size);
         page_set_flags(old_addr, old_addr + old_size, 0);
         page_set_flags(new_addr, new_addr + new_size,
                        prot | PAGE_VALID | PAGE_RESET);
@@ -29,6 +29,11 @@
 #include "tcg/tcg-op.h"
 #include "plugin.h"
 #include "qemu/compiler.h"
+#include "qemu/thread.h"
+
+#ifdef CONFIG_ZSTD
+#include <zstd.h>
+#endif
 
 struct qemu_plugin_cb {
     struct qemu_plugin_ctx *ctx;
@@ -210,11 +215,98 @@ plugin_register_cb_udata(qemu_plugin_id_t id, enum qemu_plugin_event ev,
     do_plugin_register_cb(id, ev, func, udata);
 }
 
+static void plugin_scoreboard_resize(struct qemu_plugin_scoreboard *score,
+                                     size_t old_size, size_t new_size)
+{
+    void *data = qemu_memalign(qemu_dcache_linesize, new_size * score->stride);
+
+    memset(data, 0, new_size * score->stride);
+    if (score->data) {
+        memcpy(data, score->data, old_size * score->stride);
+        qemu_vfree(score->data);
+    }
+    score->data = data;
+}
+
+struct qemu_plugin_scoreboard *plugin_scoreboard_new(size_t element_size)
+{
+    struct qemu_plugin_scoreboard *score = g_new0(struct qemu_plugin_scoreboard,
+                                                  1);
+
+    score->element_size = element_size;
+    /* keep each vCPU's entry on cache lines of its own */
+    score->stride = ROUND_UP(element_size, qemu_dcache_linesize);
+
+    QEMU_LOCK_GUARD(&plugin.lock);
+    plugin_scoreboard_resize(score, 0, plugin.scoreboard_alloc_size);
+    QLIST_INSERT_HEAD(&plugin.scoreboards, score, entry);
+    return score;
+}
+
+void plugin_scoreboard_free(struct qemu_plugin_scoreboard *score)
+{
+    qemu_rec_mutex_lock(&plugin.lock);
+    QLIST_REMOVE(score, entry);
+    qemu_rec_mutex_unlock(&plugin.lock);
+
+    qemu_vfree(score->data);
+    g_free(score);
+}
+
+/*
+ * Make room for @cpu in every scoreboard. Translated code embeds the
+ * address of the scoreboards it updates, so moving them requires all
+ * vCPUs to be stopped and the code cache to be flushed before they run
+ * again. In system mode the scoreboards are sized for max_cpus up front
+ * and this never happens.
+ */
+static void plugin_grow_scoreboards__locked(CPUState *cpu)
+{
+    size_t old_size = plugin.scoreboard_alloc_size;
+    size_t new_size = old_size;
+    struct qemu_plugin_scoreboard *score;
+
+    while (cpu->cpu_index >= new_size) {
+        new_size *= 2;
+    }
+    if (new_size == old_size) {
+        return;
+    }
+    if (QLIST_EMPTY(&plugin.scoreboards)) {
+        plugin.scoreboard_alloc_size = new_size;
+        return;
+    }
+
+    /* a running vCPU might be waiting on the lock; don't hold it */
+    qemu_rec_mutex_unlock(&plugin.lock);
+    if (current_cpu) {
+        start_exclusive();
+    }
+    qemu_rec_mutex_lock(&plugin.lock);
+
+    /* another vCPU might have grown the scoreboards in the meantime */
+    old_size = plugin.scoreboard_alloc_size;
+    if (new_size > old_size) {
+        QLIST_FOREACH(score, &plugin.scoreboards, entry) {
+            plugin_scoreboard_resize(score, old_size, new_size);
+        }
+        plugin.scoreboard_alloc_size = new_size;
+        if (current_cpu) {
+            tb_flush(current_cpu);
+        }
+    }
+
+    if (current_cpu) {
+        end_exclusive();
+    }
+}
+
 void qemu_plugin_vcpu_init_hook(CPUState *cpu)
 {
     bool success;
 
     qemu_rec_mutex_lock(&plugin.lock);
+    plugin_grow_scoreboards__locked(cpu);
     plugin_cpu_update__locked(&cpu->cpu_index, NULL, NULL);
     success = g_hash_table_insert(plugin.cpu_ht, &cpu->cpu_index,
                                   &cpu->cpu_index);
@@ -292,6 +384,25 @@ void plugin_register_inline_op(GArray **arr,
     dyn_cb->rw = rw;
     dyn_cb->inline_insn.op = op;
     dyn_cb->inline_insn.imm = imm;
+    dyn_cb->inline_insn.stride = 0;
+}
+
+void plugin_register_inline_op_per_vcpu(GArray **arr,
+                                        enum qemu_plugin_mem_rw rw,
+                                        enum qemu_plugin_op op,
+                                        qemu_plugin_u64 entry,
+                                        uint64_t imm)
+{
+    struct qemu_plugin_scoreboard *score = entry.score;
+    struct qemu_plugin_dyn_cb *dyn_cb;
+
+    dyn_cb = plugin_get_dyn_cb(arr);
+    dyn_cb->userp = (char *)score->data + entry.offset;
+    dyn_cb->type = PLUGIN_CB_INLINE;
+    dyn_cb->rw = rw;
+    dyn_cb->inline_insn.op = op;
+    dyn_cb->inline_insn.imm = imm;
+    dyn_cb->inline_insn.stride = score->stride;
 }
 
 void plugin_register_dyn_cb__udata(GArray **arr,
@@ -302,11 +413,47 @@ void plugin_register_dyn_cb__udata(GArray **arr,
     struct qemu_plugin_dyn_cb *dyn_cb = plugin_get_dyn_cb(arr);
 
     dyn_cb->userp = udata;
-    /* Note flags are discarded as unused. */
+    dyn_cb->flags = flags;
     dyn_cb->f.vcpu_udata = cb;
     dyn_cb->type = PLUGIN_CB_REGULAR;
 }
 
+void plugin_register_dyn_cond_cb__udata(GArray **arr,
+                                        qemu_plugin_vcpu_udata_cb_t cb,
+                                        enum qemu_plugin_cb_flags flags,
+                                        enum qemu_plugin_cond cond,
+                                        qemu_plugin_u64 entry,
+                                        uint64_t imm,
+                                        void *udata)
+{
+    struct qemu_plugin_scoreboard *score = entry.score;
+    struct qemu_plugin_dyn_cb *dyn_cb = plugin_get_dyn_cb(arr);
+
+    dyn_cb->userp = udata;
+    dyn_cb->flags = flags;
+    dyn_cb->f.vcpu_udata = cb;
+    dyn_cb->type = PLUGIN_CB_COND;
+    dyn_cb->cond.ptr = (char *)score->data + entry.offset;
+    dyn_cb->cond.stride = score->stride;
+    dyn_cb->cond.cond = cond;
+    dyn_cb->cond.imm = imm;
+
+    /*
+     * Translation only emits the template of conditional callbacks once
+     * there is one, so the blocks translated before, including the one
+     * being translated now, must be translated again.
+     */
+    if (!qatomic_read(&plugin.have_cond_cbs)) {
+        qatomic_set(&plugin.have_cond_cbs, true);
+        tb_flush(current_cpu);
+    }
+}
+
+bool qemu_plugin_have_cond_cbs(void)
+{
+    return qatomic_read(&plugin.have_cond_cbs);
+}
+
 void plugin_register_vcpu_mem_cb(GArray **arr,
                                  void *cb,
                                  enum qemu_plugin_cb_flags flags,
@@ -432,9 +579,10 @@ void qemu_plugin_flush_cb(void)
     plugin_cb__simple(QEMU_PLUGIN_EV_FLUSH);
 }
 
-void exec_inline_op(struct qemu_plugin_dyn_cb *cb)
+void exec_inline_op(struct qemu_plugin_dyn_cb *cb, unsigned int cpu_index)
 {
-    uint64_t *val = cb->userp;
+    char *ptr = cb->userp;
+    uint64_t *val = (uint64_t *)(ptr + cpu_index * cb->inline_insn.stride);
 
     switch (cb->inline_insn.op) {
     case QEMU_PLUGIN_INLINE_ADD_U64:
@@ -467,7 +615,7 @@ void qemu_plugin_vcpu_mem_cb(CPUState *cpu, uint64_t vaddr,
                            vaddr, cb->userp);
             break;
         case PLUGIN_CB_INLINE:
-            exec_inline_op(cb);
+            exec_inline_op(cb, cpu->cpu_index);
             break;
         default:
             g_assert_not_reached();
@@ -536,6 +684,326 @@ void qemu_plugin_disable_mem_helpers(CPUState *cpu)
     cpu->plugin_mem_cbs = NULL;
 }
 
+/*
+ * Trace writer service
+ *
+ * Each stream (usually a vCPU) owns a single-producer ring buffer. Its
+ * producer appends whole records and publishes them by moving head; the
+ * writer thread copies everything between tail and head to the file as
+ * one chunk and then releases the space by moving tail. Producers only
+ * ever wait for the writer when their ring is full.
+ */
+
+#define PLUGIN_TRACE_RING_SIZE (1 << 20)
+#define PLUGIN_TRACE_POLL_MS 10
+
+typedef struct PluginTraceRing {
+    /* free running, so that head - tail is the amount of data queued */
+    size_t head QEMU_ALIGNED(64); /* written by the producer */
+    size_t tail QEMU_ALIGNED(64); /* written by the writer thread */
+    uint8_t *buf;
+} PluginTraceRing;
+
+typedef struct PluginTraceRings {
+    size_t n;
+    PluginTraceRing *ring[];
+} PluginTraceRings;
+
+struct qemu_plugin_trace {
+    FILE *file;
+    QemuThread thread;
+    /* @lock protects @closing, @waiters and updates of @rings */
+    QemuMutex lock;
+    /* signalled when there is data to write, and when there is room */
+    QemuCond cond;
+    QemuCond space_cond;
+    unsigned int waiters;
+    bool closing;
+    bool failed;
+    PluginTraceRings *rings;
+    /*
+     * Arrays replaced by a bigger one. Producers may still be looking at
+     * them, so they are only freed on close.
+     */
+    GSList *old_rings;
+#ifdef CONFIG_ZSTD
+    ZSTD_CCtx *zcctx;
+    void *zbuf;
+    size_t zbuf_size;
+#endif
+};
+
+static void plugin_trace_output(struct qemu_plugin_trace *t,
+                                const void *data, size_t len)
+{
+    if (t->failed || !len) {
+        return;
+    }
+#ifdef CONFIG_ZSTD
+    if (t->zcctx) {
+        ZSTD_inBuffer in = { data, len, 0 };
+
+        while (in.pos < in.size) {
+            ZSTD_outBuffer out = { t->zbuf, t->zbuf_size, 0 };
+            size_t ret = ZSTD_compressStream2(t->zcctx, &out, &in,
+                                              ZSTD_e_continue);
+
+            if (ZSTD_isError(ret)) {
+                error_report("plugin trace: compression failed: %s",
+                             ZSTD_getErrorName(ret));
+                t->failed = true;
+                return;
+            }
+            if (fwrite(t->zbuf, 1, out.pos, t->file) != out.pos) {
+                goto fail;
+            }
+        }
+        return;
+    }
+#endif
+    if (fwrite(data, 1, len, t->file) == len) {
+        return;
+    }
+#ifdef CONFIG_ZSTD
+fail:
+#endif
+    error_report("plugin trace: write failed: %s", strerror(errno));
+    t->failed = true;
+}
+
+/* Copy the published part of every ring to the file. */
+static bool plugin_trace_drain(struct qemu_plugin_trace *t)
+{
+    PluginTraceRings *rings;
+    bool found = false;
+    size_t i;
+
+    rings = qatomic_rcu_read(&t->rings);
+    for (i = 0; rings && i < rings->n; i++) {
+        PluginTraceRing *ring = rings->ring[i];
+        qemu_plugin_trace_chunk chunk;
+        size_t head, tail;
+        size_t off, len;
+
+        if (!ring) {
+            continue;
+        }
+        head = qatomic_load_acquire(&ring->head);
+        tail = ring->tail;
+        if (head == tail) {
+            continue;
+        }
+
+        chunk.stream = i;
+        chunk.len = head - tail;
+        plugin_trace_output(t, &chunk, sizeof(chunk));
+
+        off = tail & (PLUGIN_TRACE_RING_SIZE - 1);
+        len = MIN(chunk.len, PLUGIN_TRACE_RING_SIZE - off);
+        plugin_trace_output(t, ring->buf + off, len);
+        plugin_trace_output(t, ring->buf, chunk.len - len);
+
+        qatomic_store_release(&ring->tail, head);
+        found = true;
+    }
+
+    return found;
+}
+
+static void *plugin_trace_writer(void *opaque)
+{
+    struct qemu_plugin_trace *t = opaque;
+
+    qemu_mutex_lock(&t->lock);
+    while (!t->closing) {
+        qemu_mutex_unlock(&t->lock);
+        if (!plugin_trace_drain(t)) {
+            qemu_mutex_lock(&t->lock);
+            if (!t->closing) {
+                qemu_cond_timedwait(&t->cond, &t->lock,
+                                    PLUGIN_TRACE_POLL_MS);
+            }
+        } else {
+            qemu_mutex_lock(&t->lock);
+            if (t->waiters) {
+                qemu_cond_broadcast(&t->space_cond);
+            }
+        }
+    }
+    qemu_mutex_unlock(&t->lock);
+
+    /* producers are done by now, write out whatever they left */
+    plugin_trace_drain(t);
+    return NULL;
+}
+
+struct qemu_plugin_trace *plugin_trace_open(const char *path, bool compress)
+{
+    struct qemu_plugin_trace *t;
+    qemu_plugin_trace_header header = {
+        .magic = QEMU_PLUGIN_TRACE_MAGIC,
+        .version = QEMU_PLUGIN_TRACE_VERSION,
+    };
+
+#ifndef CONFIG_ZSTD
+    if (compress) {
+        error_report("plugin trace: %s: built without zstd support", path);
+        return NULL;
+    }
+#endif
+
+    t = g_new0(struct qemu_plugin_trace, 1);
+    t->file = fopen(path, "wb");
+    if (!t->file) {
+        error_report("plugin trace: cannot open %s: %s", path,
+                     strerror(errno));
+        g_free(t);
+        return NULL;
+    }
+
+#ifdef CONFIG_ZSTD
+    if (compress) {
+        t->zcctx = ZSTD_createCCtx();
+        ZSTD_CCtx_setParameter(t->zcctx, ZSTD_c_compressionLevel, 1);
+        t->zbuf_size = ZSTD_CStreamOutSize();
+        t->zbuf = g_malloc(t->zbuf_size);
+        header.flags |= QEMU_PLUGIN_TRACE_ZSTD;
+    }
+#endif
+
+    /* the header is never compressed, so readers can find out how to */
+    if (fwrite(&header, sizeof(header), 1, t->file) != 1) {
+        error_report("plugin trace: write failed: %s", strerror(errno));
+        t->failed = true;
+    }
+
+    qemu_mutex_init(&t->lock);
+    qemu_cond_init(&t->cond);
+    qemu_cond_init(&t->space_cond);
+    qemu_thread_create(&t->thread, "plugin-trace", plugin_trace_writer, t,
+                       QEMU_THREAD_JOINABLE);
+    return t;
+}
+
+static PluginTraceRing *plugin_trace_add_ring(struct qemu_plugin_trace *t,
+                                              unsigned int stream)
+{
+    PluginTraceRings *old, *new;
+    PluginTraceRing *ring;
+    size_t n;
+
+    QEMU_LOCK_GUARD(&t->lock);
+
+    old = t->rings;
+    if (old && stream < old->n && old->ring[stream]) {
+        return old->ring[stream];
+    }
+
+    ring = qemu_memalign(64, sizeof(*ring));
+    memset(ring, 0, sizeof(*ring));
+    ring->buf = g_malloc(PLUGIN_TRACE_RING_SIZE);
+
+    n = MAX(old ? old->n : 0, stream + 1);
+    new = g_malloc0(sizeof(*new) + n * sizeof(new->ring[0]));
+    new->n = n;
+    if (old) {
+        memcpy(new->ring, old->ring, old->n * sizeof(old->ring[0]));
+        t->old_rings = g_slist_prepend(t->old_rings, old);
+    }
+    new->ring[stream] = ring;
+    qatomic_rcu_set(&t->rings, new);
+
+    return ring;
+}
+
+bool plugin_trace_write(struct qemu_plugin_trace *t, unsigned int stream,
+                        const void *data, size_t len)
+{
+    PluginTraceRings *rings;
+    PluginTraceRing *ring = NULL;
+    size_t head, off, part;
+
+    if (len > PLUGIN_TRACE_RING_SIZE / 2) {
+        return false;
+    }
+
+    rings = qatomic_rcu_read(&t->rings);
+    if (rings && stream < rings->n) {
+        ring = rings->ring[stream];
+    }
+    if (unlikely(!ring)) {
+        ring = plugin_trace_add_ring(t, stream);
+    }
+
+    head = ring->head;
+    if (unlikely(head + len - qatomic_load_acquire(&ring->tail) >
+                 PLUGIN_TRACE_RING_SIZE)) {
+        /* full: wake up the writer and sleep until it made room */
+        qemu_mutex_lock(&t->lock);
+        t->waiters++;
+        while (head + len - qatomic_load_acquire(&ring->tail) >
+               PLUGIN_TRACE_RING_SIZE) {
+            qemu_cond_signal(&t->cond);
+            qemu_cond_wait(&t->space_cond, &t->lock);
+        }
+        t->waiters--;
+        qemu_mutex_unlock(&t->lock);
+    }
+
+    off = head & (PLUGIN_TRACE_RING_SIZE - 1);
+    part = MIN(len, PLUGIN_TRACE_RING_SIZE - off);
+    memcpy(ring->buf + off, data, part);
+    memcpy(ring->buf, (const uint8_t *)data + part, len - part);
+    qatomic_store_release(&ring->head, head + len);
+
+    return true;
+}
+
+void plugin_trace_close(struct qemu_plugin_trace *t)
+{
+    PluginTraceRings *rings;
+    size_t i;
+
+    qemu_mutex_lock(&t->lock);
+    t->closing = true;
+    qemu_cond_signal(&t->cond);
+    qemu_mutex_unlock(&t->lock);
+    qemu_thread_join(&t->thread);
+
+#ifdef CONFIG_ZSTD
+    if (t->zcctx) {
+        ZSTD_inBuffer in = { NULL, 0, 0 };
+        size_t ret;
+
+        do {
+            ZSTD_outBuffer out = { t->zbuf, t->zbuf_size, 0 };
+
+            ret = ZSTD_compressStream2(t->zcctx, &out, &in, ZSTD_e_end);
+            if (!t->failed && !ZSTD_isError(ret)) {
+                fwrite(t->zbuf, 1, out.pos, t->file);
+            }
+        } while (ret && !ZSTD_isError(ret));
+        ZSTD_freeCCtx(t->zcctx);
+        g_free(t->zbuf);
+    }
+#endif
+    fclose(t->file);
+
+    rings = t->rings;
+    for (i = 0; rings && i < rings->n; i++) {
+        if (rings->ring[i]) {
+            g_free(rings->ring[i]->buf);
+            qemu_vfree(rings->ring[i]);
+        }
+    }
+    g_free(rings);
+    g_slist_free_full(t->old_rings, g_free);
+    qemu_cond_destroy(&t->cond);
+    qemu_cond_destroy(&t->space_cond);
+    qemu_mutex_destroy(&t->lock);
+    g_free(t);
+}
+
 static bool plugin_dyn_cb_arr_cmp(const void *ap, const void *bp)
 {
     return ap == bp;
@@ -552,6 +1020,8 @@ static void __attribute__((__constructor__)) plugin_init(void)
     plugin.id_ht = g_hash_table_new(g_int64_hash, g_int64_equal);
     plugin.cpu_ht = g_hash_table_new(g_int_hash, g_int_equal);
     QTAILQ_INIT(&plugin.ctxs);
+    QLIST_INIT(&plugin.scoreboards);
+    plugin.scoreboard_alloc_size = 16; /* grows as vCPUs are created */
     qht_init(&plugin.dyn_cb_arr_ht, plugin_dyn_cb_arr_cmp, 16,
              QHT_MODE_AUTO_RESIZE);
     atexit(qemu_plugin_atexit_cb);
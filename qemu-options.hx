@@ -149,8 +149,12 @@ DEF("accel", HAS_ARG, QEMU_OPTION_accel,
     "                igd-passthru=on|off (enable Xen integrated Intel graphics passthrough, default=off)\n"
     "                kernel-irqchip=on|off|split controls accelerated irqchip support (default=on)\n"
     "                kvm-shadow-mem=size of KVM shadow MMU in bytes\n"
+    "                chain-liveness=on|off (skip TCG register stores across chained blocks, default=off)\n"
+    "                return-stack=on|off (predict TCG guest returns, default=off)\n"
     "                split-wx=on|off (enable TCG split w^x mapping)\n"
+    "                tb-evict=on|off (evict the oldest TCG translations when full, default=off)\n"
     "                tb-size=n (TCG translation block cache size)\n"
+    "                tier-threshold=n (retranslate TCG blocks run n times, default=0)\n"
     "                dirty-ring-size=n (KVM dirty ring GFN count, default 0)\n"
     "                thread=single|multi (enable multi-threaded TCG)\n", QEMU_ARCH_ALL)
 SRST
@@ -176,15 +180,45 @@ SRST
     ``kvm-shadow-mem=size``
         Defines the size of the KVM shadow MMU.
 
+    ``chain-liveness=on|off``
+        Lets the direct jumps between TCG translation blocks skip
+        storing the guest registers that the block jumped to overwrites
+        before reading them; the stores are only done when the jump is
+        not linked. Only used on x86 hosts, and not with icount.
+        (default=off)
+
+    ``return-stack=on|off``
+        Keeps a shadow stack of the return addresses of guest calls for
+        each vCPU, so that TCG can jump straight to the code of a
+        correctly predicted return instead of looking it up. Only used
+        by targets that mark their calls and returns (currently RISC-V).
+        (default=off)
+
     ``split-wx=on|off``
         Controls the use of split w^x mapping for the TCG code generation
         buffer. Some operating systems require this to be enabled, and in
         such a case this will default on. On other operating systems, this
         will default off, but one may enable this for testing or debugging.
 
+    ``tb-evict=on|off``
+        When the TCG translation block cache is full, only evict the
+        regions of it that were filled first, instead of flushing every
+        translation block. Code that is still being run then does not
+        all have to be translated again at once. The retranslations
+        either way are counted by the ``info jit`` monitor command.
+        (default=off)
+
     ``tb-size=n``
         Controls the size (in MiB) of the TCG translation block cache.
 
+    ``tier-threshold=n``
+        Counts the executions of each TCG translation block, and once a
+        block has run n times translates it again as a superblock, which
+        goes on along the unconditional jumps and the fall-through path
+        of the conditional branches it meets. Only targets that form
+        superblocks (currently RISC-V) support it, others ignore it with
+        a warning. 0 disables the counting. (default=0)
+
     ``thread=single|multi``
         Controls number of TCG threads. When the TCG is multi-threaded
         there will be one thread per vCPU therefore taking advantage of
@@ -1204,8 +1238,15 @@ SRST
             The path to the image file in the local filesystem
 
         ``aio``
-            Specifies the AIO backend (threads/native/io_uring,
-            default: threads)
+            Specifies the AIO backend (threads/native/io_uring/io_uring-poll,
+            default: threads). ``io_uring-poll`` polls the device for
+            completions instead of waiting for interrupts; it requires
+            ``cache.direct=on`` and a device with poll queues, such as
+            NVMe with the ``poll_queues`` module parameter set. Only nodes
+            in an IOThread poll, in the main loop it works like
+            ``io_uring``. The IOThread busy-waits for completions for up
+            to its ``poll-max-ns``, and reaps them every 10 microseconds
+            after that.
 
         ``locking``
             Specifies whether the image file is protected with Linux OFD
@@ -1328,7 +1369,7 @@ DEF("drive", HAS_ARG, QEMU_OPTION_drive,
     "       [,cache=writethrough|writeback|none|directsync|unsafe][,format=f]\n"
     "       [,snapshot=on|off][,rerror=ignore|stop|report]\n"
     "       [,werror=ignore|stop|report|enospc][,id=name]\n"
-    "       [,aio=threads|native|io_uring]\n"
+    "       [,aio=threads|native|io_uring|io_uring-poll]\n"
     "       [,readonly=on|off][,copy-on-read=on|off]\n"
     "       [,discard=ignore|unmap][,detect-zeroes=on|off|unmap]\n"
     "       [[,bps=b]|[[,bps_rd=r][,bps_wr=w]]]\n"
@@ -1400,8 +1441,9 @@ SRST
         The default mode is ``cache=writeback``.
 
     ``aio=aio``
-        aio is "threads", "native", or "io_uring" and selects between pthread
-        based disk I/O, native Linux AIO, or Linux io_uring API.
+        aio is "threads", "native", "io_uring" or "io_uring-poll" and
+        selects between pthread based disk I/O, native Linux AIO, Linux
+        io_uring API, or Linux io_uring API polling for completions.
 
     ``format=format``
         Specify which disk format will be used rather than detecting the
@@ -5403,7 +5445,7 @@ SRST
 
             CN=laptop.example.com,O=Example Home,L=London,ST=London,C=GB
 
-    ``-object iothread,id=id,poll-max-ns=poll-max-ns,poll-grow=poll-grow,poll-shrink=poll-shrink,aio-max-batch=aio-max-batch``
+    ``-object iothread,id=id,poll-max-ns=poll-max-ns,poll-grow=poll-grow,poll-shrink=poll-shrink,aio-max-batch=aio-max-batch,io-uring-sqpoll=on|off,io-uring-fixed-files=on|off,io-uring-fixed-buffers=on|off``
         Creates a dedicated event loop thread that devices can be
         assigned to. This is known as an IOThread. By default device
         emulation happens in vCPU threads or the main event loop thread.
@@ -5443,6 +5485,18 @@ SRST
         in a batch for the AIO engine, 0 means that the engine will use
         its default.
 
+        The ``io-uring-sqpoll``, ``io-uring-fixed-files`` and
+        ``io-uring-fixed-buffers`` parameters tune the io_uring ring used
+        by ``aio=io_uring`` block nodes in the IOThread. They take effect
+        when the first such node is opened. ``io-uring-sqpoll`` lets a
+        kernel thread poll for new requests, so that submitting them
+        needs no system call; it implies ``io-uring-fixed-files``.
+        ``io-uring-fixed-files`` registers the image files with the ring.
+        ``io-uring-fixed-buffers`` registers guest RAM that is backed by
+        memfd or hugepages, for example ``memory-backend-memfd``, so that
+        requests on it need not pin the guest pages each time. The memory
+        is locked, which is limited by ``RLIMIT_MEMLOCK``.
+
         The IOThread parameters can be modified at run-time using the
         ``qom-set`` command (where ``iothread1`` is the IOThread's
         ``id``):
@@ -18,6 +18,22 @@ ram_addr_t qemu_ram_get_used_length(RAMBlock *rb)
     return 0;
 }
 
+RAMBlock *qemu_ram_block_from_host(void *ptr, bool round_offset,
+                                   ram_addr_t *offset)
+{
+    return NULL;
+}
+
+bool qemu_ram_is_shared(RAMBlock *rb)
+{
+    return false;
+}
+
+size_t qemu_ram_pagesize(RAMBlock *rb)
+{
+    return 0;
+}
+
 void ram_block_notifier_add(RAMBlockNotifier *n)
 {
 }
@@ -62,6 +62,22 @@ typedef hwaddr (*MMUTranslateFunc)(CPUState *cs, hwaddr gphys, MMUAccessType acc
 #define GET_HPHYS(cs, gpa, access_type, prot)  \
 	(get_hphys_func ? get_hphys_func(cs, gpa, access_type, prot) : gpa)
 
+/*
+ * Load the paging-structure entry at @addr, from the page walk cache if
+ * @pwc and it is there.  Only present non-leaf entries are cached; the
+ * guest has to invalidate them with invlpg, invpcid or a CR3 write after
+ * changing them, all of which flush the TLB and empty the cache.
+ */
+static uint64_t mmu_walk_ld(CPUState *cs, hwaddr addr, bool pwc, bool wide)
+{
+    uint64_t pte;
+
+    if (pwc && tlb_walk_cache_lookup(cs, addr, &pte)) {
+        return pte;
+    }
+    return wide ? x86_ldq_phys(cs, addr) : x86_ldl_phys(cs, addr);
+}
+
 static int mmu_translate(CPUState *cs, hwaddr addr, MMUTranslateFunc get_hphys_func,
                          uint64_t cr3, int is_write1, int mmu_idx, int pg_mode,
                          hwaddr *xlat, int *page_size, int *prot)
@@ -76,6 +92,12 @@ static int mmu_translate(CPUState *cs, hwaddr addr, MMUTranslateFunc get_hphys_f
     uint64_t rsvd_mask = PG_ADDRESS_MASK & ~MAKE_64BIT_MASK(0, cpu->phys_bits);
     uint32_t page_offset;
     uint32_t pkr;
+    /*
+     * Without nested paging the walk cache is keyed by guest physical
+     * addresses.  With it, the nested tables may change on VMRUN without
+     * a flush, so leave both walks uncached.
+     */
+    bool pwc = !(env->hflags2 & HF2_NPT_MASK);
 
     is_user = (mmu_idx == MMU_USER_IDX);
     is_write = is_write1 & 1;
@@ -99,7 +121,7 @@ static int mmu_translate(CPUState *cs, hwaddr addr, MMUTranslateFunc get_hphys_f
                 pml5e_addr = ((cr3 & ~0xfff) +
                         (((addr >> 48) & 0x1ff) << 3)) & a20_mask;
                 pml5e_addr = GET_HPHYS(cs, pml5e_addr, MMU_DATA_STORE, NULL);
-                pml5e = x86_ldq_phys(cs, pml5e_addr);
+                pml5e = mmu_walk_ld(cs, pml5e_addr, pwc, true);
                 if (!(pml5e & PG_PRESENT_MASK)) {
                     goto do_fault;
                 }
@@ -110,6 +132,9 @@ static int mmu_translate(CPUState *cs, hwaddr addr, MMUTranslateFunc get_hphys_f
                     pml5e |= PG_ACCESSED_MASK;
                     x86_stl_phys_notdirty(cs, pml5e_addr, pml5e);
                 }
+                if (pwc) {
+                    tlb_walk_cache_insert(cs, pml5e_addr, pml5e);
+                }
                 ptep = pml5e ^ PG_NX_MASK;
             } else {
                 pml5e = cr3;
@@ -119,7 +144,7 @@ static int mmu_translate(CPUState *cs, hwaddr addr, MMUTranslateFunc get_hphys_f
             pml4e_addr = ((pml5e & PG_ADDRESS_MASK) +
                     (((addr >> 39) & 0x1ff) << 3)) & a20_mask;
             pml4e_addr = GET_HPHYS(cs, pml4e_addr, MMU_DATA_STORE, NULL);
-            pml4e = x86_ldq_phys(cs, pml4e_addr);
+            pml4e = mmu_walk_ld(cs, pml4e_addr, pwc, true);
             if (!(pml4e & PG_PRESENT_MASK)) {
                 goto do_fault;
             }
@@ -130,11 +155,14 @@ static int mmu_translate(CPUState *cs, hwaddr addr, MMUTranslateFunc get_hphys_f
                 pml4e |= PG_ACCESSED_MASK;
                 x86_stl_phys_notdirty(cs, pml4e_addr, pml4e);
             }
+            if (pwc) {
+                tlb_walk_cache_insert(cs, pml4e_addr, pml4e);
+            }
             ptep &= pml4e ^ PG_NX_MASK;
             pdpe_addr = ((pml4e & PG_ADDRESS_MASK) + (((addr >> 30) & 0x1ff) << 3)) &
                 a20_mask;
             pdpe_addr = GET_HPHYS(cs, pdpe_addr, MMU_DATA_STORE, NULL);
-            pdpe = x86_ldq_phys(cs, pdpe_addr);
+            pdpe = mmu_walk_ld(cs, pdpe_addr, pwc, true);
             if (!(pdpe & PG_PRESENT_MASK)) {
                 goto do_fault;
             }
@@ -153,6 +181,9 @@ static int mmu_translate(CPUState *cs, hwaddr addr, MMUTranslateFunc get_hphys_f
                 pte = pdpe;
                 goto do_check_protect;
             }
+            if (pwc) {
+                tlb_walk_cache_insert(cs, pdpe_addr, pdpe);
+            }
         } else
 #endif
         {
@@ -174,7 +205,7 @@ static int mmu_translate(CPUState *cs, hwaddr addr, MMUTranslateFunc get_hphys_f
         pde_addr = ((pdpe & PG_ADDRESS_MASK) + (((addr >> 21) & 0x1ff) << 3)) &
             a20_mask;
         pde_addr = GET_HPHYS(cs, pde_addr, MMU_DATA_STORE, NULL);
-        pde = x86_ldq_phys(cs, pde_addr);
+        pde = mmu_walk_ld(cs, pde_addr, pwc, true);
         if (!(pde & PG_PRESENT_MASK)) {
             goto do_fault;
         }
@@ -194,6 +225,9 @@ static int mmu_translate(CPUState *cs, hwaddr addr, MMUTranslateFunc get_hphys_f
             pde |= PG_ACCESSED_MASK;
             x86_stl_phys_notdirty(cs, pde_addr, pde);
         }
+        if (pwc) {
+            tlb_walk_cache_insert(cs, pde_addr, pde);
+        }
         pte_addr = ((pde & PG_ADDRESS_MASK) + (((addr >> 12) & 0x1ff) << 3)) &
             a20_mask;
         pte_addr = GET_HPHYS(cs, pte_addr, MMU_DATA_STORE, NULL);
@@ -214,7 +248,7 @@ static int mmu_translate(CPUState *cs, hwaddr addr, MMUTranslateFunc get_hphys_f
         pde_addr = ((cr3 & ~0xfff) + ((addr >> 20) & 0xffc)) &
             a20_mask;
         pde_addr = GET_HPHYS(cs, pde_addr, MMU_DATA_STORE, NULL);
-        pde = x86_ldl_phys(cs, pde_addr);
+        pde = mmu_walk_ld(cs, pde_addr, pwc, false);
         if (!(pde & PG_PRESENT_MASK)) {
             goto do_fault;
         }
@@ -237,6 +271,9 @@ static int mmu_translate(CPUState *cs, hwaddr addr, MMUTranslateFunc get_hphys_f
             pde |= PG_ACCESSED_MASK;
             x86_stl_phys_notdirty(cs, pde_addr, pde);
         }
+        if (pwc) {
+            tlb_walk_cache_insert(cs, pde_addr, pde);
+        }
 
         /* page directory entry */
         pte_addr = ((pde & ~0xfff) + ((addr >> 10) & 0xffc)) &
@@ -8509,14 +8509,15 @@ void tcg_x86_init(void)
     };
     int i;
 
-    cpu_cc_op = tcg_global_mem_new_i32(cpu_env,
-                                       offsetof(CPUX86State, cc_op), "cc_op");
-    cpu_cc_dst = tcg_global_mem_new(cpu_env, offsetof(CPUX86State, cc_dst),
-                                    "cc_dst");
-    cpu_cc_src = tcg_global_mem_new(cpu_env, offsetof(CPUX86State, cc_src),
-                                    "cc_src");
-    cpu_cc_src2 = tcg_global_mem_new(cpu_env, offsetof(CPUX86State, cc_src2),
-                                     "cc_src2");
+    cpu_cc_op = tcg_global_flag_new_i32(cpu_env,
+                                        offsetof(CPUX86State, cc_op), "cc_op");
+    cpu_cc_dst = tcg_global_flag_new(cpu_env, offsetof(CPUX86State, cc_dst),
+                                     "cc_dst");
+    cpu_cc_src = tcg_global_flag_new(cpu_env, offsetof(CPUX86State, cc_src),
+                                     "cc_src");
+    cpu_cc_src2 = tcg_global_flag_new(cpu_env,
+                                      offsetof(CPUX86State, cc_src2),
+                                      "cc_src2");
 
     for (i = 0; i < CPU_NB_REGS; ++i) {
         cpu_regs[i] = tcg_global_mem_new(cpu_env,
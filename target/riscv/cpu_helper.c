@@ -609,14 +609,22 @@ restart:
         }
 
         target_ulong pte;
-        if (riscv_cpu_mxl(env) == MXL_RV32) {
-            pte = address_space_ldl(cs->as, pte_addr, attrs, &res);
+        uint64_t cached_pte;
+        bool cached = !is_debug &&
+                      tlb_walk_cache_lookup(cs, pte_addr, &cached_pte);
+
+        if (cached) {
+            pte = cached_pte;
         } else {
-            pte = address_space_ldq(cs->as, pte_addr, attrs, &res);
-        }
+            if (riscv_cpu_mxl(env) == MXL_RV32) {
+                pte = address_space_ldl(cs->as, pte_addr, attrs, &res);
+            } else {
+                pte = address_space_ldq(cs->as, pte_addr, attrs, &res);
+            }
 
-        if (res != MEMTX_OK) {
-            return TRANSLATE_FAIL;
+            if (res != MEMTX_OK) {
+                return TRANSLATE_FAIL;
+            }
         }
 
         hwaddr ppn = pte >> PTE_PPN_SHIFT;
@@ -625,7 +633,13 @@ restart:
             /* Invalid PTE */
             return TRANSLATE_FAIL;
         } else if (!(pte & (PTE_R | PTE_W | PTE_X))) {
-            /* Inner PTE, continue walking */
+            /*
+             * Inner PTE, continue walking.  sfence.vma must follow any
+             * change to it, so keep it until the next TLB flush.
+             */
+            if (!cached && !is_debug) {
+                tlb_walk_cache_insert(cs, pte_addr, pte);
+            }
             base = ppn << PGSHIFT;
         } else if ((pte & (PTE_R | PTE_W | PTE_X)) == PTE_W) {
             /* Reserved leaf PTE flags: PTE_W */
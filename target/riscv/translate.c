@@ -355,6 +355,25 @@ static void gen_set_gpr128(DisasContext *ctx, int reg_num, TCGv rl, TCGv rh)
     }
 }
 
+/* x1 and x5 hold return addresses, for the return address stack hints */
+static bool is_link_reg(int reg)
+{
+    return reg == 1 || reg == 5;
+}
+
+/* Whether the TB flags still describe the CPU state */
+static bool tb_flags_unchanged(DisasContext *ctx)
+{
+    uint32_t tb_flags = ctx->base.tb->flags;
+
+    return ctx->mstatus_fs == (tb_flags & TB_FLAGS_MSTATUS_FS) &&
+           ctx->mstatus_vs == (tb_flags & TB_FLAGS_MSTATUS_VS) &&
+           ctx->mstatus_hs_fs == FIELD_EX32(tb_flags, TB_FLAGS,
+                                            MSTATUS_HS_FS) &&
+           ctx->mstatus_hs_vs == FIELD_EX32(tb_flags, TB_FLAGS,
+                                            MSTATUS_HS_VS);
+}
+
 static void gen_jal(DisasContext *ctx, int rd, target_ulong imm)
 {
     target_ulong next_pc;
@@ -370,8 +389,17 @@ static void gen_jal(DisasContext *ctx, int rd, target_ulong imm)
     if (rd != 0) {
         tcg_gen_movi_tl(cpu_gpr[rd], ctx->pc_succ_insn);
     }
+    if (is_link_reg(rd)) {
+        tcg_gen_ras_push(ctx->base.tb, ctx->pc_succ_insn);
+    }
+
+    /* superblocks go on at the target */
+    if (translator_follow_jump(&ctx->base, next_pc)) {
+        ctx->pc_succ_insn = next_pc;
+        return;
+    }
 
-    gen_goto_tb(ctx, 0, ctx->base.pc_next + imm); /* must use this for safety */
+    gen_goto_tb(ctx, 0, next_pc); /* must use this for safety */
     ctx->base.is_jmp = DISAS_NORETURN;
 }
 
@@ -29,6 +29,12 @@
 #include "tcg/tcg.h"
 #include "tcg-internal.h"
 
+/*
+ * With tcg_tb_evict, use at least TCG_EVICT_REGIONS regions, and have
+ * tcg_region_evict() empty at least 1/TCG_EVICT_SHARE of them at a time.
+ */
+#define TCG_EVICT_REGIONS 8
+#define TCG_EVICT_SHARE 4
 
 struct tcg_region_tree {
     QemuMutex lock;
@@ -56,6 +62,15 @@ struct tcg_region_state {
     /* fields protected by the lock */
     size_t current; /* current region index */
     size_t agg_size_full; /* aggregate size of full regions */
+    /*
+     * Once every region has been handed out, tcg_region_evict() empties
+     * the oldest ones so that they can be handed out again. @stamp orders
+     * the regions by allocation time, 0 meaning empty, and @size_full is
+     * what each full region contributes to agg_size_full.
+     */
+    uint64_t *stamp;
+    size_t *size_full;
+    uint64_t next_stamp;
 };
 
 static struct tcg_region_state region;
@@ -68,6 +83,8 @@ static struct tcg_region_state region;
 static void *region_trees;
 static size_t tree_size;
 
+void *tcg_code_gen_hint;
+
 bool in_code_gen_buffer(const void *p)
 {
     /*
@@ -163,10 +180,23 @@ static void tcg_region_trees_init(void)
     }
 }
 
-static struct tcg_region_tree *tc_ptr_to_region_tree(const void *p)
+/* Return the index of the region containing @p, in the rw buffer */
+static size_t tcg_region_index(const void *p)
 {
-    size_t region_idx;
+    ptrdiff_t offset;
 
+    if (p < region.start_aligned) {
+        return 0;
+    }
+    offset = p - region.start_aligned;
+    if (offset > region.stride * (region.n - 1)) {
+        return region.n - 1;
+    }
+    return offset / region.stride;
+}
+
+static struct tcg_region_tree *tc_ptr_to_region_tree(const void *p)
+{
     /*
      * Like tcg_splitwx_to_rw, with no assert.  The pc may come from
      * a signal handler over which the caller has no control.
@@ -177,19 +207,7 @@ static struct tcg_region_tree *tc_ptr_to_region_tree(const void *p)
             return NULL;
         }
     }
-
-    if (p < region.start_aligned) {
-        region_idx = 0;
-    } else {
-        ptrdiff_t offset = p - region.start_aligned;
-
-        if (offset > region.stride * (region.n - 1)) {
-            region_idx = region.n - 1;
-        } else {
-            region_idx = offset / region.stride;
-        }
-    }
-    return region_trees + region_idx * tree_size;
+    return region_trees + tcg_region_index(p) * tree_size;
 }
 
 void tcg_tb_insert(TranslationBlock *tb)
@@ -283,6 +301,13 @@ size_t tcg_nb_tbs(void)
     return nb_tbs;
 }
 
+static void tcg_region_tree_reset(struct tcg_region_tree *rt)
+{
+    /* Increment the refcount first so that destroy acts as a reset */
+    g_tree_ref(rt->tree);
+    g_tree_destroy(rt->tree);
+}
+
 static void tcg_region_tree_reset_all(void)
 {
     size_t i;
@@ -291,9 +316,7 @@ static void tcg_region_tree_reset_all(void)
     for (i = 0; i < region.n; i++) {
         struct tcg_region_tree *rt = region_trees + i * tree_size;
 
-        /* Increment the refcount first so that destroy acts as a reset */
-        g_tree_ref(rt->tree);
-        g_tree_destroy(rt->tree);
+        tcg_region_tree_reset(rt);
     }
     tcg_region_tree_unlock_all();
 }
@@ -331,11 +354,21 @@ static void tcg_region_assign(TCGContext *s, size_t curr_region)
 
 static bool tcg_region_alloc__locked(TCGContext *s)
 {
-    if (region.current == region.n) {
-        return true;
+    size_t i;
+
+    if (region.current < region.n) {
+        i = region.current++;
+    } else {
+        /* only regions emptied by tcg_region_evict() are left */
+        for (i = 0; i < region.n && region.stamp[i]; i++) {
+            continue;
+        }
+        if (i == region.n) {
+            return true;
+        }
     }
-    tcg_region_assign(s, region.current);
-    region.current++;
+    tcg_region_assign(s, i);
+    region.stamp[i] = ++region.next_stamp;
     return false;
 }
 
@@ -346,13 +379,15 @@ static bool tcg_region_alloc__locked(TCGContext *s)
 bool tcg_region_alloc(TCGContext *s)
 {
     bool err;
-    /* read the region size now; alloc__locked will overwrite it on success */
-    size_t size_full = s->code_gen_buffer_size;
+    /* read the region now; alloc__locked will overwrite it on success */
+    size_t size_full = s->code_gen_buffer_size - TCG_HIGHWATER;
+    size_t full = tcg_region_index(s->code_gen_buffer);
 
     qemu_mutex_lock(&region.lock);
     err = tcg_region_alloc__locked(s);
     if (!err) {
-        region.agg_size_full += size_full - TCG_HIGHWATER;
+        region.agg_size_full += size_full;
+        region.size_full[full] = size_full;
     }
     qemu_mutex_unlock(&region.lock);
     return err;
@@ -384,6 +419,8 @@ void tcg_region_reset_all(void)
     qemu_mutex_lock(&region.lock);
     region.current = 0;
     region.agg_size_full = 0;
+    memset(region.stamp, 0, region.n * sizeof(*region.stamp));
+    memset(region.size_full, 0, region.n * sizeof(*region.size_full));
 
     for (i = 0; i < n_ctxs; i++) {
         TCGContext *s = qatomic_read(&tcg_ctxs[i]);
@@ -394,12 +431,100 @@ void tcg_region_reset_all(void)
     tcg_region_tree_reset_all();
 }
 
+/* Return the context translating into region @i, if any */
+static TCGContext *tcg_region_owner(size_t i)
+{
+    unsigned int n_ctxs = qatomic_read(&tcg_cur_ctxs);
+    unsigned int j;
+
+    for (j = 0; j < n_ctxs; j++) {
+        TCGContext *s = qatomic_read(&tcg_ctxs[j]);
+
+        if (tcg_region_index(s->code_gen_buffer) == i) {
+            return s;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Evict the oldest regions: at least 1/TCG_EVICT_SHARE of them, and then
+ * more until one is left empty for the context that ran out of space.
+ * @func is called on every TB of an evicted region before the region's
+ * tree is emptied; it must unlink the TB from everything that could
+ * still reach its code. A context that was translating into an evicted
+ * region starts over at the beginning of that region.
+ * Returns the number of regions evicted.
+ *
+ * Call from a safe-work context.
+ */
+size_t tcg_region_evict(GTraverseFunc func, gpointer user_data)
+{
+    size_t min = MAX(region.n / TCG_EVICT_SHARE, 1);
+    g_autofree size_t *victims = g_new(size_t, region.n);
+    bool have_empty;
+    size_t n = 0;
+    size_t i;
+
+    qemu_mutex_lock(&region.lock);
+    have_empty = region.current < region.n;
+    while (n < region.n && (n < min || !have_empty)) {
+        size_t oldest = region.n;
+        TCGContext *s;
+
+        for (i = 0; i < region.n; i++) {
+            if (region.stamp[i] &&
+                (oldest == region.n ||
+                 region.stamp[i] < region.stamp[oldest])) {
+                oldest = i;
+            }
+        }
+        if (oldest == region.n) {
+            break;
+        }
+
+        s = tcg_region_owner(oldest);
+        if (s) {
+            tcg_region_assign(s, oldest);
+            region.stamp[oldest] = ++region.next_stamp;
+        } else {
+            region.agg_size_full -= region.size_full[oldest];
+            region.size_full[oldest] = 0;
+            region.stamp[oldest] = 0;
+            have_empty = true;
+        }
+        victims[n++] = oldest;
+    }
+    qemu_mutex_unlock(&region.lock);
+
+    for (i = 0; i < n; i++) {
+        struct tcg_region_tree *rt = region_trees + victims[i] * tree_size;
+
+        qemu_mutex_lock(&rt->lock);
+        g_tree_foreach(rt->tree, func, user_data);
+        tcg_region_tree_reset(rt);
+        qemu_mutex_unlock(&rt->lock);
+    }
+    return n;
+}
+
 static size_t tcg_n_regions(size_t tb_size, unsigned max_cpus)
 {
+    size_t n_regions;
+
+    /*
+     * Evicting a region at a time only pays off with a few of them.
+     * There is a single context in user-mode, so it does not matter
+     * how many regions it goes through.
+     */
+    if (tcg_tb_evict) {
+        n_regions = MAX(TCG_EVICT_REGIONS, max_cpus * 2);
+        return MIN(n_regions, tb_size / (2 * qemu_real_host_page_size));
+    }
+
 #ifdef CONFIG_USER_ONLY
     return 1;
 #else
-    size_t n_regions;
 
     /*
      * It is likely that some vCPUs will translate more code than others,
@@ -528,7 +653,7 @@ static int alloc_code_gen_buffer_anon(size_t size, int prot,
 {
     void *buf;
 
-    buf = mmap(NULL, size, prot, flags, -1, 0);
+    buf = mmap(tcg_code_gen_hint, size, prot, flags, -1, 0);
     if (buf == MAP_FAILED) {
         error_setg_errno(errp, errno,
                          "allocate %zu bytes for jit buffer", size);
@@ -711,10 +836,12 @@ static int alloc_code_gen_buffer(size_t size, int splitwx, Error **errp)
  * must have been parsed before calling this function, since it calls
  * qemu_tcg_mttcg_enabled().
  *
- * In user-mode we use a single region.  Having multiple regions in user-mode
- * is not supported, because the number of vCPU threads (recall that each thread
- * spawned by the guest corresponds to a vCPU thread) is only bounded by the
- * OS, and usually this number is huge (tens of thousands is not uncommon).
+ * In user-mode we use a single region, unless tcg_tb_evict asks for a few
+ * regions to evict, all of them used in turn by the single TCG context.
+ * Having a region per vCPU thread in user-mode is not supported, because
+ * the number of vCPU threads (recall that each thread spawned by the guest
+ * corresponds to a vCPU thread) is only bounded by the OS, and usually this
+ * number is huge (tens of thousands is not uncommon).
  * Thus, given this large bound on the number of vCPU threads and the fact
  * that code_gen_buffer is allocated at compile-time, we cannot guarantee
  * that the availability of at least one region per vCPU thread.
@@ -782,6 +909,8 @@ void tcg_region_init(size_t tb_size, int splitwx, unsigned max_cpus)
 
     /* init the region struct */
     qemu_mutex_init(&region.lock);
+    region.stamp = g_new0(uint64_t, region.n);
+    region.size_full = g_new0(size_t, region.n);
 
     /*
      * Set guard pages in the rw buffer, as that's the one into which
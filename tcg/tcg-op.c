@@ -2723,8 +2723,8 @@ void tcg_gen_exit_tb(const TranslationBlock *tb, unsigned idx)
         tcg_debug_assert(tcg_ctx->goto_tb_issue_mask & (1 << idx));
 #endif
     } else {
-        /* This is an exit via the exitreq label.  */
-        tcg_debug_assert(idx == TB_EXIT_REQUESTED);
+        /* This is an exit via the exitreq or tier label.  */
+        tcg_debug_assert(idx == TB_EXIT_REQUESTED || idx == TB_EXIT_HOT);
     }
 
     plugin_gen_disable_mem_helpers();
@@ -2742,6 +2742,8 @@ void tcg_gen_goto_tb(unsigned idx)
     tcg_debug_assert((tcg_ctx->goto_tb_issue_mask & (1 << idx)) == 0);
     tcg_ctx->goto_tb_issue_mask |= 1 << idx;
 #endif
+    /* The destination was the last one accepted by translator_use_goto_tb */
+    tcg_ctx->goto_tb_slot[idx] = tcg_ctx->nb_goto_tb_dest - 1;
     plugin_gen_disable_mem_helpers();
     tcg_gen_op1i(INDEX_op_goto_tb, idx);
 }
@@ -2762,6 +2764,222 @@ void tcg_gen_lookup_and_goto_ptr(void)
     tcg_temp_free_ptr(ptr);
 }
 
+/* Offset from cpu_env of a field of CPUState */
+#define CPU_STATE_OFS(field) \
+    (-offsetof(ArchCPU, env) + offsetof(CPUState, field))
+
+/*
+ * Hash the next branch site of @tb to @bits bits. Superblocks have
+ * several sites, so the index of the site in the TB is mixed in for
+ * them not to share one set.
+ */
+static unsigned int tb_site_hash(const TranslationBlock *tb,
+                                 unsigned int bits)
+{
+    unsigned int h = tb->pc >> 2 ^ tb->pc >> (bits + 2);
+
+    h += tcg_ctx->nb_branch_sites++ * 0x9e3779b1u >> (32 - bits);
+    return h & ((1u << bits) - 1);
+}
+
+/*
+ * Jump to @pc, a local temp, through the indirect branch target cache
+ * set of @tb, calling the lookup helper if no way matches.
+ */
+static void gen_ibtc_lookup(const TranslationBlock *tb, TCGv_i64 pc)
+{
+    unsigned int set = tb_site_hash(tb, TB_IBTC_BITS);
+    intptr_t ofs = CPU_STATE_OFS(tb_ibtc) + set * sizeof(TBIndirectCacheSet);
+    TCGv_ptr ptr, site;
+    int i;
+
+    for (i = 0; i < TB_IBTC_WAYS; i++) {
+        intptr_t e = ofs + offsetof(TBIndirectCacheSet, entry[i]);
+        TCGLabel *miss = gen_new_label();
+        TCGv_i64 tag;
+
+        ptr = tcg_temp_new_ptr();
+        tcg_gen_ld_ptr(ptr, cpu_env, e + offsetof(TBIndirectCacheEntry, site));
+        tcg_gen_brcondi_ptr(TCG_COND_NE, ptr, (intptr_t)tb, miss);
+        tcg_temp_free_ptr(ptr);
+
+        tag = tcg_temp_new_i64();
+        tcg_gen_ld_i64(tag, cpu_env, e + offsetof(TBIndirectCacheEntry, pc));
+        tcg_gen_brcond_i64(TCG_COND_NE, tag, pc, miss);
+        tcg_temp_free_i64(tag);
+
+        ptr = tcg_temp_new_ptr();
+        tcg_gen_ld_ptr(ptr, cpu_env,
+                       e + offsetof(TBIndirectCacheEntry, tc_ptr));
+        tcg_gen_op1i(INDEX_op_goto_ptr, tcgv_ptr_arg(ptr));
+        tcg_temp_free_ptr(ptr);
+
+        gen_set_label(miss);
+    }
+
+    ptr = tcg_temp_new_ptr();
+    site = tcg_const_ptr(tb);
+    gen_helper_lookup_tb_ptr_cached(ptr, cpu_env, site,
+                                    tcg_constant_i32(set));
+    tcg_gen_op1i(INDEX_op_goto_ptr, tcgv_ptr_arg(ptr));
+    tcg_temp_free_ptr(site);
+    tcg_temp_free_ptr(ptr);
+}
+
+void tcg_gen_lookup_and_goto_ptr_cached(const TranslationBlock *tb,
+                                        TCGv dest)
+{
+    TCGv_i64 pc;
+
+    if (tcg_ctx->tb_cflags & (CF_NO_GOTO_TB | CF_NO_GOTO_PTR)) {
+        tcg_gen_lookup_and_goto_ptr();
+        return;
+    }
+
+    plugin_gen_disable_mem_helpers();
+
+    /* dest has to survive the branches to each way */
+    pc = tcg_temp_local_new_i64();
+    tcg_gen_extu_tl_i64(pc, dest);
+    gen_ibtc_lookup(tb, pc);
+    tcg_temp_free_i64(pc);
+}
+
+void tcg_gen_ras_push(const TranslationBlock *tb, target_ulong ret_addr)
+{
+    unsigned int cell;
+    intptr_t ofs = CPU_STATE_OFS(tb_ras.entry);
+    intptr_t cofs;
+    TCGv_i32 top, flags;
+    TCGv_ptr e, ptr;
+
+    if (!tcg_return_stack ||
+        (tcg_ctx->tb_cflags & (CF_NO_GOTO_TB | CF_NO_GOTO_PTR))) {
+        return;
+    }
+
+    cell = tb_site_hash(tb, TB_RAS_CONT_BITS);
+    cofs = CPU_STATE_OFS(tb_ras.cont) + cell * sizeof(TBReturnCont);
+
+    top = tcg_temp_new_i32();
+    tcg_gen_ld_i32(top, cpu_env, CPU_STATE_OFS(tb_ras.top));
+    tcg_gen_addi_i32(top, top, 1);
+    tcg_gen_andi_i32(top, top, TB_RAS_SIZE - 1);
+    tcg_gen_st_i32(top, cpu_env, CPU_STATE_OFS(tb_ras.top));
+
+    e = tcg_temp_new_ptr();
+    tcg_gen_muli_i32(top, top, sizeof(TBReturnStackEntry));
+    tcg_gen_ext_i32_ptr(e, top);
+    tcg_gen_add_ptr(e, e, cpu_env);
+    tcg_temp_free_i32(top);
+
+    tcg_gen_st_i64(tcg_constant_i64(ret_addr), e,
+                   ofs + offsetof(TBReturnStackEntry, pc));
+    ptr = tcg_const_ptr(tb);
+    tcg_gen_st_ptr(ptr, e, ofs + offsetof(TBReturnStackEntry, site));
+    tcg_temp_free_ptr(ptr);
+    tcg_gen_st_i32(tcg_constant_i32(cell), e,
+                   ofs + offsetof(TBReturnStackEntry, cell));
+
+    /* whatever the cell holds, it is only used if its site is tb */
+    ptr = tcg_temp_new_ptr();
+    tcg_gen_ld_ptr(ptr, cpu_env, cofs + offsetof(TBReturnCont, site));
+    tcg_gen_st_ptr(ptr, e, ofs + offsetof(TBReturnStackEntry, cont_site));
+    tcg_gen_ld_ptr(ptr, cpu_env, cofs + offsetof(TBReturnCont, tc_ptr));
+    tcg_gen_st_ptr(ptr, e, ofs + offsetof(TBReturnStackEntry, tc_ptr));
+    tcg_temp_free_ptr(ptr);
+
+    flags = tcg_temp_new_i32();
+    tcg_gen_ld_i32(flags, cpu_env, cofs + offsetof(TBReturnCont, flags));
+    tcg_gen_st_i32(flags, e, ofs + offsetof(TBReturnStackEntry, flags));
+    tcg_temp_free_i32(flags);
+
+    tcg_temp_free_ptr(e);
+}
+
+void tcg_gen_ras_return(const TranslationBlock *tb, TCGv dest,
+                        uint32_t flags)
+{
+    intptr_t ofs = CPU_STATE_OFS(tb_ras.entry);
+    TCGLabel *miss, *fill;
+    TCGv_i64 pc, t64;
+    TCGv_i32 top, t32;
+    TCGv_ptr e, ptr, site;
+
+    if (!tcg_return_stack ||
+        (tcg_ctx->tb_cflags & (CF_NO_GOTO_TB | CF_NO_GOTO_PTR))) {
+        tcg_gen_lookup_and_goto_ptr_cached(tb, dest);
+        return;
+    }
+
+    plugin_gen_disable_mem_helpers();
+
+    pc = tcg_temp_local_new_i64();
+    tcg_gen_extu_tl_i64(pc, dest);
+
+    /* pop the entry at the top */
+    top = tcg_temp_new_i32();
+    t32 = tcg_temp_new_i32();
+    tcg_gen_ld_i32(top, cpu_env, CPU_STATE_OFS(tb_ras.top));
+    tcg_gen_subi_i32(t32, top, 1);
+    tcg_gen_andi_i32(t32, t32, TB_RAS_SIZE - 1);
+    tcg_gen_st_i32(t32, cpu_env, CPU_STATE_OFS(tb_ras.top));
+    tcg_temp_free_i32(t32);
+
+    e = tcg_temp_local_new_ptr();
+    tcg_gen_muli_i32(top, top, sizeof(TBReturnStackEntry));
+    tcg_gen_ext_i32_ptr(e, top);
+    tcg_gen_add_ptr(e, e, cpu_env);
+    tcg_temp_free_i32(top);
+
+    miss = gen_new_label();
+    fill = gen_new_label();
+
+    t64 = tcg_temp_new_i64();
+    tcg_gen_ld_i64(t64, e, ofs + offsetof(TBReturnStackEntry, pc));
+    tcg_gen_brcond_i64(TCG_COND_NE, t64, pc, miss);
+    tcg_temp_free_i64(t64);
+
+    /* predicted: is the code of the return address cached for us? */
+    ptr = tcg_temp_new_ptr();
+    site = tcg_temp_new_ptr();
+    tcg_gen_ld_ptr(site, e, ofs + offsetof(TBReturnStackEntry, site));
+    tcg_gen_ld_ptr(ptr, e, ofs + offsetof(TBReturnStackEntry, cont_site));
+    tcg_gen_brcond_ptr(TCG_COND_NE, ptr, site, fill);
+    tcg_temp_free_ptr(site);
+    tcg_temp_free_ptr(ptr);
+
+    t32 = tcg_temp_new_i32();
+    tcg_gen_ld_i32(t32, e, ofs + offsetof(TBReturnStackEntry, flags));
+    tcg_gen_brcondi_i32(TCG_COND_NE, t32, flags, fill);
+    tcg_temp_free_i32(t32);
+
+    ptr = tcg_temp_new_ptr();
+    tcg_gen_ld_ptr(ptr, e, ofs + offsetof(TBReturnStackEntry, tc_ptr));
+    tcg_gen_op1i(INDEX_op_goto_ptr, tcgv_ptr_arg(ptr));
+    tcg_temp_free_ptr(ptr);
+
+    /* predicted, but not cached: look it up and cache it in the cell */
+    gen_set_label(fill);
+    ptr = tcg_temp_new_ptr();
+    site = tcg_temp_new_ptr();
+    t32 = tcg_temp_new_i32();
+    tcg_gen_ld_ptr(site, e, ofs + offsetof(TBReturnStackEntry, site));
+    tcg_gen_ld_i32(t32, e, ofs + offsetof(TBReturnStackEntry, cell));
+    gen_helper_lookup_tb_ptr_ret(ptr, cpu_env, site, t32);
+    tcg_gen_op1i(INDEX_op_goto_ptr, tcgv_ptr_arg(ptr));
+    tcg_temp_free_i32(t32);
+    tcg_temp_free_ptr(site);
+    tcg_temp_free_ptr(ptr);
+
+    /* mispredicted, treat as any other indirect branch */
+    gen_set_label(miss);
+    gen_ibtc_lookup(tb, pc);
+
+    tcg_temp_free_ptr(e);
+    tcg_temp_free_i64(pc);
+}
+
 static inline MemOp tcg_canonicalize_memop(MemOp op, bool is64, bool st)
 {
     /* Trigger the asserts within as early as possible.  */
@@ -69,6 +69,7 @@
    used here. */
 static void tcg_target_init(TCGContext *s);
 static void tcg_target_qemu_prologue(TCGContext *s);
+static void tcg_target_host_features(char *buf, size_t len);
 static bool patch_reloc(tcg_insn_unit *code_ptr, int type,
                         intptr_t value, intptr_t addend);
 
@@ -562,6 +563,15 @@ static ffi_type * const typecode_to_ffi[8] = {
 };
 #endif
 
+/*
+ * Return the helper info registered for @func. Plugin instrumentation
+ * uses this to give a copied call op the call flags of another helper.
+ */
+const struct TCGHelperInfo *tcg_helper_info_lookup(void *func)
+{
+    return g_hash_table_lookup(helper_table, func);
+}
+
 static int indirect_reg_alloc_order[ARRAY_SIZE(tcg_target_reg_alloc_order)];
 static void process_op_defs(TCGContext *s);
 static TCGTemp *tcg_global_reg_new_internal(TCGContext *s, TCGType type,
@@ -718,6 +728,15 @@ TranslationBlock *tcg_tb_alloc(TCGContext *s)
     return tb;
 }
 
+/*
+ * Describe the optional host instructions the backend detected at
+ * startup. Code generated with one set of them may not run with another.
+ */
+void tcg_host_features(char *buf, size_t len)
+{
+    tcg_target_host_features(buf, len);
+}
+
 void tcg_prologue_init(TCGContext *s)
 {
     size_t prologue_size;
@@ -937,6 +956,24 @@ TCGTemp *tcg_global_mem_new_internal(TCGType type, TCGv_ptr base,
     return ts;
 }
 
+void tcg_global_set_flag(TCGTemp *ts)
+{
+    TCGContext *s = tcg_ctx;
+    int i, n = ts->base_type != ts->type ? 2 : 1;
+
+    QEMU_BUILD_BUG_ON(TCG_MAX_FLAGS >
+                      sizeof_field(TCGLabel, dead_flags) * BITS_PER_BYTE);
+    tcg_debug_assert(ts->kind == TEMP_GLOBAL && !ts->indirect_reg);
+
+    /* Once the table is full, further flags are left as plain globals */
+    if (s->nb_flags + n > TCG_MAX_FLAGS) {
+        return;
+    }
+    for (i = 0; i < n; i++) {
+        s->flags[s->nb_flags++] = temp_idx(ts + i);
+    }
+}
+
 TCGTemp *tcg_temp_new_internal(TCGType type, bool temp_local)
 {
     TCGContext *s = tcg_ctx;
@@ -2462,6 +2499,73 @@ static void la_cross_call(TCGContext *s, int nt)
     }
 }
 
+/* liveness analysis: flags that are overwritten before being read.  */
+static unsigned la_dead_flags(TCGContext *s)
+{
+    unsigned dead = 0;
+    int i;
+
+    for (i = 0; i < s->nb_flags; i++) {
+        if (s->temps[s->flags[i]].state == TS_DEAD) {
+            dead |= 1u << i;
+        }
+    }
+    return dead;
+}
+
+/* liveness analysis: flags dead after a branch need not be synced.  */
+static void la_kill_flags(TCGContext *s, unsigned dead)
+{
+    int i;
+
+    for (i = 0; i < s->nb_flags; i++) {
+        if (dead & (1u << i)) {
+            TCGTemp *ts = &s->temps[s->flags[i]];
+
+            ts->state = TS_DEAD;
+            la_reset_pref(ts);
+        }
+    }
+}
+
+/* Whether the syncs of global @ts can be skipped by chained jumps.  */
+static bool chain_global(TCGTemp *ts)
+{
+    return ts->kind == TEMP_GLOBAL && !ts->indirect_reg && !ts->indirect_base
+           && (ts->type == TCG_TYPE_I32 || ts->type == TCG_TYPE_I64);
+}
+
+/* liveness analysis: globals that are overwritten before being read.  */
+static uint64_t la_chain_dead_in(TCGContext *s)
+{
+    uint64_t dead = 0;
+    int i;
+
+    for (i = 0; i < MIN(s->nb_globals, 64); i++) {
+        TCGTemp *ts = &s->temps[i];
+
+        if (ts->state == TS_DEAD && chain_global(ts)) {
+            dead |= 1ull << i;
+        }
+    }
+    return dead;
+}
+
+/* liveness analysis: globals left live in registers by a goto_tb.  */
+static void la_chain_nosync(TCGContext *s, uint64_t nosync)
+{
+    int i;
+
+    for (i = 0; i < MIN(s->nb_globals, 64); i++) {
+        if (nosync & (1ull << i)) {
+            TCGTemp *ts = &s->temps[i];
+
+            ts->state = 0;
+            *la_temp_pref(ts) = tcg_target_available_regs[ts->type];
+        }
+    }
+}
+
 /* Liveness analysis : update the opc_arg_life array to tell if a
    given input arguments is dead. Instructions updating dead
    temporaries are removed. */
@@ -2480,6 +2584,16 @@ static void liveness_pass_1(TCGContext *s)
 
     /* ??? Should be redundant with the exit_tb that ends the TB.  */
     la_func_end(s, nb_globals, nb_temps);
+    s->chain_dead_in = 0;
+
+    /* Until its label is reached, assume that a branch needs all flags */
+    if (s->nb_flags) {
+        TCGLabel *l;
+
+        QSIMPLEQ_FOREACH(l, &s->labels, next) {
+            l->dead_flags = 0;
+        }
+    }
 
     QTAILQ_FOREACH_REVERSE_SAFE(op, &s->ops, link, op_prev) {
         int nb_iargs, nb_oargs;
@@ -2490,6 +2604,12 @@ static void liveness_pass_1(TCGContext *s)
         TCGOpcode opc = op->opc;
         const TCGOpDef *def = &tcg_op_defs[opc];
 
+        /* What follows the label is what a chained jump runs first.  */
+        if (opc == INDEX_op_set_label &&
+            arg_label(op->args[0]) == s->chain_label) {
+            s->chain_dead_in = la_chain_dead_in(s);
+        }
+
         switch (opc) {
         case INDEX_op_call:
             {
@@ -2577,6 +2697,16 @@ static void liveness_pass_1(TCGContext *s)
             break;
         case INDEX_op_insn_start:
             break;
+        case INDEX_op_set_label:
+            /* Branches here leave the flags overwritten after it unsynced */
+            {
+                TCGLabel *l = arg_label(op->args[0]);
+
+                l->dead_flags = la_dead_flags(s);
+                la_bb_end(s, nb_globals, nb_temps);
+                la_kill_flags(s, l->dead_flags);
+            }
+            break;
         case INDEX_op_discard:
             /* mark the temporary as dead */
             ts = arg_temp(op->args[0]);
@@ -2705,10 +2835,21 @@ static void liveness_pass_1(TCGContext *s)
             /* If end of basic block, update.  */
             if (def->flags & TCG_OPF_BB_EXIT) {
                 la_func_end(s, nb_globals, nb_temps);
+                if (opc == INDEX_op_goto_tb) {
+                    la_chain_nosync(s, s->goto_tb_nosync[op->args[0]]);
+                }
             } else if (def->flags & TCG_OPF_COND_BRANCH) {
+                TCGLabel *l = arg_label(op->args[nb_oargs + nb_iargs +
+                                                 def->nb_cargs - 1]);
+                unsigned dead = la_dead_flags(s) & l->dead_flags;
+
                 la_bb_sync(s, nb_globals, nb_temps);
+                la_kill_flags(s, dead);
             } else if (def->flags & TCG_OPF_BB_END) {
                 la_bb_end(s, nb_globals, nb_temps);
+                if (opc == INDEX_op_br) {
+                    la_kill_flags(s, arg_label(op->args[0])->dead_flags);
+                }
             } else if (def->flags & TCG_OPF_SIDE_EFFECTS) {
                 la_global_sync(s, nb_globals);
                 if (def->flags & TCG_OPF_CALL_CLOBBER) {
@@ -2965,6 +3106,54 @@ static bool liveness_pass_2(TCGContext *s)
     return changes;
 }
 
+/*
+ * With tcg_chain_liveness, a goto_tb to a TB that overwrites some globals
+ * before reading them need not sync them: the TB it leads to never sees
+ * their values. Their stores are moved past the goto_tb, to the exit
+ * taken while the jump is not linked. Returns true if stores were moved.
+ */
+static bool chain_liveness_pass(TCGContext *s)
+{
+    bool changes = false;
+    TCGOp *op;
+    int i;
+
+    QTAILQ_FOREACH(op, &s->ops, link) {
+        uint64_t nosync;
+        int n;
+
+        if (op->opc != INDEX_op_goto_tb) {
+            continue;
+        }
+        n = op->args[0];
+        nosync = s->goto_tb_carry[n];
+        if (nosync == UINT64_MAX) {
+            /* A jump back to this TB */
+            nosync = s->chain_dead_in;
+        }
+        s->goto_tb_nosync[n] = nosync;
+
+        for (i = 0; i < MIN(s->nb_globals, 64); i++) {
+            TCGTemp *ts = &s->temps[i];
+            TCGOp *sop;
+
+            if (!(nosync & (1ull << i))) {
+                continue;
+            }
+            tcg_debug_assert(chain_global(ts));
+            sop = tcg_op_insert_after(s, op, ts->type == TCG_TYPE_I32
+                                             ? INDEX_op_st_i32
+                                             : INDEX_op_st_i64);
+            sop->args[0] = temp_arg(ts);
+            sop->args[1] = temp_arg(ts->mem_base);
+            sop->args[2] = ts->mem_offset;
+            changes = true;
+        }
+    }
+
+    return changes;
+}
+
 #ifdef CONFIG_DEBUG_TCG
 static void dump_regs(TCGContext *s)
 {
@@ -3734,7 +3923,13 @@ static void tcg_reg_alloc_op(TCGContext *s, const TCGOp *op)
     if (def->flags & TCG_OPF_COND_BRANCH) {
         tcg_reg_alloc_cbranch(s, i_allocated_regs);
     } else if (def->flags & TCG_OPF_BB_END) {
-        tcg_reg_alloc_bb_end(s, i_allocated_regs);
+        /*
+         * A goto_tb that does not sync some globals leaves them in their
+         * registers, for the stores that follow it.
+         */
+        if (op->opc != INDEX_op_goto_tb || !s->goto_tb_nosync[op->args[0]]) {
+            tcg_reg_alloc_bb_end(s, i_allocated_regs);
+        }
     } else {
         if (def->flags & TCG_OPF_CALL_CLOBBER) {
             /* XXX: permit generic clobber register list ? */ 
@@ -4232,6 +4427,7 @@ int tcg_gen_code(TCGContext *s, TranslationBlock *tb)
 #endif
 
     reachable_code_pass(s);
+    s->goto_tb_nosync[0] = s->goto_tb_nosync[1] = 0;
     liveness_pass_1(s);
 
     if (s->nb_indirects > 0) {
@@ -4252,6 +4448,11 @@ int tcg_gen_code(TCGContext *s, TranslationBlock *tb)
         }
     }
 
+    if ((s->goto_tb_carry[0] || s->goto_tb_carry[1]) &&
+        chain_liveness_pass(s)) {
+        liveness_pass_1(s);
+    }
+
 #ifdef CONFIG_PROFILER
     qatomic_set(&prof->la_time, prof->la_time + profile_getclock());
 #endif
@@ -4284,6 +4485,11 @@ int tcg_gen_code(TCGContext *s, TranslationBlock *tb)
     s->pool_labels = NULL;
 #endif
 
+    tb->chain_offset = 0;
+    tb->dead_in = s->chain_dead_in;
+    tb->jmp_nosync[0] = s->goto_tb_nosync[0];
+    tb->jmp_nosync[1] = s->goto_tb_nosync[1];
+
     num_insns = -1;
     QTAILQ_FOREACH(op, &s->ops, link) {
         TCGOpcode opc = op->opc;
@@ -4325,6 +4531,9 @@ int tcg_gen_code(TCGContext *s, TranslationBlock *tb)
         case INDEX_op_set_label:
             tcg_reg_alloc_bb_end(s, s->reserved_regs);
             tcg_out_label(s, arg_label(op->args[0]));
+            if (arg_label(op->args[0]) == s->chain_label) {
+                tb->chain_offset = tcg_current_code_size(s);
+            }
             break;
         case INDEX_op_call:
             tcg_reg_alloc_call(s, op);
@@ -20,6 +20,10 @@ static uint64_t insn_count;
 static bool do_inline;
 static bool do_size;
 static GArray *sizes;
+static uint64_t sample_period;
+static struct qemu_plugin_scoreboard *sample_score;
+static qemu_plugin_u64 sample_count;
+static uint64_t samples;
 
 static void vcpu_insn_exec_before(unsigned int cpu_index, void *udata)
 {
@@ -34,6 +38,13 @@ static void vcpu_insn_exec_before(unsigned int cpu_index, void *udata)
     insn_count++;
 }
 
+/* only called once a vCPU has executed sample_period insns */
+static void vcpu_insn_sample(unsigned int cpu_index, void *udata)
+{
+    qemu_plugin_u64_set(sample_count, cpu_index, 0);
+    __atomic_fetch_add(&samples, 1, __ATOMIC_RELAXED);
+}
+
 static void vcpu_tb_trans(qemu_plugin_id_t id, struct qemu_plugin_tb *tb)
 {
     size_t n = qemu_plugin_tb_n_insns(tb);
@@ -52,6 +63,14 @@ static void vcpu_tb_trans(qemu_plugin_id_t id, struct qemu_plugin_tb *tb)
                 GUINT_TO_POINTER(vaddr));
         }
 
+        if (sample_period) {
+            qemu_plugin_register_vcpu_insn_exec_inline_per_vcpu(
+                insn, QEMU_PLUGIN_INLINE_ADD_U64, sample_count, 1);
+            qemu_plugin_register_vcpu_insn_exec_cond_cb(
+                insn, vcpu_insn_sample, QEMU_PLUGIN_CB_NO_REGS,
+                QEMU_PLUGIN_COND_GE, sample_count, sample_period, NULL);
+        }
+
         if (do_size) {
             size_t sz = qemu_plugin_insn_size(insn);
             if (sz > sizes->len) {
@@ -79,6 +98,9 @@ static void plugin_exit(qemu_plugin_id_t id, void *p)
     } else {
         g_string_append_printf(out, "insns: %" PRIu64 "\n", insn_count);
     }
+    if (sample_period) {
+        g_string_append_printf(out, "samples: %" PRIu64 "\n", samples);
+    }
     qemu_plugin_outs(out->str);
 }
 
@@ -99,6 +121,8 @@ QEMU_PLUGIN_EXPORT int qemu_plugin_install(qemu_plugin_id_t id,
                 fprintf(stderr, "boolean argument parsing failed: %s\n", opt);
                 return -1;
             }
+        } else if (g_strcmp0(tokens[0], "sample") == 0) {
+            sample_period = g_ascii_strtoull(tokens[1], NULL, 10);
         } else {
             fprintf(stderr, "option parsing failed: %s\n", opt);
             return -1;
@@ -109,6 +133,11 @@ QEMU_PLUGIN_EXPORT int qemu_plugin_install(qemu_plugin_id_t id,
         sizes = g_array_new(true, true, sizeof(unsigned long));
     }
 
+    if (sample_period) {
+        sample_score = qemu_plugin_scoreboard_new(sizeof(uint64_t));
+        sample_count = qemu_plugin_scoreboard_u64(sample_score);
+    }
+
     qemu_plugin_register_vcpu_tb_trans_cb(id, vcpu_tb_trans);
     qemu_plugin_register_atexit_cb(id, plugin_exit, NULL);
     return 0;
@@ -773,3 +773,12 @@ void aio_context_set_aio_params(AioContext *ctx, int64_t max_batch,
 
     aio_notify(ctx);
 }
+
+void aio_context_set_io_uring_params(AioContext *ctx, bool sqpoll,
+                                     bool fixed_files, bool fixed_buffers,
+                                     Error **errp)
+{
+    ctx->io_uring_sqpoll = sqpoll;
+    ctx->io_uring_fixed_files = fixed_files;
+    ctx->io_uring_fixed_buffers = fixed_buffers;
+}
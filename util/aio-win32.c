@@ -447,3 +447,12 @@ void aio_context_set_aio_params(AioContext *ctx, int64_t max_batch,
                                 Error **errp)
 {
 }
+
+void aio_context_set_io_uring_params(AioContext *ctx, bool sqpoll,
+                                     bool fixed_files, bool fixed_buffers,
+                                     Error **errp)
+{
+    if (sqpoll || fixed_files || fixed_buffers) {
+        error_setg(errp, "io_uring is not implemented on Windows");
+    }
+}
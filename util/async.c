@@ -335,6 +335,11 @@ aio_ctx_finalize(GSource     *source)
         luring_cleanup(ctx->linux_io_uring);
         ctx->linux_io_uring = NULL;
     }
+    if (ctx->linux_io_uring_poll) {
+        luring_detach_aio_context(ctx->linux_io_uring_poll, ctx);
+        luring_cleanup(ctx->linux_io_uring_poll);
+        ctx->linux_io_uring_poll = NULL;
+    }
 #endif
 
     assert(QSLIST_EMPTY(&ctx->scheduled_coroutines));
@@ -412,13 +417,20 @@ LinuxAioState *aio_get_linux_aio(AioContext *ctx)
 #endif
 
 #ifdef CONFIG_LINUX_IO_URING
+static unsigned int aio_io_uring_flags(AioContext *ctx)
+{
+    return (ctx->io_uring_sqpoll ? LURING_SQPOLL : 0) |
+           (ctx->io_uring_fixed_files ? LURING_FIXED_FILES : 0) |
+           (ctx->io_uring_fixed_buffers ? LURING_FIXED_BUFFERS : 0);
+}
+
 LuringState *aio_setup_linux_io_uring(AioContext *ctx, Error **errp)
 {
     if (ctx->linux_io_uring) {
         return ctx->linux_io_uring;
     }
 
-    ctx->linux_io_uring = luring_init(errp);
+    ctx->linux_io_uring = luring_init(aio_io_uring_flags(ctx), errp);
     if (!ctx->linux_io_uring) {
         return NULL;
     }
@@ -432,6 +444,28 @@ LuringState *aio_get_linux_io_uring(AioContext *ctx)
     assert(ctx->linux_io_uring);
     return ctx->linux_io_uring;
 }
+
+LuringState *aio_setup_linux_io_uring_poll(AioContext *ctx, Error **errp)
+{
+    if (ctx->linux_io_uring_poll) {
+        return ctx->linux_io_uring_poll;
+    }
+
+    ctx->linux_io_uring_poll = luring_init(aio_io_uring_flags(ctx) |
+                                           LURING_IOPOLL, errp);
+    if (!ctx->linux_io_uring_poll) {
+        return NULL;
+    }
+
+    luring_attach_aio_context(ctx->linux_io_uring_poll, ctx);
+    return ctx->linux_io_uring_poll;
+}
+
+LuringState *aio_get_linux_io_uring_poll(AioContext *ctx)
+{
+    assert(ctx->linux_io_uring_poll);
+    return ctx->linux_io_uring_poll;
+}
 #endif
 
 void aio_notify(AioContext *ctx)
@@ -549,6 +583,7 @@ AioContext *aio_context_new(Error **errp)
 
 #ifdef CONFIG_LINUX_IO_URING
     ctx->linux_io_uring = NULL;
+    ctx->linux_io_uring_poll = NULL;
 #endif
 
     ctx->thread_pool = NULL;
@@ -562,6 +597,10 @@ AioContext *aio_context_new(Error **errp)
 
     ctx->aio_max_batch = 0;
 
+    ctx->io_uring_sqpoll = false;
+    ctx->io_uring_fixed_files = false;
+    ctx->io_uring_fixed_buffers = false;
+
     return ctx;
 fail:
     g_source_destroy(&ctx->source);